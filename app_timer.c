@@ -0,0 +1,231 @@
+/******************************************************************************
+* File Name: app_timer.c
+*
+* Description: This file contains the SysTick based millisecond time base used to
+*              timestamp VBUS fault events.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "app_timer.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Milliseconds elapsed since app_timer_init() */
+static volatile uint32_t app_timer_ms = 0;
+
+/* SysTick reload value, one less than the CPU cycles per tick */
+static uint32_t app_timer_reload = 0;
+
+/* CPU clock cycles per microsecond */
+static uint32_t app_timer_cycles_per_us = 1;
+
+/*******************************************************************************
+* Function Name: app_timer_systick_cb
+********************************************************************************
+* Summary:
+*  SysTick callback, advances the millisecond counter.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void app_timer_systick_cb(void)
+{
+    app_timer_ms += APP_TIMER_TICK_MS;
+}
+
+/*******************************************************************************
+* Function Name: app_timer_init
+********************************************************************************
+* Summary:
+*  Configures SysTick to interrupt every APP_TIMER_TICK_MS using the CPU clock.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_timer_init(void)
+{
+    uint32_t interval = (Cy_SysClk_ClkSysGetFrequency() / 1000u) * APP_TIMER_TICK_MS;
+
+    app_timer_reload = interval - 1u;
+    app_timer_cycles_per_us = Cy_SysClk_ClkSysGetFrequency() / 1000000u;
+    if (app_timer_cycles_per_us == 0u)
+    {
+        app_timer_cycles_per_us = 1u;
+    }
+
+    Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, app_timer_reload);
+    (void)Cy_SysTick_SetCallback(0u, app_timer_systick_cb);
+}
+
+/*******************************************************************************
+* Function Name: app_timer_get_ms
+********************************************************************************
+* Summary:
+*  Returns the number of milliseconds elapsed since app_timer_init().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t app_timer_get_ms(void)
+{
+    return app_timer_ms;
+}
+
+/*******************************************************************************
+* Function Name: app_timer_add_ms
+********************************************************************************
+* Summary:
+*  Advances the millisecond counter by a time SysTick did not count, such as
+*  a deep sleep period. Must be called with interrupts disabled.
+*
+* Parameters:
+*  ms - milliseconds to add
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_timer_add_ms(uint32_t ms)
+{
+    app_timer_ms += ms;
+}
+
+/*******************************************************************************
+* Function Name: app_timer_get_us
+********************************************************************************
+* Summary:
+*  Returns the number of microseconds elapsed since app_timer_init(). The
+*  millisecond count is read again after the SysTick value so that a tick
+*  taken in between is not missed; requires interrupts to be enabled.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t app_timer_get_us(void)
+{
+    uint32_t ms;
+    uint32_t value;
+
+    do
+    {
+        ms = app_timer_ms;
+        value = Cy_SysTick_GetValue();
+    } while (ms != app_timer_ms);
+
+    return ((ms * 1000u) + app_timer_cycles_to_us(app_timer_reload - value));
+}
+
+/*******************************************************************************
+* Function Name: app_timer_stamp
+********************************************************************************
+* Summary:
+*  Returns a raw SysTick snapshot for short interval measurements with
+*  app_timer_elapsed(). Safe to call from interrupt context.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t app_timer_stamp(void)
+{
+    return Cy_SysTick_GetValue();
+}
+
+/*******************************************************************************
+* Function Name: app_timer_elapsed
+********************************************************************************
+* Summary:
+*  Returns the CPU cycles elapsed since a stamp taken with app_timer_stamp().
+*  SysTick counts down and wraps once per tick, so the result is only valid
+*  for intervals shorter than APP_TIMER_TICK_MS.
+*
+* Parameters:
+*  stamp - value returned by app_timer_stamp()
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t app_timer_elapsed(uint32_t stamp)
+{
+    uint32_t now = Cy_SysTick_GetValue();
+
+    if (stamp >= now)
+    {
+        return (stamp - now);
+    }
+    return (stamp + (app_timer_reload + 1u) - now);
+}
+
+/*******************************************************************************
+* Function Name: app_timer_cycles_to_us
+********************************************************************************
+* Summary:
+*  Converts CPU cycles into microseconds. Not intended for interrupt context.
+*
+* Parameters:
+*  cycles - number of CPU cycles
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t app_timer_cycles_to_us(uint32_t cycles)
+{
+    return (cycles / app_timer_cycles_per_us);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,240 @@
+/******************************************************************************
+* File Name: fault_event.c
+*
+* Description: This file contains the single-producer/single-consumer ring used to pass
+*              VBUS fault events from the USBPD interrupt to the main loop.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "fault_event.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Event ring of a port. Each port has its own ring so that a fault storm on
+ * one port cannot push out the events of another.
+ */
+typedef struct
+{
+    fault_event_t ring[FAULT_EVENT_RING_SIZE];
+    volatile uint8_t head;          /* Free running write index, only written by the producer (ISR) */
+    volatile uint8_t tail;          /* Free running read index, only written by the consumer (main loop) */
+} fault_event_queue_t;
+
+/* Event storage */
+static fault_event_queue_t fault_event_queue[UVOV_PORT_COUNT];
+
+/* Port the next fault_event_pop() call starts with */
+static uint8_t fault_event_next_port = 0;
+
+/* Event statistics, only written by the producer */
+static fault_event_stats_t fault_event_stats;
+
+/*******************************************************************************
+* Function Name: fault_event_push
+********************************************************************************
+* Summary:
+*  Adds an event to the ring of its port. Called from the UVP/OVP callbacks in
+*  interrupt context, or from the main loop inside a critical section so that
+*  there is never more than one producer at a time. Runs in constant time
+*  without a critical section of its own; the event is dropped and counted
+*  when the ring is full.
+*
+* Parameters:
+*  evt - event to be copied into the ring
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fault_event_push(const fault_event_t *evt)
+{
+    fault_event_queue_t *queue;
+    uint8_t head;
+
+    if (evt->type < FAULT_TYPE_COUNT)
+    {
+        fault_event_stats.count[evt->type]++;
+    }
+
+    if (evt->port >= UVOV_PORT_COUNT)
+    {
+        fault_event_stats.dropped++;
+        return;
+    }
+
+    queue = &fault_event_queue[evt->port];
+    head = queue->head;
+    if ((uint8_t)(head - queue->tail) >= FAULT_EVENT_RING_SIZE)
+    {
+        fault_event_stats.dropped++;
+        fault_event_stats.port_dropped[evt->port]++;
+        return;
+    }
+
+    queue->ring[head & (FAULT_EVENT_RING_SIZE - 1u)] = *evt;
+
+    /* Make the record visible before publishing the new head */
+    __DMB();
+    queue->head = (uint8_t)(head + 1u);
+}
+
+/*******************************************************************************
+* Function Name: fault_event_pending
+********************************************************************************
+* Summary:
+*  Returns whether the ring of any port holds events that have not been
+*  popped yet.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool fault_event_pending(void)
+{
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        if (fault_event_port_pending(port))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: fault_event_port_pending
+********************************************************************************
+* Summary:
+*  Returns whether the ring of a port holds events that have not been popped
+*  yet.
+*
+* Parameters:
+*  port - USBPD port
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool fault_event_port_pending(uint8_t port)
+{
+    return (fault_event_queue[port].head != fault_event_queue[port].tail);
+}
+
+/*******************************************************************************
+* Function Name: fault_event_pop
+********************************************************************************
+* Summary:
+*  Copies up to max events out of the rings. The ports are served in turn,
+*  one event at a time, so a port in a fault storm cannot hold back the
+*  events of another; the events of a port keep their arrival order. Only
+*  called from the main loop.
+*
+* Parameters:
+*  evt - buffer receiving the events
+*  max - capacity of evt
+*
+* Return:
+*  uint8_t - number of events copied
+*
+*******************************************************************************/
+uint8_t fault_event_pop(fault_event_t *evt, uint8_t max)
+{
+    fault_event_queue_t *queue;
+    uint8_t avail[UVOV_PORT_COUNT];
+    uint8_t taken[UVOV_PORT_COUNT];
+    uint8_t total = 0;
+    uint8_t count = 0;
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        queue = &fault_event_queue[port];
+        avail[port] = (uint8_t)(queue->head - queue->tail);
+        taken[port] = 0;
+        total += avail[port];
+    }
+
+    /* Read the records only after the heads have been sampled */
+    __DMB();
+
+    port = fault_event_next_port;
+    while ((count < max) && (count < total))
+    {
+        if (taken[port] < avail[port])
+        {
+            queue = &fault_event_queue[port];
+            evt[count] = queue->ring[(uint8_t)(queue->tail + taken[port]) & (FAULT_EVENT_RING_SIZE - 1u)];
+            taken[port]++;
+            count++;
+        }
+        port = (uint8_t)((port + 1u) % UVOV_PORT_COUNT);
+    }
+    fault_event_next_port = port;
+
+    __DMB();
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        fault_event_queue[port].tail = (uint8_t)(fault_event_queue[port].tail + taken[port]);
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: fault_event_get_stats
+********************************************************************************
+* Summary:
+*  Returns the fault event statistics.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  const fault_event_stats_t *
+*
+*******************************************************************************/
+const fault_event_stats_t *fault_event_get_stats(void)
+{
+    return &fault_event_stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+* File Name: fault_event.h
+*
+* Description: This is the header file for the VBUS fault event ring of the PMG1 MCU
+*              Using UVOV Blocks Code Example. The UVP/OVP callbacks push fixed-size
+*              records from interrupt context and the main loop drains them in batches.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _FAULT_EVENT_H_
+#define _FAULT_EVENT_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "uvov_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of entries in the fault event ring of each port, must be a power of two */
+#define FAULT_EVENT_RING_SIZE       (16u)
+
+/* Maximum number of events processed by one fault_event_pop() call */
+#define FAULT_EVENT_BATCH           (4u)
+
+/* Threshold code recorded when the device does not expose a ladder code */
+#define FAULT_EVENT_CODE_NONE       (0xFFu)
+
+/* Largest FET turn-off time recorded in fault_event_t.fet_off_cycles */
+#define FAULT_EVENT_FET_OFF_MAX     (0xFFFFu)
+
+/* Event flags */
+#define FAULT_EVENT_FLAG_PREDICTED  (0x01u)     /* Raised by the dV/dt predictor, not the comparator */
+
+/* Types of VBUS fault events */
+typedef enum
+{
+    FAULT_TYPE_OVP = 0,
+    FAULT_TYPE_UVP = 1,
+    FAULT_TYPE_COUNT
+} fault_type_t;
+
+/* Fault event record, written by the ISR and read by the main loop */
+typedef struct
+{
+    uint32_t timestamp;             /* Time of the event in ms */
+    uint16_t volt;                  /* Voltage in mV used to arm the comparator */
+    uint16_t vbus;                  /* Filtered VBUS in mV measured by the ADC, 0 if unknown */
+    uint8_t  type;                  /* Fault type, see fault_type_t */
+    uint8_t  comp_out;              /* Comparator output reported by the driver */
+    uint8_t  code;                  /* Comparator threshold code in force */
+    uint8_t  flags;                 /* FAULT_EVENT_FLAG_xxx */
+    uint8_t  port;                  /* USBPD port raising the event */
+    uint8_t  reserved;
+    uint16_t fet_off_cycles;        /* Interrupt entry to software FET turn-off in CPU cycles, 0 if not by software */
+} fault_event_t;
+
+/* Fault event statistics */
+typedef struct
+{
+    uint32_t count[FAULT_TYPE_COUNT];   /* Events pushed per fault type */
+    uint32_t dropped;                   /* Events lost because a ring was full */
+    uint32_t port_dropped[UVOV_PORT_COUNT]; /* Events lost per port */
+} fault_event_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void fault_event_push(const fault_event_t *evt);
+
+bool fault_event_pending(void);
+
+bool fault_event_port_pending(uint8_t port);
+
+uint8_t fault_event_pop(fault_event_t *evt, uint8_t max);
+
+const fault_event_stats_t *fault_event_get_stats(void);
+
+#endif /* _FAULT_EVENT_H_ */
+
+/* End of file [] */
@@ -0,0 +1,144 @@
+/******************************************************************************
+* File Name: fault_fsm.c
+*
+* Description: This file contains the transition table and the step function of the
+*              per-channel fault state machine.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "fault_fsm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Transition table entry */
+typedef struct
+{
+    uint8_t next;                   /* Next state, see fault_fsm_state_t */
+    uint8_t action;                 /* Action to run, see fault_fsm_action_t */
+} fault_fsm_transition_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Transition table indexed by [state][event] */
+static const fault_fsm_transition_t fault_fsm_table[FAULT_FSM_STATE_COUNT][FAULT_FSM_EVT_COUNT] =
+{
+    [FAULT_FSM_NORMAL] =
+    {
+        [FAULT_FSM_EVT_TRIP]  = { FAULT_FSM_FAULTED_HYST, FAULT_FSM_ACT_ARM_HYST },
+        [FAULT_FSM_EVT_FAULT] = { FAULT_FSM_NORMAL,       FAULT_FSM_ACT_NONE     },
+        [FAULT_FSM_EVT_CLEAR] = { FAULT_FSM_NORMAL,       FAULT_FSM_ACT_NONE     },
+    },
+    [FAULT_FSM_FAULTED_HYST] =
+    {
+        [FAULT_FSM_EVT_TRIP]  = { FAULT_FSM_FAULTED_HYST, FAULT_FSM_ACT_NONE     },
+        [FAULT_FSM_EVT_FAULT] = { FAULT_FSM_FAULTED_HYST, FAULT_FSM_ACT_NONE     },
+        [FAULT_FSM_EVT_CLEAR] = { FAULT_FSM_RECOVERING,   FAULT_FSM_ACT_ARM_TRIP },
+    },
+    [FAULT_FSM_RECOVERING] =
+    {
+        [FAULT_FSM_EVT_TRIP]  = { FAULT_FSM_FAULTED_HYST, FAULT_FSM_ACT_ARM_HYST },
+        [FAULT_FSM_EVT_FAULT] = { FAULT_FSM_FAULTED_HYST, FAULT_FSM_ACT_ARM_HYST },
+        [FAULT_FSM_EVT_CLEAR] = { FAULT_FSM_NORMAL,       FAULT_FSM_ACT_NORMAL   },
+    },
+};
+
+/*******************************************************************************
+* Function Name: fault_fsm_init
+********************************************************************************
+* Summary:
+*  Initializes a fault channel in the NORMAL state.
+*
+* Parameters:
+*  fsm - fault channel instance
+*  port - USBPD port passed to the action handlers
+*  handlers - action handlers indexed by fault_fsm_action_t, the
+*             FAULT_FSM_ACT_NONE entry must be a valid no-op handler
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fault_fsm_init(fault_fsm_t *fsm, uint8_t port, const fault_fsm_handler_t *handlers)
+{
+    fsm->state = FAULT_FSM_NORMAL;
+    fsm->port = port;
+    fsm->handlers = handlers;
+}
+
+/*******************************************************************************
+* Function Name: fault_fsm_step
+********************************************************************************
+* Summary:
+*  Applies an event to a fault channel. Every transition is one table lookup
+*  and one handler call, so the cost does not depend on the state or event.
+*
+* Parameters:
+*  fsm - fault channel instance
+*  evt - event to apply
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fault_fsm_step(fault_fsm_t *fsm, fault_fsm_event_t evt)
+{
+    const fault_fsm_transition_t *tr = &fault_fsm_table[fsm->state][evt];
+
+    fsm->state = (fault_fsm_state_t)tr->next;
+    fsm->handlers[tr->action](fsm->port);
+}
+
+/*******************************************************************************
+* Function Name: fault_fsm_is_normal
+********************************************************************************
+* Summary:
+*  Returns whether a fault channel is in the NORMAL state.
+*
+* Parameters:
+*  fsm - fault channel instance
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool fault_fsm_is_normal(const fault_fsm_t *fsm)
+{
+    return (fsm->state == FAULT_FSM_NORMAL);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name: fault_fsm.h
+*
+* Description: This is the header file for the table driven fault state machine of the
+*              PMG1 MCU Using UVOV Blocks Code Example. One state machine instance is
+*              used per fault channel (OVP and UVP).
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _FAULT_FSM_H_
+#define _FAULT_FSM_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Fault channel states */
+typedef enum
+{
+    FAULT_FSM_NORMAL = 0,           /* Armed at the trip threshold, no fault */
+    FAULT_FSM_FAULTED_HYST,         /* Fault present, armed at the hysteresis threshold */
+    FAULT_FSM_RECOVERING,           /* Fault cleared, re-armed at the trip threshold */
+    FAULT_FSM_STATE_COUNT
+} fault_fsm_state_t;
+
+/* Fault channel events */
+typedef enum
+{
+    FAULT_FSM_EVT_TRIP = 0,         /* Comparator tripped at the trip threshold */
+    FAULT_FSM_EVT_FAULT,            /* Tick, VBUS still outside the limit */
+    FAULT_FSM_EVT_CLEAR,            /* Tick, VBUS within the limit */
+    FAULT_FSM_EVT_COUNT
+} fault_fsm_event_t;
+
+/* Actions run on a transition */
+typedef enum
+{
+    FAULT_FSM_ACT_NONE = 0,         /* No action */
+    FAULT_FSM_ACT_ARM_HYST,         /* Fault detected, arm the hysteresis threshold */
+    FAULT_FSM_ACT_ARM_TRIP,         /* Fault cleared, arm the trip threshold */
+    FAULT_FSM_ACT_NORMAL,           /* Recovery confirmed */
+    FAULT_FSM_ACT_COUNT
+} fault_fsm_action_t;
+
+/* Action handler, called with the port of the fault channel */
+typedef void (*fault_fsm_handler_t)(uint8_t port);
+
+/* Fault channel instance */
+typedef struct
+{
+    fault_fsm_state_t state;                                /* Current state */
+    uint8_t port;                                           /* USBPD port of the channel */
+    const fault_fsm_handler_t *handlers;                    /* Handlers indexed by fault_fsm_action_t */
+} fault_fsm_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void fault_fsm_init(fault_fsm_t *fsm, uint8_t port, const fault_fsm_handler_t *handlers);
+
+void fault_fsm_step(fault_fsm_t *fsm, fault_fsm_event_t evt);
+
+bool fault_fsm_is_normal(const fault_fsm_t *fsm);
+
+#endif /* _FAULT_FSM_H_ */
+
+/* End of file [] */
@@ -0,0 +1,165 @@
+/******************************************************************************
+* File Name: fault_storm.c
+*
+* Description: This file contains the per-channel fault storm detector. Trips are counted
+*              in a sliding window; during a storm the re-arm of the comparator is delayed
+*              with an exponential backoff and VBUS is polled instead.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "fault_storm.h"
+
+/*******************************************************************************
+* Function Name: fault_storm_trip
+********************************************************************************
+* Summary:
+*  Accounts a comparator trip. Enters a storm when FAULT_STORM_TRIPS trips
+*  fall within FAULT_STORM_WINDOW_MS; every trip during a storm raises the
+*  backoff level.
+*
+* Parameters:
+*  storm - channel storm detector
+*  now - current time in ms
+*
+* Return:
+*  fault_storm_change_t
+*
+*******************************************************************************/
+fault_storm_change_t fault_storm_trip(fault_storm_t *storm, uint32_t now)
+{
+    fault_storm_change_t change = FAULT_STORM_NONE;
+    uint32_t oldest;
+
+    storm->trip_time[storm->next] = now;
+    storm->next = (uint8_t)((storm->next + 1u) % FAULT_STORM_TRIPS);
+    if (storm->trips < FAULT_STORM_TRIPS)
+    {
+        storm->trips++;
+    }
+    storm->last_trip = now;
+
+    /* Oldest of the FAULT_STORM_TRIPS stored trips, this one included */
+    oldest = storm->trip_time[storm->next];
+
+    if (storm->level != 0u)
+    {
+        if (storm->level < FAULT_STORM_MAX_LEVEL)
+        {
+            storm->level++;
+        }
+    }
+    else if ((storm->trips == FAULT_STORM_TRIPS) && ((now - oldest) < FAULT_STORM_WINDOW_MS))
+    {
+        storm->level = 1u;
+        storm->entries++;
+        change = FAULT_STORM_ENTER;
+    }
+
+    if (storm->level != 0u)
+    {
+        storm->rearm_at = now + (FAULT_STORM_BACKOFF_MS << (storm->level - 1u));
+    }
+
+    return change;
+}
+
+/*******************************************************************************
+* Function Name: fault_storm_hold
+********************************************************************************
+* Summary:
+*  Returns whether the re-arm of the comparator must still be deferred.
+*
+* Parameters:
+*  storm - channel storm detector
+*  now - current time in ms
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool fault_storm_hold(const fault_storm_t *storm, uint32_t now)
+{
+    return ((storm->level != 0u) && ((int32_t)(now - storm->rearm_at) < 0));
+}
+
+/*******************************************************************************
+* Function Name: fault_storm_active
+********************************************************************************
+* Summary:
+*  Returns whether the channel is in a storm.
+*
+* Parameters:
+*  storm - channel storm detector
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool fault_storm_active(const fault_storm_t *storm)
+{
+    return (storm->level != 0u);
+}
+
+/*******************************************************************************
+* Function Name: fault_storm_update
+********************************************************************************
+* Summary:
+*  Leaves the storm once the comparator has been re-armed and no trip has
+*  followed for FAULT_STORM_WINDOW_MS.
+*
+* Parameters:
+*  storm - channel storm detector
+*  now - current time in ms
+*
+* Return:
+*  fault_storm_change_t
+*
+*******************************************************************************/
+fault_storm_change_t fault_storm_update(fault_storm_t *storm, uint32_t now)
+{
+    if ((storm->level != 0u) && ((int32_t)(now - storm->rearm_at) >= 0) &&
+        ((now - storm->last_trip) >= (uint32_t)((FAULT_STORM_BACKOFF_MS << (storm->level - 1u)) + FAULT_STORM_WINDOW_MS)))
+    {
+        storm->level = 0u;
+        storm->trips = 0u;
+        storm->next = 0u;
+        memset(storm->trip_time, 0, sizeof(storm->trip_time));
+        return FAULT_STORM_EXIT;
+    }
+    return FAULT_STORM_NONE;
+}
+
+/* [] END OF FILE */
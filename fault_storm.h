@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name: fault_storm.h
+*
+* Description: This is the header file for the fault storm rate limiter of the PMG1 MCU
+*              Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _FAULT_STORM_H_
+#define _FAULT_STORM_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A storm is detected when this many trips fall within FAULT_STORM_WINDOW_MS */
+#define FAULT_STORM_TRIPS           (8u)
+
+/* Length of the sliding trip window in ms. The trip times come from the
+ * application timer, which includes the deep sleep time in LOW_POWER_MODE.
+ */
+#define FAULT_STORM_WINDOW_MS       (100u)
+
+/* Re-arm delay in ms of the first backoff level, doubled at every further trip */
+#define FAULT_STORM_BACKOFF_MS      (8u)
+
+/* Highest backoff level, limits the re-arm delay to 8 ms << 7 = 1024 ms */
+#define FAULT_STORM_MAX_LEVEL       (8u)
+
+/* Storm state changes reported to the caller */
+typedef enum
+{
+    FAULT_STORM_NONE = 0,           /* No change */
+    FAULT_STORM_ENTER,              /* The channel entered a storm */
+    FAULT_STORM_EXIT                /* The channel left the storm */
+} fault_storm_change_t;
+
+/* Per-channel storm detector */
+typedef struct
+{
+    uint32_t trip_time[FAULT_STORM_TRIPS];  /* Times of the most recent trips */
+    uint32_t last_trip;                     /* Time of the last trip */
+    uint32_t rearm_at;                      /* Earliest re-arm time during a storm */
+    uint32_t entries;                       /* Number of storms seen */
+    uint8_t next;                           /* Oldest entry of trip_time */
+    uint8_t trips;                          /* Valid entries in trip_time */
+    uint8_t level;                          /* Backoff level, 0 outside of a storm */
+} fault_storm_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+fault_storm_change_t fault_storm_trip(fault_storm_t *storm, uint32_t now);
+
+bool fault_storm_hold(const fault_storm_t *storm, uint32_t now);
+
+bool fault_storm_active(const fault_storm_t *storm);
+
+fault_storm_change_t fault_storm_update(fault_storm_t *storm, uint32_t now);
+
+#endif /* _FAULT_STORM_H_ */
+
+/* End of file [] */
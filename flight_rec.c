@@ -0,0 +1,359 @@
+/******************************************************************************
+* File Name: flight_rec.c
+*
+* Description: This file contains the reset-surviving fault flight recorder. Records are
+*              written in bounded time without allocation so they can be added from the
+*              fault callbacks.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "flight_rec.h"
+#include "app_timer.h"
+#include "telemetry_frame.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Marker of a valid recorder image */
+#define FLIGHT_REC_MAGIC            (0x55564653u)
+
+/* Number of bytes covered by the image CRC */
+#define FLIGHT_REC_CRC_LEN          (offsetof(flight_rec_t, crc))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Recorder image, not cleared by the start-up code */
+CY_NOINIT static flight_rec_t flight_rec;
+
+/* Value of flight_rec.total when each fault type of a port was last opened */
+static uint32_t flight_rec_open[UVOV_PORT_COUNT][FAULT_TYPE_COUNT];
+
+/* Set while each fault type of a port has an open record */
+static bool flight_rec_is_open[UVOV_PORT_COUNT][FAULT_TYPE_COUNT];
+
+/* Set when the image has changed since its CRC was last computed */
+static volatile bool flight_rec_dirty = false;
+
+#if FLIGHT_REC_FLASH_ENABLE
+/* The recorder image must fit into one flash row */
+typedef char flight_rec_fits_row_t[(sizeof(flight_rec_t) <= CY_FLASH_SIZEOF_ROW) ? 1 : -1];
+
+/* Flash row of the recorder. Allocated by the linker so the application
+ * image never overlaps it; erased (invalid) whenever the device is
+ * programmed. Only read through a volatile pointer, as Cy_Flash_WriteRow()
+ * changes it behind the compiler.
+ */
+CY_ALIGN(CY_FLASH_SIZEOF_ROW) static const uint8_t flight_rec_flash[CY_FLASH_SIZEOF_ROW] = { 0u };
+
+/* Value of flight_rec.total at the last flash commit */
+static uint32_t flight_rec_committed = 0;
+
+/* Flash row image */
+static uint32_t flight_rec_row[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+#endif /* FLIGHT_REC_FLASH_ENABLE */
+
+/*******************************************************************************
+* Function Name: flight_rec_valid
+********************************************************************************
+* Summary:
+*  Returns whether a recorder image carries the magic value and a matching
+*  CRC.
+*
+* Parameters:
+*  image - recorder image
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+static bool flight_rec_valid(const flight_rec_t *image)
+{
+    return ((image->magic == FLIGHT_REC_MAGIC) &&
+            (telemetry_crc16(TELEMETRY_CRC_INIT, (const uint8_t *)image, FLIGHT_REC_CRC_LEN) == image->crc));
+}
+
+/*******************************************************************************
+* Function Name: flight_rec_seal
+********************************************************************************
+* Summary:
+*  Advances the sequence number and updates the CRC of the RAM image. The CRC
+*  is computed outside of the critical section on a snapshot and only stored
+*  if no record was written in the meantime; otherwise the image stays dirty
+*  and is sealed again on the next call. Called from the main loop.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void flight_rec_seal(void)
+{
+    flight_rec_t snapshot;
+    uint32_t intr_state;
+    uint16_t crc;
+
+    intr_state = Cy_SysLib_EnterCriticalSection();
+    flight_rec_dirty = false;
+    flight_rec.seq++;
+    snapshot = flight_rec;
+    Cy_SysLib_ExitCriticalSection(intr_state);
+
+    crc = telemetry_crc16(TELEMETRY_CRC_INIT, (const uint8_t *)&snapshot, FLIGHT_REC_CRC_LEN);
+
+    intr_state = Cy_SysLib_EnterCriticalSection();
+    if (!flight_rec_dirty)
+    {
+        flight_rec.crc = crc;
+    }
+    Cy_SysLib_ExitCriticalSection(intr_state);
+}
+
+/*******************************************************************************
+* Function Name: flight_rec_init
+********************************************************************************
+* Summary:
+*  Validates the recorder image left in RAM by the previous run and, when
+*  enabled, the one committed to flash. The valid image with the higher
+*  sequence number is kept and its boot count advanced; with no valid image
+*  (power-on without a committed image, corruption) the recorder is cleared.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_init(void)
+{
+    bool ram_valid = flight_rec_valid(&flight_rec);
+
+#if FLIGHT_REC_FLASH_ENABLE
+    const volatile uint8_t *row = flight_rec_flash;
+    flight_rec_t saved;
+    uint32_t idx;
+
+    for (idx = 0; idx < sizeof(saved); idx++)
+    {
+        ((uint8_t *)&saved)[idx] = row[idx];
+    }
+    if (flight_rec_valid(&saved) && (!ram_valid || ((int16_t)(uint16_t)(saved.seq - flight_rec.seq) > 0)))
+    {
+        flight_rec = saved;
+        ram_valid = true;
+    }
+#endif /* FLIGHT_REC_FLASH_ENABLE */
+
+    if (!ram_valid)
+    {
+        memset(&flight_rec, 0, sizeof(flight_rec));
+        flight_rec.magic = FLIGHT_REC_MAGIC;
+    }
+    flight_rec.boots++;
+    flight_rec_seal();
+
+#if FLIGHT_REC_FLASH_ENABLE
+    flight_rec_committed = flight_rec.total;
+#endif /* FLIGHT_REC_FLASH_ENABLE */
+}
+
+/*******************************************************************************
+* Function Name: flight_rec_begin
+********************************************************************************
+* Summary:
+*  Records the start of a fault. Called from the fault callbacks in interrupt
+*  context; runs in constant time. The CRC is updated by the main loop.
+*
+* Parameters:
+*  port - USBPD port
+*  type - fault type
+*  code - threshold code in force
+*  debounce - debounce (filterSel) value in force
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_begin(uint8_t port, fault_type_t type, uint8_t code, uint8_t debounce)
+{
+    uint32_t total = flight_rec.total;
+    flight_rec_entry_t *entry = &flight_rec.entry[total & (FLIGHT_REC_ENTRIES - 1u)];
+
+    entry->timestamp = app_timer_get_ms();
+    entry->duration = FLIGHT_REC_DURATION_OPEN;
+    entry->type = (uint8_t)((port << FLIGHT_REC_PORT_POS) | (uint8_t)type);
+    entry->code = code;
+    entry->debounce = debounce;
+    entry->boot = (uint8_t)flight_rec.boots;
+
+    flight_rec_open[port][type] = total;
+    flight_rec_is_open[port][type] = true;
+    flight_rec.total = total + 1u;
+    flight_rec_dirty = true;
+}
+
+/*******************************************************************************
+* Function Name: flight_rec_end
+********************************************************************************
+* Summary:
+*  Records the duration of the open fault of a type, unless the record has
+*  been overwritten in the meantime. Called from the main loop.
+*
+* Parameters:
+*  port - USBPD port
+*  type - fault type
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_end(uint8_t port, fault_type_t type)
+{
+    uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+    flight_rec_entry_t *entry;
+
+    if (flight_rec_is_open[port][type] &&
+        ((flight_rec.total - flight_rec_open[port][type]) <= FLIGHT_REC_ENTRIES))
+    {
+        entry = &flight_rec.entry[flight_rec_open[port][type] & (FLIGHT_REC_ENTRIES - 1u)];
+        entry->duration = app_timer_get_ms() - entry->timestamp;
+        flight_rec_dirty = true;
+    }
+    flight_rec_is_open[port][type] = false;
+
+    Cy_SysLib_ExitCriticalSection(intr_state);
+}
+
+/*******************************************************************************
+* Function Name: flight_rec_armed
+********************************************************************************
+* Summary:
+*  Records the time from boot until the UV/OV comparators were armed for the
+*  current boot.
+*
+* Parameters:
+*  armed_us - boot-to-armed time in us
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_armed(uint32_t armed_us)
+{
+    flight_rec.armed_us[flight_rec.boots & (FLIGHT_REC_BOOT_ENTRIES - 1u)] =
+        (uint16_t)((armed_us < FLIGHT_REC_ARMED_MAX_US) ? armed_us : FLIGHT_REC_ARMED_MAX_US);
+    flight_rec_dirty = true;
+}
+
+/*******************************************************************************
+* Function Name: flight_rec_service
+********************************************************************************
+* Summary:
+*  Updates the CRC of the RAM image after a change, and commits the recorder
+*  to its flash row once FLIGHT_REC_COMMIT_EVENTS new records have been
+*  written. The commit stalls the CPU for the flash write, so it is deferred
+*  until the caller reports that no fault is being handled. Called from the
+*  main loop.
+*
+* Parameters:
+*  quiet - true when every fault channel is NORMAL and no fault event is pending
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_service(bool quiet)
+{
+#if FLIGHT_REC_FLASH_ENABLE
+    uint32_t intr_state;
+    bool commit;
+#endif /* FLIGHT_REC_FLASH_ENABLE */
+
+    if (flight_rec_dirty)
+    {
+        flight_rec_seal();
+    }
+
+#if FLIGHT_REC_FLASH_ENABLE
+    if (!quiet || ((flight_rec.total - flight_rec_committed) < FLIGHT_REC_COMMIT_EVENTS))
+    {
+        return;
+    }
+
+    /* Take a sealed snapshot, then write the row outside of the critical section */
+    memset(flight_rec_row, 0xFF, sizeof(flight_rec_row));
+    intr_state = Cy_SysLib_EnterCriticalSection();
+    commit = !flight_rec_dirty;
+    if (commit)
+    {
+        memcpy(flight_rec_row, &flight_rec, sizeof(flight_rec));
+        flight_rec_committed = flight_rec.total;
+    }
+    Cy_SysLib_ExitCriticalSection(intr_state);
+
+    if (commit)
+    {
+        (void)Cy_Flash_WriteRow((uint32_t)(uintptr_t)flight_rec_flash, flight_rec_row);
+    }
+#else
+    (void)quiet;
+#endif /* FLIGHT_REC_FLASH_ENABLE */
+}
+
+/*******************************************************************************
+* Function Name: flight_rec_get
+********************************************************************************
+* Summary:
+*  Returns the recorder image. The record of entry index i is valid for
+*  i < min(total, FLIGHT_REC_ENTRIES); the oldest record is at total % entries
+*  once the ring has wrapped.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  const flight_rec_t *
+*
+*******************************************************************************/
+const flight_rec_t *flight_rec_get(void)
+{
+    return &flight_rec;
+}
+
+/* [] END OF FILE */
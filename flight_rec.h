@@ -0,0 +1,120 @@
+/******************************************************************************
+* File Name: flight_rec.h
+*
+* Description: This is the header file for the VBUS fault flight recorder of the PMG1
+*              MCU Using UVOV Blocks Code Example. Fault records are kept in a no-init
+*              RAM section so they survive a reset, and can optionally be committed to a
+*              reserved flash row.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _FLIGHT_REC_H_
+#define _FLIGHT_REC_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "fault_event.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of fault records kept in RAM, must be a power of two */
+#define FLIGHT_REC_ENTRIES          (8u)
+
+/* Flash commit macro, can also be set through DEFINES in the Makefile */
+#ifndef FLIGHT_REC_FLASH_ENABLE
+#define FLIGHT_REC_FLASH_ENABLE     (0u)
+#endif
+
+/* Number of new records after which the ring is committed to flash. The
+ * commit waits until no fault is active and no fault event is pending, as
+ * the CPU is stalled while the flash row is written.
+ */
+#define FLIGHT_REC_COMMIT_EVENTS    (8u)
+
+/* Duration recorded while a fault is still active */
+#define FLIGHT_REC_DURATION_OPEN    (0xFFFFFFFFu)
+
+/* Number of boots whose boot-to-armed time is kept, must be a power of two */
+#define FLIGHT_REC_BOOT_ENTRIES     (4u)
+
+/* Boot-to-armed time recorded when it does not fit into 16 bits */
+#define FLIGHT_REC_ARMED_MAX_US     (0xFFFFu)
+
+/* Position of the USBPD port in flight_rec_entry_t.type */
+#define FLIGHT_REC_PORT_POS         (4u)
+
+/* Fault record */
+typedef struct
+{
+    uint32_t timestamp;             /* Time of the fault in ms since boot */
+    uint32_t duration;              /* Fault duration in ms */
+    uint8_t  type;                  /* Fault type (fault_type_t) in bits 3:0, port in bits 7:4 */
+    uint8_t  code;                  /* uv_in/OV threshold code in force */
+    uint8_t  debounce;              /* Debounce (filterSel) value in force */
+    uint8_t  boot;                  /* Low byte of the boot count, the time base of timestamp */
+} flight_rec_entry_t;
+
+/* Recorder image, identical in RAM and in the flash row */
+typedef struct
+{
+    uint32_t magic;                 /* FLIGHT_REC_MAGIC when the contents are valid */
+    uint32_t total;                 /* Records written since the recorder was cleared */
+    uint32_t boots;                 /* Resets seen with a valid recorder */
+    flight_rec_entry_t entry[FLIGHT_REC_ENTRIES];
+    uint16_t armed_us[FLIGHT_REC_BOOT_ENTRIES];     /* Boot-to-armed time in us, indexed by boots */
+    uint16_t seq;                   /* Incremented at every update of crc */
+    uint16_t crc;                   /* CRC-16 of the image up to this field */
+} flight_rec_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void flight_rec_init(void);
+
+void flight_rec_begin(uint8_t port, fault_type_t type, uint8_t code, uint8_t debounce);
+
+void flight_rec_end(uint8_t port, fault_type_t type);
+
+void flight_rec_armed(uint32_t armed_us);
+
+void flight_rec_service(bool quiet);
+
+const flight_rec_t *flight_rec_get(void);
+
+#endif /* _FLIGHT_REC_H_ */
+
+/* End of file [] */
@@ -0,0 +1,230 @@
+/******************************************************************************
+* File Name: isr_instr.c
+*
+* Description: This file contains the interrupt latency and duration instrumentation.
+*              Timestamps are taken from SysTick and kept as min/max/mean and histogram
+*              statistics per fault source.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "isr_instr.h"
+
+#if ISR_INSTR_ENABLE
+
+#include "app_timer.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Instrumentation data block */
+static isr_instr_t isr_instr_data;
+
+/* SysTick snapshot taken at the entry of the current interrupt */
+static uint32_t isr_instr_entry_stamp;
+
+/* Fault sources dispatched by the current interrupt, one bit per fault_type_t */
+static uint8_t isr_instr_sources;
+
+/*******************************************************************************
+* Function Name: isr_instr_record
+********************************************************************************
+* Summary:
+*  Adds a sample to a statistics record. Division-free, bounded time.
+*
+* Parameters:
+*  stat - statistics record
+*  cycles - sample in CPU cycles
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void isr_instr_record(isr_instr_stat_t *stat, uint32_t cycles)
+{
+    uint32_t bin = cycles >> ISR_INSTR_HIST_SHIFT;
+
+    if ((stat->count == 0u) || (cycles < stat->min))
+    {
+        stat->min = cycles;
+    }
+    if (cycles > stat->max)
+    {
+        stat->max = cycles;
+    }
+    stat->count++;
+    stat->sum += cycles;
+
+    if (bin >= ISR_INSTR_HIST_BINS)
+    {
+        bin = ISR_INSTR_HIST_BINS - 1u;
+    }
+    if (stat->hist[bin] != UINT16_MAX)
+    {
+        stat->hist[bin]++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: isr_instr_entry
+********************************************************************************
+* Summary:
+*  Marks the entry of the USBPD interrupt handler.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void isr_instr_entry(void)
+{
+    isr_instr_entry_stamp = app_timer_stamp();
+    isr_instr_sources = 0;
+}
+
+/*******************************************************************************
+* Function Name: isr_instr_dispatch
+********************************************************************************
+* Summary:
+*  Marks the dispatch of a fault callback from the USBPD interrupt handler.
+*
+* Parameters:
+*  type - fault source of the callback
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void isr_instr_dispatch(fault_type_t type)
+{
+    isr_instr_record(&isr_instr_data.dispatch[type], app_timer_elapsed(isr_instr_entry_stamp));
+    isr_instr_sources |= (uint8_t)(1u << type);
+}
+
+/*******************************************************************************
+* Function Name: isr_instr_exit
+********************************************************************************
+* Summary:
+*  Marks the exit of the USBPD interrupt handler. The duration is accounted
+*  to every fault source dispatched by this interrupt.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void isr_instr_exit(void)
+{
+    uint32_t cycles = app_timer_elapsed(isr_instr_entry_stamp);
+    uint8_t type;
+
+    for (type = 0; type < (uint8_t)FAULT_TYPE_COUNT; type++)
+    {
+        if ((isr_instr_sources & (1u << type)) != 0u)
+        {
+            isr_instr_record(&isr_instr_data.duration[type], cycles);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: isr_instr_get
+********************************************************************************
+* Summary:
+*  Returns the instrumentation data block. The records are updated from
+*  interrupt context; readers in the main loop should copy a record inside
+*  a critical section if a consistent snapshot is needed.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  const isr_instr_t *
+*
+*******************************************************************************/
+const isr_instr_t *isr_instr_get(void)
+{
+    return &isr_instr_data;
+}
+
+/*******************************************************************************
+* Function Name: isr_instr_copy
+********************************************************************************
+* Summary:
+*  Copies a statistics record with interrupts disabled, so the copy is not
+*  torn by a sample recorded in between. Not intended for interrupt context.
+*
+* Parameters:
+*  copy - destination
+*  stat - statistics record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void isr_instr_copy(isr_instr_stat_t *copy, const isr_instr_stat_t *stat)
+{
+    uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+
+    *copy = *stat;
+    Cy_SysLib_ExitCriticalSection(intr_state);
+}
+
+/*******************************************************************************
+* Function Name: isr_instr_mean
+********************************************************************************
+* Summary:
+*  Returns the mean of a statistics record in CPU cycles. Not intended for
+*  interrupt context.
+*
+* Parameters:
+*  stat - statistics record
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t isr_instr_mean(const isr_instr_stat_t *stat)
+{
+    return (stat->count != 0u) ? (stat->sum / stat->count) : 0u;
+}
+
+#endif /* ISR_INSTR_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name: isr_instr.h
+*
+* Description: This is the header file for the optional interrupt latency and duration
+*              instrumentation of the PMG1 MCU Using UVOV Blocks Code Example. When
+*              ISR_INSTR_ENABLE is 0 the hooks expand to nothing.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _ISR_INSTR_H_
+#define _ISR_INSTR_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "fault_event.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Instrumentation macro, can also be set through DEFINES in the Makefile */
+#ifndef ISR_INSTR_ENABLE
+#define ISR_INSTR_ENABLE            (0u)
+#endif
+
+/* Number of histogram bins; the last bin collects everything above range */
+#define ISR_INSTR_HIST_BINS         (8u)
+
+/* Width of a histogram bin as a power of two CPU cycles (64 cycles) */
+#define ISR_INSTR_HIST_SHIFT        (6u)
+
+#if ISR_INSTR_ENABLE
+
+/* Timing statistics of one measurement, in CPU cycles */
+typedef struct
+{
+    uint32_t count;                         /* Number of samples */
+    uint32_t min;                           /* Shortest sample */
+    uint32_t max;                           /* Longest sample */
+    uint32_t sum;                           /* Sum of all samples, for the mean */
+    uint16_t hist[ISR_INSTR_HIST_BINS];     /* Sample histogram */
+} isr_instr_stat_t;
+
+/* Instrumentation data block */
+typedef struct
+{
+    isr_instr_stat_t dispatch[FAULT_TYPE_COUNT];    /* ISR entry to callback dispatch */
+    isr_instr_stat_t duration[FAULT_TYPE_COUNT];    /* ISR entry to exit */
+} isr_instr_t;
+
+/* Hooks placed in the USBPD interrupt handler and the fault callbacks */
+#define ISR_INSTR_ENTRY()           isr_instr_entry()
+#define ISR_INSTR_DISPATCH(type)    isr_instr_dispatch(type)
+#define ISR_INSTR_EXIT()            isr_instr_exit()
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void isr_instr_entry(void);
+
+void isr_instr_dispatch(fault_type_t type);
+
+void isr_instr_exit(void);
+
+const isr_instr_t *isr_instr_get(void);
+
+void isr_instr_copy(isr_instr_stat_t *copy, const isr_instr_stat_t *stat);
+
+uint32_t isr_instr_mean(const isr_instr_stat_t *stat);
+
+#else
+
+#define ISR_INSTR_ENTRY()
+#define ISR_INSTR_DISPATCH(type)
+#define ISR_INSTR_EXIT()
+
+#endif /* ISR_INSTR_ENABLE */
+
+#endif /* _ISR_INSTR_H_ */
+
+/* End of file [] */
@@ -0,0 +1,368 @@
+/******************************************************************************
+* File Name: low_power.c
+*
+* Description: This file contains the deep sleep idle mode. The CPU sleeps with the
+*              UV/OV comparators armed and is woken through the USBPD wake-up interrupt;
+*              the wake-to-handler latency is recorded on each fault wake-up.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "low_power.h"
+#include "app_timer.h"
+#include "fault_event.h"
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_en_syspm_status_t low_power_deepsleep_cb(cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Parameters passed to the deep sleep callback of each port */
+static cy_stc_syspm_callback_params_t low_power_cb_params[UVOV_PORT_COUNT];
+
+/* Deep sleep callbacks registered with the SysPm driver, one per port */
+static cy_stc_syspm_callback_t low_power_cb[UVOV_PORT_COUNT];
+
+/* SysTick snapshot taken when the CPU leaves deep sleep */
+static volatile uint32_t low_power_wake_stamp = 0;
+
+/* Set from wake-up until the first USBPD interrupt is taken */
+static volatile bool low_power_wake_pending = false;
+
+/* Wake-up latency statistics */
+static low_power_stats_t low_power_stats;
+
+/* WDT count and time in us at the start of the ILO measurement */
+static uint32_t low_power_cal_count = 0;
+static uint32_t low_power_cal_us = 0;
+
+/* Fraction of a ms of sleep time not yet added to the application timer, Q16 */
+static uint32_t low_power_ms_frac = 0;
+
+/* WDT match interrupt configuration */
+static const cy_stc_sysint_t low_power_wdt_intr_config =
+{
+    .intrSrc = srss_interrupt_IRQn,
+    .intrPriority = LOW_POWER_WDT_INTR_PRIORITY,
+};
+
+/*******************************************************************************
+* Function Name: low_power_deepsleep_cb
+********************************************************************************
+* Summary:
+*  Deep sleep callback. Prepares the USBPD block for deep sleep and records
+*  the wake-up time. The AFTER_TRANSITION step runs with interrupts still
+*  disabled, before the pending USBPD interrupt is serviced.
+*
+* Parameters:
+*  callbackParams - callback parameters, context holds the USBPD context
+*  mode - callback mode
+*
+* Return:
+*  cy_en_syspm_status_t
+*
+*******************************************************************************/
+static cy_en_syspm_status_t low_power_deepsleep_cb(cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode)
+{
+    cy_stc_usbpd_context_t *context = (cy_stc_usbpd_context_t *)callbackParams->context;
+    cy_en_syspm_status_t status = CY_SYSPM_SUCCESS;
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            if (!Cy_USBPD_SystemDeepSleep(context))
+            {
+                status = CY_SYSPM_FAIL;
+            }
+            break;
+
+        case CY_SYSPM_CHECK_FAIL:
+            (void)Cy_USBPD_SystemWakeup(context);
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            /* The callbacks of all ports run on every wake-up, count it once */
+            if (context->port == 0u)
+            {
+                low_power_wake_stamp = app_timer_stamp();
+                low_power_wake_pending = true;
+                low_power_stats.wakeups++;
+            }
+            (void)Cy_USBPD_SystemWakeup(context);
+            break;
+
+        default:
+            break;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: low_power_init
+********************************************************************************
+* Summary:
+*  Registers the deep sleep callback for the USBPD block of a port. Called
+*  once for every port.
+*
+* Parameters:
+*  context - the USBPD context
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void low_power_init(cy_stc_usbpd_context_t *context)
+{
+    cy_stc_syspm_callback_params_t *params = &low_power_cb_params[context->port];
+    cy_stc_syspm_callback_t *cb = &low_power_cb[context->port];
+
+    params->base = context->base;
+    params->context = context;
+
+    cb->callback = low_power_deepsleep_cb;
+    cb->type = CY_SYSPM_DEEPSLEEP;
+    cb->skipMode = 0u;
+    cb->callbackParams = params;
+    cb->prevItm = NULL;
+    cb->nextItm = NULL;
+    (void)Cy_SysPm_RegisterCallback(cb);
+}
+
+/*******************************************************************************
+* Function Name: low_power_wdt_isr
+********************************************************************************
+* Summary:
+*  WDT match interrupt. Moves the match LOW_POWER_WDT_WAKE_TICKS ahead so the
+*  CPU wakes twice per counter wrap.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void low_power_wdt_isr(void)
+{
+    Cy_WDT_ClearInterrupt();
+    Cy_WDT_SetMatch((Cy_WDT_GetMatch() + LOW_POWER_WDT_WAKE_TICKS) & LOW_POWER_WDT_COUNT_MASK);
+}
+
+/*******************************************************************************
+* Function Name: low_power_timebase_init
+********************************************************************************
+* Summary:
+*  Starts the WDT used to keep the application timer running through deep
+*  sleep, and the measurement of the ILO against SysTick. Deep sleep is
+*  entered once the measurement is complete.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void low_power_timebase_init(void)
+{
+    Cy_WDT_Enable();
+    low_power_cal_us = app_timer_get_us();
+    low_power_cal_count = Cy_WDT_GetCount();
+
+    Cy_WDT_SetMatch((low_power_cal_count + LOW_POWER_WDT_WAKE_TICKS) & LOW_POWER_WDT_COUNT_MASK);
+    Cy_WDT_ClearInterrupt();
+    (void)Cy_SysInt_Init(&low_power_wdt_intr_config, &low_power_wdt_isr);
+    NVIC_EnableIRQ(low_power_wdt_intr_config.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: low_power_calibrate
+********************************************************************************
+* Summary:
+*  Measures the ILO period once LOW_POWER_ILO_CAL_MS have elapsed since
+*  low_power_timebase_init(). Requires interrupts to be enabled.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool - true when the ILO period is known
+*
+*******************************************************************************/
+static bool low_power_calibrate(void)
+{
+    uint32_t elapsed_us = app_timer_get_us() - low_power_cal_us;
+    uint32_t ticks;
+
+    if (elapsed_us < (LOW_POWER_ILO_CAL_MS * 1000u))
+    {
+        return false;
+    }
+
+    ticks = (Cy_WDT_GetCount() - low_power_cal_count) & LOW_POWER_WDT_COUNT_MASK;
+    if (ticks == 0u)
+    {
+        /* The ILO is not running, start over */
+        low_power_timebase_init();
+        return false;
+    }
+
+    low_power_stats.ilo_ms_q16 = (uint32_t)(((uint64_t)elapsed_us << 16u) / ((uint64_t)ticks * 1000u));
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: low_power_add_sleep
+********************************************************************************
+* Summary:
+*  Adds the time counted by the WDT since a deep sleep entry to the
+*  application timer. Runs with interrupts disabled, before the interrupt that
+*  woke the CPU is serviced. The division-free Q16 conversion keeps the
+*  fraction of a ms for the next wake-up.
+*
+* Parameters:
+*  start - WDT count at the deep sleep entry
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void low_power_add_sleep(uint32_t start)
+{
+    uint32_t ticks = (Cy_WDT_GetCount() - start) & LOW_POWER_WDT_COUNT_MASK;
+    uint32_t ms_q16 = (ticks * low_power_stats.ilo_ms_q16) + low_power_ms_frac;
+
+    low_power_ms_frac = ms_q16 & 0xFFFFu;
+    app_timer_add_ms(ms_q16 >> 16u);
+    low_power_stats.sleep_ms += (ms_q16 >> 16u);
+}
+
+/*******************************************************************************
+* Function Name: low_power_idle
+********************************************************************************
+* Summary:
+*  Enters deep sleep unless a fault event is waiting. The check and the sleep
+*  entry are done with interrupts disabled so an event raised in between
+*  wakes the CPU immediately instead of being left in the ring. Stays awake
+*  until the ILO period used for the sleep time is measured.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void low_power_idle(void)
+{
+    uint32_t start;
+
+    if ((low_power_stats.ilo_ms_q16 == 0u) && !low_power_calibrate())
+    {
+        return;
+    }
+
+    __disable_irq();
+    if (!fault_event_pending())
+    {
+        start = Cy_WDT_GetCount();
+        if (Cy_SysPm_CpuEnterDeepSleep() == CY_SYSPM_SUCCESS)
+        {
+            low_power_add_sleep(start);
+        }
+    }
+    __enable_irq();
+
+    /* The wake-up interrupt, if any, has been serviced at this point */
+    low_power_wake_pending = false;
+}
+
+/*******************************************************************************
+* Function Name: low_power_isr_entry
+********************************************************************************
+* Summary:
+*  Called at the entry of the USBPD interrupt handler. Records the latency
+*  from the deep sleep exit to the handler for the first interrupt taken
+*  after a wake-up.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void low_power_isr_entry(void)
+{
+    uint32_t latency;
+
+    if (low_power_wake_pending)
+    {
+        latency = app_timer_elapsed(low_power_wake_stamp);
+        low_power_wake_pending = false;
+        low_power_stats.fault_wakeups++;
+        low_power_stats.last_latency = latency;
+        if (latency > low_power_stats.max_latency)
+        {
+            low_power_stats.max_latency = latency;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: low_power_get_stats
+********************************************************************************
+* Summary:
+*  Returns the wake-up latency statistics.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  const low_power_stats_t *
+*
+*******************************************************************************/
+const low_power_stats_t *low_power_get_stats(void)
+{
+    return &low_power_stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: low_power.h
+*
+* Description: This is the header file for the deep sleep idle mode of the PMG1 MCU
+*              Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _LOW_POWER_H_
+#define _LOW_POWER_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* SysTick stops in deep sleep. The WDT counts the ILO through deep sleep and
+ * the sleep time is added to the application timer on every wake-up. The WDT
+ * match interrupt wakes the CPU every LOW_POWER_WDT_WAKE_TICKS ILO cycles
+ * (about 0.8 s at 40 kHz) so the 16-bit counter never wraps unseen.
+ */
+#define LOW_POWER_WDT_WAKE_TICKS    (0x8000u)
+
+/* Mask of the 16-bit WDT counter */
+#define LOW_POWER_WDT_COUNT_MASK    (0xFFFFu)
+
+/* Priority of the WDT match interrupt */
+#define LOW_POWER_WDT_INTR_PRIORITY (3u)
+
+/* Time in ms over which the ILO is measured against SysTick before the first
+ * deep sleep entry. Must not exceed 65 ms.
+ */
+#define LOW_POWER_ILO_CAL_MS        (32u)
+
+/* Wake-up latency statistics, in CPU cycles from the end of the deep sleep
+ * transition to the entry of the USBPD interrupt handler.
+ */
+typedef struct
+{
+    uint32_t wakeups;               /* Deep sleep exits observed */
+    uint32_t fault_wakeups;         /* Exits followed by a USBPD interrupt */
+    uint32_t last_latency;          /* Latency of the most recent fault wake-up */
+    uint32_t max_latency;           /* Worst-case latency seen */
+    uint32_t sleep_ms;              /* Time spent in deep sleep in ms */
+    uint32_t ilo_ms_q16;            /* Measured ILO period in ms, Q16 */
+} low_power_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void low_power_init(cy_stc_usbpd_context_t *context);
+
+void low_power_timebase_init(void);
+
+void low_power_idle(void);
+
+void low_power_isr_entry(void);
+
+const low_power_stats_t *low_power_get_stats(void);
+
+#endif /* _LOW_POWER_H_ */
+
+/* End of file [] */
@@ -43,9 +43,24 @@
 /*******************************************************************************
  * Include header files
  ******************************************************************************/
-#include <stdio.h>
-#include <inttypes.h>
 #include "uvov.h"
+#include "uvov_hal.h"
+#include "uvov_config.h"
+#include "app_timer.h"
+#include "fault_event.h"
+#include "scheduler.h"
+#include "low_power.h"
+#include "fault_fsm.h"
+#include "isr_instr.h"
+#include "uart_log.h"
+#include "flight_rec.h"
+#include "telemetry.h"
+#include "uvov_profile.h"
+#include "fault_storm.h"
+#include "vbus_adc.h"
+#include "vbus_dvdt.h"
+#include "vbus_ladder.h"
+#include "uart_shell.h"
 
 /*******************************************************************************
 * Macros
@@ -54,19 +69,33 @@
 #define CY_ASSERT_FAILED                       (0u)
 
 /* Voltage value in mV for calculating overvoltage and undervoltage thresholds */
+#ifndef THRESHOLD_VOLT
 #define THRESHOLD_VOLT                         (5000u)
+#endif /* THRESHOLD_VOLT */
 
-/* Hysteresis Voltage used to ignore oscillitation in voltage when Vbus voltage
- * is on the UVP or OVP threshold
- * PMG1-S2 has a higher hysteresis voltage for UVP due to its limited set of UV
- * threshold values and input VBUS voltage step sizes.
+/* Hysteresis used to ignore oscillitation in voltage when Vbus voltage is on
+ * the UVP or OVP threshold, in comparator steps between the trip threshold and
+ * the threshold armed while the fault is active. On PMG1-S2 a step is one code
+ * of the UVOV reference ladder (250 mV below 9 V, 500 mV above), so the band
+ * follows the ladder for any contract voltage.
  */
-#define HYST_OVP_VOLT                          (4950u)
-#if defined(CY_DEVICE_SERIES_PMG1S2)
-#define HYST_UVP_VOLT                          (5400u)
-#else
-#define HYST_UVP_VOLT                          (5150u)
-#endif
+#define HYST_OVP_STEPS                         (1u)
+#define HYST_UVP_STEPS                         (1u)
+
+/* Largest hysteresis in comparator steps accepted from the UART shell */
+#define HYST_MAX_STEPS                         (8u)
+
+/* LED toggle periods in ms used to indicate an active overvoltage or undervoltage */
+#define LED_OVP_TOGGLE_MS                      (125u)
+#define LED_UVP_TOGGLE_MS                      (1000u)
+
+/* Period in ms at which VBUS is polled for fault recovery */
+#define FAULT_POLL_MS                          (APP_TIMER_TICK_MS)
+
+/* Delay in ms before a deferred UVP enable is completed. Two ticks guarantee
+ * at least one full tick, well above UVP_SETTLE_TIME_US.
+ */
+#define UVP_COMPLETE_DELAY_MS                  (2u * APP_TIMER_TICK_MS)
 
 /* Flag indicating the type of gate driver to be controlled, true for Provider FET control */
 #define PROVIDER_FET_CTRL                      (1u)
@@ -79,65 +108,272 @@ typedef enum
     VBUS_NORMAL       = 2
 } vbus_state_t;
 
+/* Fault handling state of a USBPD port */
+typedef struct
+{
+    volatile uint16_t ovp_volt_in_force;    /* Voltage used to arm the OVP comparator, recorded with each OVP event */
+    volatile uint16_t uvp_volt_in_force;    /* Voltage used to arm the UVP comparator, recorded with each UVP event */
+    const uvov_profile_t *profile;          /* Thresholds of the contract voltage in force */
+    uvov_profile_t contract;                /* Thresholds of a contract voltage without a cached profile */
+    fault_fsm_t ovp_fsm;                    /* OVP fault channel state machine */
+    fault_fsm_t uvp_fsm;                    /* UVP fault channel state machine */
+    fault_storm_t ovp_storm;                /* OVP fault storm detector */
+    fault_storm_t uvp_storm;                /* UVP fault storm detector */
+    uint8_t hyst_ovp_steps;                 /* Comparator steps of the OVP hysteresis */
+    uint8_t hyst_uvp_steps;                 /* Comparator steps of the UVP hysteresis */
+    uint32_t dropped_seen;                  /* Dropped events of the port already handled */
+#if UVOV_HAL_UVP_DEFERRED
+    bool uvp_complete_pending;              /* A deferred UVP enable waits for completion */
+    uint32_t uvp_complete_at;               /* Time in ms at which the UVP enable is completed */
+#endif /* UVOV_HAL_UVP_DEFERRED */
+#if VBUS_DVDT_ENABLE
+    vbus_dvdt_t dvdt;                       /* dV/dt predictor, projects to the OV trip level of the profile */
+    bool dvdt_fet_off;                      /* The predictor turned the provider FET off */
+#endif /* VBUS_DVDT_ENABLE */
+#if VBUS_LADDER_ENABLE
+    vbus_ladder_t ladder;                   /* VBUS estimate with the UV comparator ladder */
+#endif /* VBUS_LADDER_ENABLE */
+} uvov_port_t;
+
 /* Debug print macro to enable UART print */
+#ifndef DEBUG_PRINT
 #define DEBUG_PRINT                            (0u)
+#endif /* DEBUG_PRINT */
+
+/* The UART is used by the debug print, the binary telemetry stream and the
+ * command shell
+ */
+#define UART_ENABLE                            (DEBUG_PRINT || TELEMETRY_ENABLE || UART_SHELL_TASK)
+
+/* Low power macro to enter deep sleep while no fault is active. The UV/OV
+ * comparators stay armed and wake the device through the USBPD interrupt.
+ */
+#ifndef LOW_POWER_MODE
+#define LOW_POWER_MODE                         (0u)
+#endif /* LOW_POWER_MODE */
+
+/* The periodic VBUS ladder estimate needs the PMG1-S2 UV ladder and would keep
+ * the device out of deep sleep
+ */
+#define VBUS_LADDER_TASK                       (VBUS_LADDER_ENABLE && UVOV_HAL_UV_SEARCH && !LOW_POWER_MODE)
+
+/* The command shell polls the receive ring and would keep the device out of
+ * deep sleep
+ */
+#define UART_SHELL_TASK                        (UART_SHELL_ENABLE && !LOW_POWER_MODE)
 
 /*******************************************************************************
 * Global Variables
 ********************************************************************************/
-/* USBPD context*/
-cy_stc_usbpd_context_t USBPD_context;
+/* USBPD context of each port */
+cy_stc_usbpd_context_t USBPD_context[UVOV_PORT_COUNT];
+
+/* Fault handling state of each port */
+static uvov_port_t uvov_port[UVOV_PORT_COUNT];
 
-/* Flag used to indicate whether a OVP interrupt has occurred or not */
-volatile bool OVP_FLAG = 0;
+/* Toggle period of the running LED pattern, 0 when the LED is steady ON */
+static uint32_t led_period = 0;
 
-/* Flag used to indicate whether a UVP interrupt has occurred or not */
-volatile bool UVP_FLAG = 0;
+/* SysTick snapshot taken at the entry of the USBPD interrupt */
+static uint32_t fet_isr_stamp = 0;
+
+#if UART_SHELL_TASK
+/* RAM copies of the configurator settings of each port, changed by the shell */
+static cy_stc_usbpd_config_t shell_config[UVOV_PORT_COUNT];
+static cy_stc_fault_vbus_ovp_cfg_t shell_ovp_config[UVOV_PORT_COUNT];
+static cy_stc_fault_vbus_uvp_cfg_t shell_uvp_config[UVOV_PORT_COUNT];
+#endif /* UART_SHELL_TASK */
 
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
+/* Returns the comparator threshold code currently programmed for a fault type */
+static uint8_t fault_code_get(cy_stc_usbpd_context_t *context, fault_type_t type)
+{
+    return (type == FAULT_TYPE_OVP) ? uvov_hal_ov_code(context) : uvov_hal_uv_code(context);
+}
+
+/* Returns the debounce setting currently in force for a fault type */
+static uint8_t fault_debounce_get(cy_stc_usbpd_context_t *context, fault_type_t type)
+{
+    if (type == FAULT_TYPE_OVP)
+    {
+        return GET_VBUS_OVP_TABLE(context)->debounce;
+    }
+    return uvov_hal_uvp_debounce(context);
+}
+
+/* Returns the VBUS voltage measured by the ADC, which is run on port 0 only */
+static uint16_t fault_vbus_get(uint8_t port)
+{
+    return (port == 0u) ? vbus_adc_get_mv() : 0u;
+}
+
+/* Returns the voltage arming the trip threshold of a fault type. Events
+ * recorded with another voltage were raised by the hysteresis threshold.
+ */
+static uint16_t fault_trip_volt_get(uint8_t port, fault_type_t type)
+{
+    const uvov_profile_t *profile = uvov_port[port].profile;
+
+    return (type == FAULT_TYPE_OVP) ? profile->ovp_volt : profile->volt;
+}
+
+/* Returns true when the UVOV block turns the provider FET off at a trip for
+ * both OV and UV. This follows the OVP mode of the device configurator: "HW
+ * controlled FET OFF" selects the hardware control, any other mode lets the
+ * fault callbacks switch the FET in software.
+ */
+static bool fet_ctrl_auto(cy_stc_usbpd_context_t *context)
+{
+    return (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL);
+}
+
+/* Turns the provider FET off from a fault callback in software mode and
+ * returns the CPU cycles since the interrupt entry. In hardware mode the FET
+ * is already off when the interrupt is taken and the firmware has no time
+ * stamp of the trip, so 0 is returned.
+ */
+static uint16_t fet_ctrl_fault(cy_stc_usbpd_context_t *context)
+{
+    uint32_t cycles;
+
+    if (fet_ctrl_auto(context))
+    {
+        return 0u;
+    }
+
+    Cy_USBPD_Vbus_GdrvPfetOff(context, false);
+    cycles = app_timer_elapsed(fet_isr_stamp);
+    return (uint16_t)((cycles < FAULT_EVENT_FET_OFF_MAX) ? cycles : FAULT_EVENT_FET_OFF_MAX);
+}
+
+/* Applies the FET control mode to the hardware FET control of the enabled
+ * comparators, called from the critical sections arming a comparator. The
+ * hardware mode also restores the OV control the PMG1-S2 UV reference change
+ * suspends.
+ */
+static void fet_ctrl_apply(cy_stc_usbpd_context_t *context)
+{
+    bool autoCtrl = fet_ctrl_auto(context);
+
+    if (GET_VBUS_OVP_TABLE(context)->enable)
+    {
+        if (autoCtrl)
+        {
+            (void)Cy_USBPD_Fault_FetAutoModeEnable(context, PROVIDER_FET_CTRL, CY_USBPD_VBUS_FILTER_ID_OV);
+        }
+        else
+        {
+            Cy_USBPD_Fault_FetAutoModeDisable(context, PROVIDER_FET_CTRL, CY_USBPD_VBUS_FILTER_ID_OV);
+        }
+    }
+    if (GET_VBUS_UVP_TABLE(context)->enable)
+    {
+        if (autoCtrl)
+        {
+            (void)Cy_USBPD_Fault_FetAutoModeEnable(context, PROVIDER_FET_CTRL, CY_USBPD_VBUS_FILTER_ID_UV);
+        }
+        else
+        {
+            Cy_USBPD_Fault_FetAutoModeDisable(context, PROVIDER_FET_CTRL, CY_USBPD_VBUS_FILTER_ID_UV);
+        }
+    }
+}
+
+/* Queues a fault event, called with the USBPD interrupts blocked */
+static void fault_raise(cy_stc_usbpd_context_t *context, fault_type_t type, bool compOut, uint8_t flags,
+        uint16_t fet_off)
+{
+    uvov_port_t *p = &uvov_port[context->port];
+    fault_event_t evt;
+
+    evt.timestamp = app_timer_get_ms();
+    evt.volt = (type == FAULT_TYPE_OVP) ? p->ovp_volt_in_force : p->uvp_volt_in_force;
+    evt.vbus = fault_vbus_get(context->port);
+    evt.type = type;
+    evt.comp_out = compOut;
+    evt.code = fault_code_get(context, type);
+    evt.flags = flags;
+    evt.port = context->port;
+    evt.fet_off_cycles = fet_off;
+    fault_event_push(&evt);
+
+    /* Keep a reset-surviving record of faults raised at the trip threshold */
+    if (evt.volt == fault_trip_volt_get(evt.port, type))
+    {
+        flight_rec_begin(evt.port, type, evt.code, fault_debounce_get(context, type));
+    }
+}
+
 /* OVP callback function */
 void ovp_cb(void *context, bool compOut)
 {
-    (void)context;
-    (void)compOut;
-    /* OVP interrupt has triggered, set the OVP flag */
-    OVP_FLAG = 1;
+    uint16_t fet_off = fet_ctrl_fault((cy_stc_usbpd_context_t *)context);
+
+    ISR_INSTR_DISPATCH(FAULT_TYPE_OVP);
+
+    /* OVP interrupt has triggered, queue an OVP event */
+    fault_raise((cy_stc_usbpd_context_t *)context, FAULT_TYPE_OVP, compOut, 0u, fet_off);
 }
 
 /* UVP callback function */
 void uvp_cb(void *context, bool compOut)
 {
-    (void)context;
-    (void)compOut;
-    /* UVP interrupt has triggered, set the UVP flag */
-    UVP_FLAG = 1;
+    uint16_t fet_off = fet_ctrl_fault((cy_stc_usbpd_context_t *)context);
+
+    ISR_INSTR_DISPATCH(FAULT_TYPE_UVP);
+
+    /* UVP interrupt has triggered, queue a UVP event */
+    fault_raise((cy_stc_usbpd_context_t *)context, FAULT_TYPE_UVP, compOut, 0u, fet_off);
 }
 
-/* Interrupt handler for USBPD Port of the device
- * PMG1-S2 needs a different funciton call compared to other PMG1 devices due to
- * the different interupt register used for PMG1-S2 UVP and OVP.
- */
+/* Interrupt handler for a USBPD Port of the device */
+static void usbpd_intr1_handler(cy_stc_usbpd_context_t *context)
+{
+    ISR_INSTR_ENTRY();
+
+    fet_isr_stamp = app_timer_stamp();
+
+#if LOW_POWER_MODE
+    low_power_isr_entry();
+#endif /* LOW_POWER_MODE */
+
+    uvov_hal_isr(context);
+
+    ISR_INSTR_EXIT();
+}
+
+/* Interrupt handler for USBPD Port 0 */
 static void cy_usbpd0_intr1_handler(void)
 {
-/* The MACRO CY_DEVICE_SERIES_PMG1S2 is automatically set to 1 by ModusToolbox
- * when PMG1-S2 device is selected for the application
- */
- #if defined(CY_DEVICE_SERIES_PMG1S2)
-    PMG1S2_USBPD_Intr1Handler(&USBPD_context);
- #else
-     Cy_USBPD_Intr1Handler(&USBPD_context);
- #endif
+    usbpd_intr1_handler(&USBPD_context[0]);
 }
 
-/* Interrupt configuration for USBPD Port of the device */
+/* Interrupt configuration for USBPD Port 0 */
 const cy_stc_sysint_t usbpd_port0_intr1_config =
 {
     .intrSrc = (IRQn_Type)mtb_usbpd_port0_DS_IRQ,
     .intrPriority = 1U,
 };
 
+#if (UVOV_PORT_COUNT > 1u)
+/* Interrupt handler for USBPD Port 1 */
+static void cy_usbpd1_intr1_handler(void)
+{
+    usbpd_intr1_handler(&USBPD_context[1]);
+}
+
+/* Interrupt configuration for USBPD Port 1. Both ports use the same priority so
+ * that their fault callbacks never preempt each other on the event ring.
+ */
+const cy_stc_sysint_t usbpd_port1_intr1_config =
+{
+    .intrSrc = (IRQn_Type)mtb_usbpd_port1_DS_IRQ,
+    .intrPriority = 1U,
+};
+#endif /* (UVOV_PORT_COUNT > 1u) */
+
 /* Part of USBPD driver initialization */
 cy_stc_pd_dpm_config_t* get_dpm_connect_stat()
 {
@@ -145,6 +381,78 @@ cy_stc_pd_dpm_config_t* get_dpm_connect_stat()
     return NULL;
 }
 
+#if UVOV_HAL_UVP_DEFERRED
+/*******************************************************************************
+* Function Name: uvp_complete_task
+********************************************************************************
+* Summary:
+*  Scheduler task that runs the second phase of the deferred UVP enables once
+*  the UV comparator of the port has settled. Stops itself when no port has a
+*  pending enable.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uvp_complete_task(void)
+{
+    uint32_t now = app_timer_get_ms();
+    bool pending = false;
+    uint8_t intr_state;
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        if (!uvov_port[port].uvp_complete_pending)
+        {
+            continue;
+        }
+        if ((int32_t)(now - uvov_port[port].uvp_complete_at) >= 0)
+        {
+            intr_state = Cy_SysLib_EnterCriticalSection();
+            uvov_hal_uvp_arm_complete(&USBPD_context[port]);
+            Cy_SysLib_ExitCriticalSection(intr_state);
+            uvov_port[port].uvp_complete_pending = false;
+        }
+        else
+        {
+            pending = true;
+        }
+    }
+
+    if (!pending)
+    {
+        sched_stop(SCHED_TASK_UVP_COMPLETE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uvp_complete_schedule
+********************************************************************************
+* Summary:
+*  Schedules the completion of a deferred UVP enable of a port.
+*
+* Parameters:
+*  port - USBPD port
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uvp_complete_schedule(uint8_t port)
+{
+    uvov_port[port].uvp_complete_at = app_timer_get_ms() + UVP_COMPLETE_DELAY_MS;
+    uvov_port[port].uvp_complete_pending = true;
+    if (!sched_is_active(SCHED_TASK_UVP_COMPLETE))
+    {
+        sched_start(SCHED_TASK_UVP_COMPLETE, APP_TIMER_TICK_MS, uvp_complete_task);
+    }
+}
+#endif /* UVOV_HAL_UVP_DEFERRED */
+
 /*******************************************************************************
 * Function Name: enable_ovp
 ********************************************************************************
@@ -162,8 +470,45 @@ cy_stc_pd_dpm_config_t* get_dpm_connect_stat()
 void enable_ovp(cy_stc_usbpd_context_t *context, uint16_t volt)
 {
     uint8_t intr_state = Cy_SysLib_EnterCriticalSection();
-    Cy_USBPD_Fault_Vbus_OvpEnable(context, volt, (cy_cb_vbus_fault_t)ovp_cb, PROVIDER_FET_CTRL);
+    uvov_port[context->port].ovp_volt_in_force = volt;
+    uvov_hal_ovp_arm(context, volt, (cy_cb_vbus_fault_t)ovp_cb, PROVIDER_FET_CTRL);
+    fet_ctrl_apply(context);
+    Cy_SysLib_ExitCriticalSection(intr_state);
+}
+
+/*******************************************************************************
+* Function Name: enable_uvp_level
+********************************************************************************
+* Summary:
+*  Arms the UVP block and interrupt with a precomputed UV threshold image, so
+*  only register writes are left for the critical section.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - the voltage the UVP threshold was calculated from
+*  level - UV threshold image returned by uvov_hal_uvp_level() for volt
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void enable_uvp_level(cy_stc_usbpd_context_t *context, uint16_t volt, uvov_hal_uv_level_t level)
+{
+    uint8_t intr_state = Cy_SysLib_EnterCriticalSection();
+    uvov_port[context->port].uvp_volt_in_force = volt;
+    bool deferred = uvov_hal_uvp_arm(context, level, (cy_cb_vbus_fault_t)uvp_cb, PROVIDER_FET_CTRL);
+    fet_ctrl_apply(context);
     Cy_SysLib_ExitCriticalSection(intr_state);
+
+#if UVOV_HAL_UVP_DEFERRED
+    /* Complete the enable from the scheduler once the comparator has settled */
+    if (deferred)
+    {
+        uvp_complete_schedule(context->port);
+    }
+#else
+    (void)deferred;
+#endif /* UVOV_HAL_UVP_DEFERRED */
 }
 
 /*******************************************************************************
@@ -181,14 +526,51 @@ void enable_ovp(cy_stc_usbpd_context_t *context, uint16_t volt)
 *
 *******************************************************************************/
 void enable_uvp(cy_stc_usbpd_context_t *context, uint16_t volt)
+{
+    enable_uvp_level(context, volt, uvov_hal_uvp_level(context, volt));
+}
+
+/*******************************************************************************
+* Function Name: vbus_set_profile
+********************************************************************************
+* Summary:
+*  Moves the OVP and UVP trip thresholds together to the ones of a protection
+*  profile, e.g. for a new contract voltage. Both comparators are reprogrammed
+*  from the precomputed profile inside a single critical section so they never
+*  work against mismatched windows.
+*
+* Parameters:
+*  context - the USBPD context
+*  profile - thresholds of the contract voltage
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_set_profile(cy_stc_usbpd_context_t *context, const uvov_profile_t *profile)
 {
     uint8_t intr_state = Cy_SysLib_EnterCriticalSection();
-#if defined(CY_DEVICE_SERIES_PMG1S2)
-    PMG1S2_Vbus_UvpEnable(context, volt, (cy_cb_vbus_fault_t)uvp_cb, PROVIDER_FET_CTRL);
-#else
-    Cy_USBPD_Fault_Vbus_UvpEnable(context, volt, (cy_cb_vbus_fault_t)uvp_cb, PROVIDER_FET_CTRL);
-#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+    uvov_port[context->port].ovp_volt_in_force = profile->ovp_volt;
+    uvov_port[context->port].uvp_volt_in_force = profile->volt;
+    /* On PMG1-S2 the UV reference change suspends the OV auto FET control;
+     * enabling OVP afterwards restores it, so no separate auto mode sequence
+     * is needed.
+     */
+    bool deferred = uvov_hal_uvp_arm(context, profile->uv_trip, (cy_cb_vbus_fault_t)uvp_cb, PROVIDER_FET_CTRL);
+    uvov_hal_ovp_arm(context, profile->ovp_volt, (cy_cb_vbus_fault_t)ovp_cb, PROVIDER_FET_CTRL);
+    fet_ctrl_apply(context);
     Cy_SysLib_ExitCriticalSection(intr_state);
+
+#if UVOV_HAL_UVP_DEFERRED
+    /* Complete the UVP enable from the scheduler once the comparator has settled */
+    if (deferred)
+    {
+        uvp_complete_schedule(context->port);
+    }
+#else
+    (void)deferred;
+#endif /* UVOV_HAL_UVP_DEFERRED */
 }
 
 /*******************************************************************************
@@ -208,40 +590,80 @@ void enable_uvp(cy_stc_usbpd_context_t *context, uint16_t volt)
 vbus_state_t vbus_status(cy_stc_usbpd_context_t *context)
 {
     vbus_state_t vbus_uvov_status = VBUS_NORMAL;
-    uint8_t comp_status;
-#if defined(CY_DEVICE_SERIES_PMG1S2)
-    /* PMG1-S2 overvoltage and undervoltage comparators status bits are available
-     * on the ncell_status register
-     */
-    comp_status = (context->base->ncell_status);
-    if(comp_status & PDSS_NCELL_STATUS_OV_STATUS)
-    {
-        vbus_uvov_status = VBUS_OVERVOLTAGE;
-    }
-    else if(comp_status & PDSS_NCELL_STATUS_UV_STATUS)
-    {
-        vbus_uvov_status = VBUS_UNDERVOLTAGE;
-    }
-#else
-    /* On other PMG1 devices the overvoltage and undervoltage comparator ouput bits
-     * are available on the intr5_status_0 register
-     */
-    comp_status = (context->base->intr5_status_0);
-    if(comp_status & (1U << CY_USBPD_VBUS_FILTER_ID_OV))
+    uvov_hal_status_t comp_status = uvov_hal_comp_read(context);
+
+    if(uvov_hal_ov_active(comp_status))
     {
         vbus_uvov_status = VBUS_OVERVOLTAGE;
     }
-    else if(!(comp_status & (1U << CY_USBPD_VBUS_FILTER_ID_UV)))
+    else if(uvov_hal_uv_active(comp_status))
     {
         vbus_uvov_status = VBUS_UNDERVOLTAGE;
     }
-#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
     return vbus_uvov_status;
 }
 
-#if DEBUG_PRINT
+#if UART_ENABLE
 cy_stc_scb_uart_context_t UART_context;
 
+#if LOW_POWER_MODE
+/* Parameters of the UART deep sleep callback */
+cy_stc_syspm_callback_params_t UART_deep_sleep_params =
+{
+    .base = CYBSP_UART_HW,
+    .context = &UART_context,
+};
+
+/* UART deep sleep callback, lets pending transmissions finish before sleep */
+cy_stc_syspm_callback_t UART_deep_sleep_cb =
+{
+    .callback = Cy_SCB_UART_DeepSleepCallback,
+    .type = CY_SYSPM_DEEPSLEEP,
+    .skipMode = 0u,
+    .callbackParams = &UART_deep_sleep_params,
+    .prevItm = NULL,
+    .nextItm = NULL,
+};
+#endif /* LOW_POWER_MODE */
+
+/*******************************************************************************
+* Function Name: uart_init
+********************************************************************************
+* Summary:
+*  Configures and enables the UART and the logger. The UART is brought up after
+*  the UV/OV comparators are armed; an init failure before that point brings it
+*  up early to report the error.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_init(void)
+{
+    static bool uart_ready = false;
+
+    if (!uart_ready)
+    {
+        uart_ready = true;
+
+        /* Configure and enable the UART peripheral */
+        Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &UART_context);
+        Cy_SCB_UART_Enable(CYBSP_UART_HW);
+
+        /* Send the debug messages and telemetry from the UART interrupt */
+        uart_log_init();
+
+#if LOW_POWER_MODE
+        (void)Cy_SysPm_RegisterCallback(&UART_deep_sleep_cb);
+#endif /* LOW_POWER_MODE */
+    }
+}
+#endif /* UART_ENABLE */
+
+#if DEBUG_PRINT
 /* Variable used for tracking the print status */
 volatile bool ENTER_LOOP = true;
 
@@ -261,173 +683,1257 @@ volatile bool ENTER_LOOP = true;
 *******************************************************************************/
 void check_status(char *message, cy_rslt_t status)
 {
-    char error_msg[50];
+    uart_init();
 
-    sprintf(error_msg, "Error Code: 0x%08" PRIX32 "\n", status);
+    uart_log_puts("\r\n=====================================================\r\n");
+    uart_log_puts("\nFAIL: ");
+    uart_log_puts(message);
+    uart_log_puts("\r\n");
+    uart_log_puts("Error Code: ");
+    uart_log_hex32(status);
+    uart_log_puts("\n");
+    uart_log_puts("\r\n=====================================================\r\n");
 
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n=====================================================\r\n");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\nFAIL: ");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, message);
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, error_msg);
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n=====================================================\r\n");
+    /* The caller stops program execution, send the message out first */
+    uart_log_flush();
 }
 #endif
 
 /*******************************************************************************
-* Function Name: main
+* Function Name: port_log
 ********************************************************************************
 * Summary:
-*  System entrance point. This function performs
-*  - initial setup of device
-*  - USBPD driver initialization 
-*  - enables the UVP and OVP blocks
-*  - prints UVP and OVP detection message to UART when applicable
+*  Prints a message of a port. On dual-port parts the message is prefixed
+*  with the port number.
 *
 * Parameters:
-*  none
+*  port - USBPD port
+*  message - message to print
 *
 * Return:
-*  int
+*  void
 *
 *******************************************************************************/
-int main(void)
+static void port_log(uint8_t port, const char *message)
 {
-    cy_rslt_t result;
-    cy_en_usbpd_status_t usbpd_result;
-    cy_en_sysint_status_t sysint_result;
-
-    /* Initialize the device and board peripherals */
-    result = cybsp_init();
-
-    /* Board initialization failed. Stop program execution */
-    if(result != CY_RSLT_SUCCESS)
-    {
-        /* Insert error handler here */
-        CY_ASSERT(CY_ASSERT_FAILED);
-    }
-
 #if DEBUG_PRINT
-    /* Configure and enable the UART peripheral */
-    Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &UART_context);
-    Cy_SCB_UART_Enable(CYBSP_UART_HW);
-
-    /* Sequence to clear screen */
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\x1b[2J\x1b[;H");
+#if (UVOV_PORT_COUNT > 1u)
+    uart_log_puts("Port ");
+    uart_log_dec(port);
+    uart_log_puts(": ");
+#else
+    (void)port;
+#endif /* (UVOV_PORT_COUNT > 1u) */
+    uart_log_puts(message);
+#else
+    (void)port;
+    (void)message;
+#endif /* DEBUG_PRINT */
+}
 
-    /* Print "Program Start" */
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "****************** ");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "PMG1 MCU: Using UVOV Blocks ");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "****************** \r\n\n");
-#endif
+/*******************************************************************************
+* Function Name: uvov_port_idle
+********************************************************************************
+* Summary:
+*  Returns whether both fault channels of a port are NORMAL and not in a
+*  fault storm.
+*
+* Parameters:
+*  p - port state
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+static bool uvov_port_idle(const uvov_port_t *p)
+{
+    return (fault_fsm_is_normal(&p->ovp_fsm) && fault_fsm_is_normal(&p->uvp_fsm) &&
+            !fault_storm_active(&p->ovp_storm) && !fault_storm_active(&p->uvp_storm));
+}
 
-    /* Enable global interrupts */
-    __enable_irq();
+/*******************************************************************************
+* Function Name: led_task
+********************************************************************************
+* Summary:
+*  Scheduler task toggling the user LED while a fault is active.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void led_task(void)
+{
+    Cy_GPIO_Inv(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
+}
+
+/*******************************************************************************
+* Function Name: led_update
+********************************************************************************
+* Summary:
+*  Selects the LED pattern for the active faults of all ports. Overvoltage
+*  takes precedence over undervoltage; with no active fault the LED is set
+*  to ON.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void led_update(void)
+{
+    uint32_t period = 0;
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        if (!fault_fsm_is_normal(&uvov_port[port].ovp_fsm))
+        {
+            period = LED_OVP_TOGGLE_MS;
+            break;
+        }
+        if (!fault_fsm_is_normal(&uvov_port[port].uvp_fsm))
+        {
+            period = LED_UVP_TOGGLE_MS;
+        }
+    }
+
+    if (period != led_period)
+    {
+        led_period = period;
+        if (period == 0u)
+        {
+            sched_stop(SCHED_TASK_LED);
+            /* Set User LED to ON (Vbus normal status) */
+            Cy_GPIO_Clr(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
+        }
+        else
+        {
+            led_task();
+            sched_start(SCHED_TASK_LED, period, led_task);
+        }
+    }
+}
+
+/* Fault state machine action without any effect */
+static void fault_act_none(uint8_t port)
+{
+    (void)port;
+}
+
+/* OVP detected: set the OVP comparator using OVP hysteresis voltage to ignore small changes on VBUS */
+static void ovp_act_arm_hyst(uint8_t port)
+{
+    port_log(port, "OVP Fault detected.\r\n");
+    enable_ovp(&USBPD_context[port], uvov_port[port].profile->ovp_hyst_volt);
+    led_update();
+}
+
+/* Overvoltage cleared: enable the OVP interrupt at the default threshold */
+static void ovp_act_arm_trip(uint8_t port)
+{
+    enable_ovp(&USBPD_context[port], uvov_port[port].profile->ovp_volt);
+}
+
+/* Turns the provider FET back on once both fault channels are NORMAL, when it
+ * was turned off by software: by the fault callbacks in software mode or by
+ * the dV/dt predictor. In hardware mode the FET is left to the PD stack.
+ */
+static void fet_ctrl_normal(uint8_t port)
+{
+    uvov_port_t *p = &uvov_port[port];
+    bool swOff = !fet_ctrl_auto(&USBPD_context[port]);
+
+#if VBUS_DVDT_ENABLE
+    swOff = swOff || p->dvdt_fet_off;
+#endif /* VBUS_DVDT_ENABLE */
+
+    if (swOff && fault_fsm_is_normal(&p->ovp_fsm) && fault_fsm_is_normal(&p->uvp_fsm))
+    {
+#if VBUS_DVDT_ENABLE
+        p->dvdt_fet_off = false;
+#endif /* VBUS_DVDT_ENABLE */
+        Cy_USBPD_Vbus_GdrvPfetOn(&USBPD_context[port], false);
+    }
+}
+
+/* No overvoltage after re-arming */
+static void ovp_act_normal(uint8_t port)
+{
+    fet_ctrl_normal(port);
+    flight_rec_end(port, FAULT_TYPE_OVP);
+    port_log(port, "No overvoltage detected.\r\n");
+    led_update();
+}
+
+/* UVP detected: set the UVP comparator using UVP hysteresis voltage to ignore small changes on VBUS */
+static void uvp_act_arm_hyst(uint8_t port)
+{
+    const uvov_profile_t *profile = uvov_port[port].profile;
+
+    port_log(port, "UVP Fault detected.\r\n");
+    enable_uvp_level(&USBPD_context[port], profile->uvp_hyst_volt, profile->uv_hyst);
+    led_update();
+}
+
+/* Undervoltage cleared: enable the UVP interrupt at the default threshold */
+static void uvp_act_arm_trip(uint8_t port)
+{
+    const uvov_profile_t *profile = uvov_port[port].profile;
+
+    enable_uvp_level(&USBPD_context[port], profile->volt, profile->uv_trip);
+}
+
+/* No undervoltage after re-arming */
+static void uvp_act_normal(uint8_t port)
+{
+    fet_ctrl_normal(port);
+    flight_rec_end(port, FAULT_TYPE_UVP);
+    port_log(port, "No undervoltage detected.\r\n");
+    led_update();
+}
+
+/* OVP channel action handlers indexed by fault_fsm_action_t */
+static const fault_fsm_handler_t ovp_fsm_handlers[FAULT_FSM_ACT_COUNT] =
+{
+    [FAULT_FSM_ACT_NONE]     = fault_act_none,
+    [FAULT_FSM_ACT_ARM_HYST] = ovp_act_arm_hyst,
+    [FAULT_FSM_ACT_ARM_TRIP] = ovp_act_arm_trip,
+    [FAULT_FSM_ACT_NORMAL]   = ovp_act_normal,
+};
+
+/* UVP channel action handlers indexed by fault_fsm_action_t */
+static const fault_fsm_handler_t uvp_fsm_handlers[FAULT_FSM_ACT_COUNT] =
+{
+    [FAULT_FSM_ACT_NONE]     = fault_act_none,
+    [FAULT_FSM_ACT_ARM_HYST] = uvp_act_arm_hyst,
+    [FAULT_FSM_ACT_ARM_TRIP] = uvp_act_arm_trip,
+    [FAULT_FSM_ACT_NORMAL]   = uvp_act_normal,
+};
+
+/*******************************************************************************
+* Function Name: fet_report
+********************************************************************************
+* Summary:
+*  Prints how the provider FET was turned off for a trip. The turn-off time is
+*  only measured in software mode, from the interrupt entry to the FET
+*  turn-off. In hardware mode the UVOV block turns the FET off at the trip,
+*  before the interrupt is raised, and no time is recorded. The comparator
+*  filter delay comes on top in both modes.
+*
+* Parameters:
+*  evt - fault event of the trip
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fet_report(const fault_event_t *evt)
+{
+#if DEBUG_PRINT
+    /* The dV/dt predictor turns the FET off on its own */
+    if ((evt->flags & FAULT_EVENT_FLAG_PREDICTED) != 0u)
+    {
+        return;
+    }
+    if (fet_ctrl_auto(&USBPD_context[evt->port]))
+    {
+        port_log(evt->port, "FET off by hardware at the trip, time not measured\r\n");
+    }
+    else
+    {
+        port_log(evt->port, "FET off by software ");
+        uart_log_dec(app_timer_cycles_to_us(evt->fet_off_cycles));
+        uart_log_puts(" us after the interrupt\r\n");
+    }
+#else
+    (void)evt;
+#endif /* DEBUG_PRINT */
+}
+
+/*******************************************************************************
+* Function Name: storm_report
+********************************************************************************
+* Summary:
+*  Reports a storm entry or exit of a fault channel.
+*
+* Parameters:
+*  port - USBPD port
+*  type - fault type
+*  change - storm state change
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void storm_report(uint8_t port, fault_type_t type, fault_storm_change_t change)
+{
+    if (change == FAULT_STORM_ENTER)
+    {
+        port_log(port, (type == FAULT_TYPE_OVP) ? "OVP fault storm, re-arm backoff.\r\n" :
+                                                  "UVP fault storm, re-arm backoff.\r\n");
+    }
+    else if (change == FAULT_STORM_EXIT)
+    {
+        port_log(port, (type == FAULT_TYPE_OVP) ? "OVP fault storm cleared.\r\n" :
+                                                  "UVP fault storm cleared.\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: storm_event
+********************************************************************************
+* Summary:
+*  Maps the polled state of a channel to a fault channel event. While a storm
+*  backoff is pending the channel is held in its faulted state so that the trip
+*  comparator is not re-armed yet.
+*
+* Parameters:
+*  storm - channel storm detector
+*  fault - true when the fault is still present
+*  now - current time in ms
+*
+* Return:
+*  fault_fsm_event_t
+*
+*******************************************************************************/
+static fault_fsm_event_t storm_event(const fault_storm_t *storm, bool fault, uint32_t now)
+{
+    return (fault || fault_storm_hold(storm, now)) ? FAULT_FSM_EVT_FAULT : FAULT_FSM_EVT_CLEAR;
+}
+
+/*******************************************************************************
+* Function Name: fault_poll_task
+********************************************************************************
+* Summary:
+*  Scheduler task run every tick while a fault channel of any port is not
+*  NORMAL or in a fault storm. All channels of all ports are advanced
+*  independently from the current VBUS status of their port.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fault_poll_task(void)
+{
+    uint32_t now = app_timer_get_ms();
+    bool idle = true;
+    vbus_state_t state;
+    uvov_port_t *p;
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        p = &uvov_port[port];
+        state = vbus_status(&USBPD_context[port]);
+
+        fault_fsm_step(&p->ovp_fsm, storm_event(&p->ovp_storm, (state == VBUS_OVERVOLTAGE), now));
+        fault_fsm_step(&p->uvp_fsm, storm_event(&p->uvp_storm, (state == VBUS_UNDERVOLTAGE), now));
+
+        storm_report(port, FAULT_TYPE_OVP, fault_storm_update(&p->ovp_storm, now));
+        storm_report(port, FAULT_TYPE_UVP, fault_storm_update(&p->uvp_storm, now));
+
+        idle = idle && uvov_port_idle(p);
+    }
+
+    if (idle)
+    {
+        sched_stop(SCHED_TASK_FAULT_POLL);
+#if VBUS_ADC_ENABLE
+        sched_stop(SCHED_TASK_VBUS_ADC);
+        vbus_adc_stop();
+#endif /* VBUS_ADC_ENABLE */
+    }
+}
+
+/*******************************************************************************
+* Function Name: dropped_check
+********************************************************************************
+* Summary:
+*  Re-arms the NORMAL fault channels of a port that lost events. The driver
+*  masks the comparator interrupt before the callback runs, so a trip whose
+*  event was dropped would leave its channel NORMAL with the interrupt masked
+*  for good. Once the ring of the port has been drained, the trip thresholds
+*  are armed again; a fault that is still present trips again right away.
+*
+* Parameters:
+*  port - USBPD port
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void dropped_check(uint8_t port)
+{
+    uvov_port_t *p = &uvov_port[port];
+    uint32_t dropped = fault_event_get_stats()->port_dropped[port];
+
+    if ((dropped == p->dropped_seen) || fault_event_port_pending(port))
+    {
+        return;
+    }
+    p->dropped_seen = dropped;
+
+    if (fault_fsm_is_normal(&p->ovp_fsm))
+    {
+        ovp_act_arm_trip(port);
+    }
+    if (fault_fsm_is_normal(&p->uvp_fsm))
+    {
+        uvp_act_arm_trip(port);
+    }
+}
+
+#if VBUS_DVDT_ENABLE
+/*******************************************************************************
+* Function Name: dvdt_task
+********************************************************************************
+* Summary:
+*  Scheduler task sampling VBUS of every port for the dV/dt predictor while the
+*  OVP channel of the port is NORMAL. When an overvoltage is predicted, the
+*  provider FET is turned off and an OVP event is queued as if the comparator
+*  had tripped. The event is queued with interrupts disabled to keep a single
+*  producer on the ring. The FET is turned on again once the OVP channel is
+*  back to NORMAL, see ovp_act_normal(). The slope is projected from the top
+*  of the ADC step of each sample, the highest VBUS the sample allows.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void dvdt_task(void)
+{
+    uint8_t intr_state;
+    uvov_port_t *p;
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        p = &uvov_port[port];
+        if (!fault_fsm_is_normal(&p->ovp_fsm))
+        {
+            vbus_dvdt_reset(&p->dvdt);
+            continue;
+        }
+
+        if (vbus_dvdt_update(&p->dvdt, vbus_adc_measure(&USBPD_context[port]) + vbus_adc_step_mv()))
+        {
+            intr_state = Cy_SysLib_EnterCriticalSection();
+            Cy_USBPD_Vbus_GdrvPfetOff(&USBPD_context[port], false);
+            p->dvdt_fet_off = true;
+            fault_raise(&USBPD_context[port], FAULT_TYPE_OVP, true, FAULT_EVENT_FLAG_PREDICTED, 0u);
+            Cy_SysLib_ExitCriticalSection(intr_state);
+            vbus_dvdt_reset(&p->dvdt);
+        }
+    }
+}
+#endif /* VBUS_DVDT_ENABLE */
+
+#if VBUS_LADDER_TASK
+/*******************************************************************************
+* Function Name: ladder_task
+********************************************************************************
+* Summary:
+*  Scheduler task estimating VBUS with the UV comparator ladder. Every
+*  VBUS_LADDER_PERIOD_MS it starts an estimate on each port whose fault
+*  channels are idle, then runs one probe per tick until all estimates are
+*  done, with the fault handling running in between. An estimate is dropped
+*  when its port starts handling a fault. The UV threshold in force is
+*  restored after every probe.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ladder_task(void)
+{
+    vbus_ladder_result_t result;
+    bool searching = false;
+    bool active = false;
+    uvov_port_t *p;
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        searching = searching || vbus_ladder_active(&uvov_port[port].ladder);
+    }
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        p = &uvov_port[port];
+        if (!uvov_port_idle(p))
+        {
+            vbus_ladder_stop(&p->ladder);
+        }
+        else if (!searching)
+        {
+            vbus_ladder_start(&p->ladder);
+        }
+        else if (vbus_ladder_active(&p->ladder) &&
+                vbus_ladder_step(&p->ladder, &USBPD_context[port], PROVIDER_FET_CTRL, &result))
+        {
+#if DEBUG_PRINT
+            port_log(port, "VBUS >= ");
+            uart_log_dec(result.mv);
+            uart_log_puts(" mV, UV protection suspended ");
+            uart_log_dec(result.suspended_us);
+            uart_log_puts(" us per probe\r\n");
+#endif /* DEBUG_PRINT */
+        }
+        active = active || vbus_ladder_active(&p->ladder);
+    }
+
+    /* One probe per tick while an estimate runs, then wait for the next period */
+    if (active != searching)
+    {
+        sched_start(SCHED_TASK_VBUS_LADDER, active ? APP_TIMER_TICK_MS : VBUS_LADDER_PERIOD_MS, ladder_task);
+    }
+}
+#endif /* VBUS_LADDER_TASK */
+
+#if TELEMETRY_ENABLE
+/*******************************************************************************
+* Function Name: telemetry_task
+********************************************************************************
+* Summary:
+*  Sends a STATUS frame for every port and the COUNTERS frame.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void telemetry_task(void)
+{
+    uint8_t port;
+
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        telemetry_send_status(port, (uint8_t)vbus_status(&USBPD_context[port]),
+                uvov_port[port].ovp_volt_in_force, uvov_port[port].uvp_volt_in_force,
+                (uint8_t)uvov_port[port].ovp_fsm.state, (uint8_t)uvov_port[port].uvp_fsm.state);
+    }
+    telemetry_send_counters();
+#if ISR_INSTR_ENABLE
+    telemetry_send_isr();
+#endif /* ISR_INSTR_ENABLE */
+}
+#endif /* TELEMETRY_ENABLE */
+
+/*******************************************************************************
+* Function Name: usbpd_port_init
+********************************************************************************
+* Summary:
+*  Configures the interrupt and initializes the USBPD driver of a port.
+*
+* Parameters:
+*  port - USBPD port
+*  intr_config - interrupt configuration of the port
+*  isr - interrupt handler of the port
+*  base - USBPD block of the port
+*  trim - trim registers of the port, NULL on PMG1-S2
+*  config - USBPD configuration of the port
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void usbpd_port_init(uint8_t port, const cy_stc_sysint_t *intr_config, cy_israddress isr,
+        void *base, void *trim, const cy_stc_usbpd_config_t *config)
+{
+    cy_en_usbpd_status_t usbpd_result;
+    cy_en_sysint_status_t sysint_result;
+
+    /* To set data field in USBPD context structure to NULL.
+     * Required for uninterrupted USBPD driver initialization */
+    memset((void *)&USBPD_context[port], 0, sizeof (cy_stc_usbpd_context_t));
+
+    /* Configure and enable the USBPD interrupts */
+    sysint_result = Cy_SysInt_Init(intr_config, isr);
+    /* System Interrupt init failed. Stop program execution */
+    if (sysint_result != CY_SYSINT_SUCCESS)
+    {
+#if DEBUG_PRINT
+        check_status("API Cy_SysInt_Init failed with error code", sysint_result);
+#endif
+        CY_ASSERT(CY_ASSERT_FAILED);
+    }
+    NVIC_EnableIRQ(intr_config->intrSrc);
+
+#if UART_SHELL_TASK
+    /* Run the driver from a RAM copy of the settings so the shell can change them */
+    shell_config[port] = *config;
+    shell_ovp_config[port] = *config->vbusOvpConfig;
+    shell_uvp_config[port] = *config->vbusUvpConfig;
+    shell_config[port].vbusOvpConfig = &shell_ovp_config[port];
+    shell_config[port].vbusUvpConfig = &shell_uvp_config[port];
+    config = &shell_config[port];
+#endif /* UART_SHELL_TASK */
+
+    /* Initialize the USBPD driver */
+    usbpd_result = Cy_USBPD_Init(&USBPD_context[port], port, base, trim,
+            (cy_stc_usbpd_config_t *)config, get_dpm_connect_stat);
+
+    /* USBPD driver init failed. Stop program execution */
+    if (usbpd_result != CY_USBPD_STAT_SUCCESS)
+    {
+#if DEBUG_PRINT
+        check_status("API Cy_USBPD_Init failed with error code", usbpd_result);
+#endif
+        CY_ASSERT(CY_ASSERT_FAILED);
+    }
+}
+
+/*******************************************************************************
+* Function Name: vbus_set_contract
+********************************************************************************
+* Summary:
+*  Selects the protection profile of a contract voltage and arms the trip
+*  thresholds of a port. Cached profiles are used as they are; a voltage off
+*  the cached grid, e.g. an odd PPS voltage, is computed here once. Called at
+*  start and on every new contract while the fault channels are NORMAL.
+*
+* Parameters:
+*  port - USBPD port
+*  volt - contract voltage in mV
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_set_contract(uint8_t port, uint16_t volt)
+{
+    cy_stc_usbpd_context_t *context = &USBPD_context[port];
+    uvov_port_t *p = &uvov_port[port];
+    const uvov_profile_t *profile = uvov_profile_get(port, volt);
+
+    if (profile == NULL)
+    {
+        uvov_profile_calc(context, volt, p->hyst_ovp_steps, p->hyst_uvp_steps, &p->contract);
+        profile = &p->contract;
+    }
+    p->profile = profile;
+#if VBUS_DVDT_ENABLE
+    /* Project the VBUS slope to the OV trip level of the new thresholds */
+    vbus_dvdt_init(&p->dvdt, profile->ov_trip_volt);
+#endif /* VBUS_DVDT_ENABLE */
+
+    /* If both the USBPD UVP and OVP features are enabled, arm both comparators
+     * together. Otherwise enable and configure the block that is enabled.
+     */
+    cy_stc_fault_vbus_uvp_cfg_t * uvp_config = (cy_stc_fault_vbus_uvp_cfg_t *) context->usbpdConfig->vbusUvpConfig;
+    cy_stc_fault_vbus_ovp_cfg_t * ovp_config = (cy_stc_fault_vbus_ovp_cfg_t *) context->usbpdConfig->vbusOvpConfig;
+    if (uvp_config->enable && ovp_config->enable)
+    {
+        vbus_set_profile(context, profile);
+    }
+    else if (uvp_config->enable)
+    {
+        enable_uvp_level(context, profile->volt, profile->uv_trip);
+    }
+    else if (ovp_config->enable)
+    {
+        enable_ovp(context, profile->ovp_volt);
+    }
+}
 
-    /* To set data field in USBPD context structure to NULL.
-     * Required for uninterrupted USBPD driver initialization */
-    memset((void *)&USBPD_context, 0, sizeof (cy_stc_usbpd_context_t));
+/*******************************************************************************
+* Function Name: uvov_port_start
+********************************************************************************
+* Summary:
+*  Computes the thresholds of a port and arms its UVP and OVP comparators.
+*
+* Parameters:
+*  port - USBPD port
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uvov_port_start(uint8_t port)
+{
+    uvov_port_t *p = &uvov_port[port];
 
-    /* Configure and enable the USBPD interrupts */
-    sysint_result = Cy_SysInt_Init(&usbpd_port0_intr1_config, &cy_usbpd0_intr1_handler);
-    /* System Interrupt init failed. Stop program execution */
-    if (sysint_result != CY_SYSINT_SUCCESS)
+    p->ovp_volt_in_force = THRESHOLD_VOLT;
+    p->uvp_volt_in_force = THRESHOLD_VOLT;
+    p->hyst_ovp_steps = HYST_OVP_STEPS;
+    p->hyst_uvp_steps = HYST_UVP_STEPS;
+
+    /* Both fault channels start in the NORMAL state */
+    fault_fsm_init(&p->ovp_fsm, port, ovp_fsm_handlers);
+    fault_fsm_init(&p->uvp_fsm, port, uvp_fsm_handlers);
+
+    /* The profile cache is built after all ports are armed, so the thresholds
+     * of the first contract are computed directly.
+     */
+    vbus_set_contract(port, THRESHOLD_VOLT);
+}
+
+#if UART_SHELL_TASK
+/*******************************************************************************
+* Function Name: shell_port_get
+********************************************************************************
+* Summary:
+*  Parses the port argument of a shell command.
+*
+* Parameters:
+*  arg - port argument
+*  port - parsed USBPD port
+*
+* Return:
+*  bool - false if the argument is not a port of this device
+*
+*******************************************************************************/
+static bool shell_port_get(const char *arg, uint8_t *port)
+{
+    uint16_t value;
+
+    if (!uart_shell_parse_u16(arg, &value) || (value >= UVOV_PORT_COUNT))
     {
-#if DEBUG_PRINT
-        check_status("API Cy_SysInt_Init failed with error code", sysint_result);
-#endif
-        CY_ASSERT(CY_ASSERT_FAILED);
+        return false;
     }
-    NVIC_EnableIRQ(usbpd_port0_intr1_config.intrSrc);
+    *port = (uint8_t)value;
+    return true;
+}
 
-    /* Initialize the USBPD driver */
-#if defined(CY_DEVICE_SERIES_PMG1S2)
-    usbpd_result = Cy_USBPD_Init(&USBPD_context, 0, mtb_usbpd_port0_HW, NULL,
-            (cy_stc_usbpd_config_t *)&mtb_usbpd_port0_config, get_dpm_connect_stat);
-#else
-    usbpd_result = Cy_USBPD_Init(&USBPD_context, 0, mtb_usbpd_port0_HW, mtb_usbpd_port0_HW_TRIM,
-            (cy_stc_usbpd_config_t *)&mtb_usbpd_port0_config, get_dpm_connect_stat);
-#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+/*******************************************************************************
+* Function Name: shell_print
+********************************************************************************
+* Summary:
+*  Prints a labelled decimal value.
+*
+* Parameters:
+*  label - label printed before the value
+*  value - value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_print(const char *label, uint32_t value)
+{
+    uart_shell_puts(label);
+    uart_shell_dec(value);
+}
 
-    /* USBPD driver init failed. Stop program execution */
-    if (usbpd_result != CY_USBPD_STAT_SUCCESS)
+/*******************************************************************************
+* Function Name: shell_cmd_get
+********************************************************************************
+* Summary:
+*  Shell command printing the protection settings and state of one port or of
+*  all ports: get [port]
+*
+* Parameters:
+*  argc - number of arguments
+*  argv - arguments
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_cmd_get(uint8_t argc, char *argv[])
+{
+    uint8_t first = 0;
+    uint8_t last = UVOV_PORT_COUNT - 1u;
+    uint8_t port;
+    const uvov_port_t *p;
+
+    if (argc > 1u)
     {
-#if DEBUG_PRINT
-        check_status("API Cy_USBPD_Init failed with error code", usbpd_result);
-#endif
+        if (!shell_port_get(argv[1], &first))
+        {
+            uart_shell_error("port");
+            return;
+        }
+        last = first;
+    }
+
+    for (port = first; port <= last; port++)
+    {
+        p = &uvov_port[port];
+        shell_print("P", port);
+        shell_print(" volt=", p->profile->volt);
+        shell_print(" ovp=", shell_ovp_config[port].threshold);
+        shell_print("/", shell_ovp_config[port].debounce);
+        shell_print(" uvp=", shell_uvp_config[port].threshold);
+        shell_print("/", shell_uvp_config[port].debounce);
+        shell_print(" hyst=", p->hyst_ovp_steps);
+        shell_print("/", p->hyst_uvp_steps);
+        shell_print(" armed=", p->ovp_volt_in_force);
+        shell_print("/", p->uvp_volt_in_force);
+        shell_print(" state=", (uint32_t)p->ovp_fsm.state);
+        shell_print("/", (uint32_t)p->uvp_fsm.state);
+        uart_shell_puts("\r\n");
+    }
+    uart_shell_ok();
+}
+
+/*******************************************************************************
+* Function Name: shell_cmd_set
+********************************************************************************
+* Summary:
+*  Shell command changing the protection settings of a port:
+*   set <port> volt <mV>
+*   set <port> ovp <percent> <debounce>
+*   set <port> uvp <percent> <debounce>
+*   set <port> hyst <ovp_steps> <uvp_steps>
+*  Changes are only accepted while both fault channels of the port are NORMAL.
+*  The new thresholds are computed first and then armed together through
+*  vbus_set_contract(), so the comparators never run with a partial change;
+*  the dV/dt predictor is moved to the new OV trip level there as well.
+*
+* Parameters:
+*  argc - number of arguments
+*  argv - arguments
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_cmd_set(uint8_t argc, char *argv[])
+{
+    uint8_t port;
+    uint16_t arg1;
+    uint16_t arg2 = 0;
+    uvov_port_t *p;
+
+    if ((argc < 4u) || !shell_port_get(argv[1], &port) || !uart_shell_parse_u16(argv[3], &arg1) ||
+            ((argc > 4u) && !uart_shell_parse_u16(argv[4], &arg2)))
+    {
+        uart_shell_error("args");
+        return;
+    }
+    p = &uvov_port[port];
+    if (!uvov_port_idle(p))
+    {
+        uart_shell_error("busy");
+        return;
+    }
+
+    if (strcmp(argv[2], "volt") == 0)
+    {
+        if ((arg1 < UVOV_PROFILE_MIN_MV) || (arg1 > UVOV_PROFILE_MAX_MV))
+        {
+            uart_shell_error("range");
+            return;
+        }
+        vbus_set_contract(port, arg1);
+        uart_shell_ok();
+        return;
+    }
+
+    if (argc != 5u)
+    {
+        uart_shell_error("args");
+        return;
+    }
+    if (strcmp(argv[2], "ovp") == 0)
+    {
+        if ((arg1 == 0u) || (arg1 > 50u) || (arg2 > UINT8_MAX))
+        {
+            uart_shell_error("range");
+            return;
+        }
+        shell_ovp_config[port].threshold = (uint8_t)arg1;
+        shell_ovp_config[port].debounce = (uint8_t)arg2;
+    }
+    else if (strcmp(argv[2], "uvp") == 0)
+    {
+        if ((arg1 < 50u) || (arg1 > 99u) || (arg2 > UINT8_MAX))
+        {
+            uart_shell_error("range");
+            return;
+        }
+        shell_uvp_config[port].threshold = (uint8_t)arg1;
+        shell_uvp_config[port].debounce = (uint8_t)arg2;
+    }
+    else if (strcmp(argv[2], "hyst") == 0)
+    {
+        if ((arg1 == 0u) || (arg1 > HYST_MAX_STEPS) || (arg2 == 0u) || (arg2 > HYST_MAX_STEPS))
+        {
+            uart_shell_error("range");
+            return;
+        }
+        p->hyst_ovp_steps = (uint8_t)arg1;
+        p->hyst_uvp_steps = (uint8_t)arg2;
+    }
+    else
+    {
+        uart_shell_error("item");
+        return;
+    }
+
+    /* The cached profiles depend on all of these settings */
+    uvov_profile_build(&USBPD_context[port], p->hyst_ovp_steps, p->hyst_uvp_steps);
+    vbus_set_contract(port, p->profile->volt);
+    uart_shell_ok();
+}
+
+/*******************************************************************************
+* Function Name: shell_cmd_stats
+********************************************************************************
+* Summary:
+*  Shell command printing the fault counters and the fault storm state of
+*  every port: stats
+*
+* Parameters:
+*  argc - number of arguments
+*  argv - arguments
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_cmd_stats(uint8_t argc, char *argv[])
+{
+    const fault_event_stats_t *stats = fault_event_get_stats();
+    uint8_t port;
+
+    (void)argc;
+    (void)argv;
+
+    shell_print("ovp=", stats->count[FAULT_TYPE_OVP]);
+    shell_print(" uvp=", stats->count[FAULT_TYPE_UVP]);
+    shell_print(" dropped=", stats->dropped);
+    shell_print(" uart_overflow=", uart_log_get_overflow());
+    uart_shell_puts("\r\n");
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        shell_print("P", port);
+        shell_print(" storm=", fault_storm_active(&uvov_port[port].ovp_storm) ? 1u : 0u);
+        shell_print("/", fault_storm_active(&uvov_port[port].uvp_storm) ? 1u : 0u);
+        shell_print(" dropped=", stats->port_dropped[port]);
+        uart_shell_puts("\r\n");
+    }
+    uart_shell_ok();
+}
+
+#if ISR_INSTR_ENABLE
+/*******************************************************************************
+* Function Name: shell_print_isr_stat
+********************************************************************************
+* Summary:
+*  Prints an interrupt timing record: sample count, min/max/mean in CPU
+*  cycles and the histogram bins.
+*
+* Parameters:
+*  label - name of the record
+*  stat - statistics record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_print_isr_stat(const char *label, const isr_instr_stat_t *stat)
+{
+    isr_instr_stat_t copy;
+    uint8_t bin;
+
+    isr_instr_copy(&copy, stat);
+
+    uart_shell_puts(label);
+    shell_print(" n=", copy.count);
+    shell_print(" min=", copy.min);
+    shell_print(" max=", copy.max);
+    shell_print(" mean=", isr_instr_mean(&copy));
+    shell_print(" hist=", copy.hist[0]);
+    for (bin = 1; bin < ISR_INSTR_HIST_BINS; bin++)
+    {
+        shell_print(",", copy.hist[bin]);
+    }
+    uart_shell_puts("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: shell_cmd_isr
+********************************************************************************
+* Summary:
+*  Shell command printing the USBPD interrupt timing statistics per fault
+*  source, in CPU cycles: isr
+*
+* Parameters:
+*  argc - number of arguments
+*  argv - arguments
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_cmd_isr(uint8_t argc, char *argv[])
+{
+    const isr_instr_t *instr = isr_instr_get();
+
+    (void)argc;
+    (void)argv;
+
+    shell_print_isr_stat("ovp dispatch", &instr->dispatch[FAULT_TYPE_OVP]);
+    shell_print_isr_stat("ovp duration", &instr->duration[FAULT_TYPE_OVP]);
+    shell_print_isr_stat("uvp dispatch", &instr->dispatch[FAULT_TYPE_UVP]);
+    shell_print_isr_stat("uvp duration", &instr->duration[FAULT_TYPE_UVP]);
+    uart_shell_ok();
+}
+#endif /* ISR_INSTR_ENABLE */
+
+/* Commands of the UART shell */
+static const uart_shell_cmd_t shell_cmds[] =
+{
+    { "get",   "[port]",                                                     shell_cmd_get   },
+    { "set",   "<port> volt|ovp|uvp|hyst <mV|percent|steps> [debounce|steps]", shell_cmd_set   },
+    { "stats", "",                                                           shell_cmd_stats },
+#if ISR_INSTR_ENABLE
+    { "isr",   "",                                                           shell_cmd_isr   },
+#endif /* ISR_INSTR_ENABLE */
+};
+#endif /* UART_SHELL_TASK */
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  System entrance point. This function performs
+*  - initial setup of device
+*  - USBPD driver initialization 
+*  - enables the UVP and OVP blocks
+*  - prints UVP and OVP detection message to UART when applicable
+*  - runs the fault indication and recovery tasks from the scheduler
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    cy_rslt_t result;
+    fault_event_t evt[FAULT_EVENT_BATCH];
+    uint8_t evt_count;
+    uint8_t idx;
+    uint8_t port;
+    uvov_port_t *p;
+    bool idle;
+    uint32_t armed_us;
+
+    /* Initialize the device and board peripherals */
+    result = cybsp_init();
+
+    /* Board initialization failed. Stop program execution */
+    if(result != CY_RSLT_SUCCESS)
+    {
+        /* Insert error handler here */
         CY_ASSERT(CY_ASSERT_FAILED);
     }
 
-    /* If the USBPD UVP feature is enabled, enable and configure the UVP block */
-    cy_stc_fault_vbus_uvp_cfg_t * uvp_config = (cy_stc_fault_vbus_uvp_cfg_t *) USBPD_context.usbpdConfig->vbusUvpConfig;
-    if (uvp_config->enable)
+    /* Start the time base used to timestamp fault events */
+    app_timer_init();
+
+    /* Pick up the fault history left by the previous run */
+    flight_rec_init();
+
+    /* Enable global interrupts */
+    __enable_irq();
+
+    /* Prepare the UV/OV interrupt dispatch */
+    uvov_hal_irq_init();
+
+    /* Initialize the USBPD driver of every port */
+    usbpd_port_init(0u, &usbpd_port0_intr1_config, &cy_usbpd0_intr1_handler, mtb_usbpd_port0_HW,
+            UVOV_HAL_PORT0_TRIM, &mtb_usbpd_port0_config);
+#if (UVOV_PORT_COUNT > 1u)
+    usbpd_port_init(1u, &usbpd_port1_intr1_config, &cy_usbpd1_intr1_handler, mtb_usbpd_port1_HW,
+            mtb_usbpd_port1_HW_TRIM, &mtb_usbpd_port1_config);
+#endif /* (UVOV_PORT_COUNT > 1u) */
+
+    /* Arm the UV/OV comparators before anything that is not needed for the
+     * protection, and record how long the outputs were unprotected.
+     */
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        uvov_port_start(port);
+    }
+    armed_us = app_timer_get_us();
+    flight_rec_armed(armed_us);
+
+#if UART_ENABLE
+    uart_init();
+#endif /* UART_ENABLE */
+
+    /* Precompute the protection profiles of the other contract voltages */
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
+    {
+        uvov_profile_build(&USBPD_context[port], uvov_port[port].hyst_ovp_steps, uvov_port[port].hyst_uvp_steps);
+    }
+
+#if DEBUG_PRINT
+    /* Sequence to clear screen */
+    uart_log_puts("\x1b[2J\x1b[;H");
+
+    /* Print "Program Start" */
+    uart_log_puts("****************** ");
+    uart_log_puts("PMG1 MCU: Using UVOV Blocks ");
+    uart_log_puts("****************** \r\n\n");
+
+    uart_log_puts("Protection armed in ");
+    uart_log_dec(armed_us);
+    uart_log_puts(" us\r\n");
+#endif /* DEBUG_PRINT */
+
+#if LOW_POWER_MODE
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
     {
-        enable_uvp(&USBPD_context, THRESHOLD_VOLT);
+        /* Prepare the USBPD block for deep sleep entry and exit */
+        low_power_init(&USBPD_context[port]);
     }
 
-    /* If the USBPD OVP feature is enabled, enable and configure the OVP block */
-    cy_stc_fault_vbus_ovp_cfg_t * ovp_config = (cy_stc_fault_vbus_ovp_cfg_t *) USBPD_context.usbpdConfig->vbusOvpConfig;
-    if (ovp_config->enable)
+    /* Keep the application timer running through deep sleep */
+    low_power_timebase_init();
+#endif /* LOW_POWER_MODE */
+
+#if VBUS_DVDT_ENABLE
+    /* Prepare the ADC of every port for the dV/dt predictor */
+    for (port = 0; port < UVOV_PORT_COUNT; port++)
     {
-        enable_ovp(&USBPD_context, THRESHOLD_VOLT);
+        vbus_adc_init(&USBPD_context[port]);
     }
+    sched_start(SCHED_TASK_DVDT, VBUS_DVDT_PERIOD_MS, dvdt_task);
+#elif VBUS_ADC_ENABLE
+    /* Prepare the ADC used to measure VBUS on port 0 */
+    vbus_adc_init(&USBPD_context[0]);
+#endif /* VBUS_DVDT_ENABLE */
+
+#if VBUS_LADDER_TASK
+    /* Estimate VBUS periodically without the ADC */
+    sched_start(SCHED_TASK_VBUS_LADDER, VBUS_LADDER_PERIOD_MS, ladder_task);
+#endif /* VBUS_LADDER_TASK */
+
+#if (TELEMETRY_ENABLE && !LOW_POWER_MODE)
+    /* Send the comparator state and counters periodically */
+    sched_start(SCHED_TASK_TELEMETRY, TELEMETRY_PERIOD_MS, telemetry_task);
+#endif /* (TELEMETRY_ENABLE && !LOW_POWER_MODE) */
+
+#if UART_SHELL_TASK
+    /* Accept protection settings over the UART */
+    uart_shell_init(shell_cmds, (uint8_t)(sizeof(shell_cmds) / sizeof(shell_cmds[0])));
+#if TELEMETRY_ENABLE
+    /* Keep the telemetry stream decodable, the replies are sent as TEXT frames */
+    uart_shell_set_output(telemetry_send_text);
+#endif /* TELEMETRY_ENABLE */
+    sched_start(SCHED_TASK_SHELL, UART_SHELL_PERIOD_MS, uart_shell_task);
+#endif /* UART_SHELL_TASK */
 
     for(;;)
     {
-        /* Check if an OVP interrupt has occurred */
-        if(OVP_FLAG)
+        /* Drain the pending fault events in a batch and feed the trips to the
+         * fault channels. Events raised by the hysteresis threshold belong to a
+         * fault that is already being handled.
+         */
+        evt_count = fault_event_pop(evt, FAULT_EVENT_BATCH);
+        for (idx = 0; idx < evt_count; idx++)
         {
-#if DEBUG_PRINT
-            Cy_SCB_UART_PutString(CYBSP_UART_HW, "OVP Fault detected.\r\n");
-#endif
-            /* Set the OVP comparator using OVP hysteresis voltage to ignore small changes on VBUS */
-            enable_ovp(&USBPD_context, HYST_OVP_VOLT);
-            /* Toggle the LED 8 times per second while there is overvoltage on Vbus */
-            while(vbus_status(&USBPD_context) == VBUS_OVERVOLTAGE)
+            port = evt[idx].port;
+            p = &uvov_port[port];
+#if VBUS_ADC_ENABLE
+            /* Measure VBUS while the fault is handled. An event raised before
+             * the sampling started is reported with the first measurement.
+             */
+            if (port == 0u)
             {
-                /* Toggle the user LED state */
-                Cy_GPIO_Inv(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
-                /* Delay between LED toggles during Vbus overvoltage */
-                Cy_SysLib_Delay(125);
+                if (!sched_is_active(SCHED_TASK_VBUS_ADC))
+                {
+                    vbus_adc_start();
+                    sched_start(SCHED_TASK_VBUS_ADC, VBUS_ADC_PERIOD_MS, vbus_adc_task);
+                }
+                if (evt[idx].vbus == 0u)
+                {
+                    evt[idx].vbus = vbus_adc_get_mv();
+                }
             }
-            /* Clear the OVP Flag and enable the OVP interrupt */
-            OVP_FLAG = 0 ;
-            enable_ovp(&USBPD_context, THRESHOLD_VOLT);
-            /* Set User LED to ON (Vbus normal status) */
-            Cy_GPIO_Clr(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
-#if DEBUG_PRINT
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "No overvoltage detected.\r\n");
-#endif
-        }
-        /* Check if a UVP interrupt has occurred */
-        if(UVP_FLAG)
-        {
-#if DEBUG_PRINT
-            Cy_SCB_UART_PutString(CYBSP_UART_HW, "UVP Fault detected.\r\n");
-#endif
-            /* Set the UVP comparator using UVP hysteresis voltage to ignore small changes on VBUS */
-            enable_uvp(&USBPD_context, HYST_UVP_VOLT);
-            /* Toggle the LED once every second while there is undervoltage on Vbus */
-            while(vbus_status(&USBPD_context) == VBUS_UNDERVOLTAGE)
+#endif /* VBUS_ADC_ENABLE */
+#if TELEMETRY_ENABLE
+            telemetry_send_event(&evt[idx]);
+#endif /* TELEMETRY_ENABLE */
+            if (evt[idx].volt == fault_trip_volt_get(port, (fault_type_t)evt[idx].type))
             {
-                /* Toggle the user LED state */
-                Cy_GPIO_Inv(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
-                /* Delay between LED toggles during Vbus undervoltage */
-                Cy_SysLib_Delay(1000);
+                if (evt[idx].type == FAULT_TYPE_OVP)
+                {
+                    storm_report(port, FAULT_TYPE_OVP, fault_storm_trip(&p->ovp_storm, evt[idx].timestamp));
+                    fault_fsm_step(&p->ovp_fsm, FAULT_FSM_EVT_TRIP);
+                }
+                else
+                {
+                    storm_report(port, FAULT_TYPE_UVP, fault_storm_trip(&p->uvp_storm, evt[idx].timestamp));
+                    fault_fsm_step(&p->uvp_fsm, FAULT_FSM_EVT_TRIP);
+                }
+                fet_report(&evt[idx]);
             }
-            /* Clear the UVP Flag and enable the UVP interrupt */
-            UVP_FLAG = 0 ;
-            enable_uvp(&USBPD_context, THRESHOLD_VOLT);
-            /* Set User LED to ON (Vbus normal status) */
-            Cy_GPIO_Clr(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
-#if DEBUG_PRINT
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "No undervoltage detected.\r\n");
-#endif
         }
+
+        /* Recover the channels of the ports that lost events */
+        for (port = 0; port < UVOV_PORT_COUNT; port++)
+        {
+            dropped_check(port);
+        }
+
+#if (TELEMETRY_ENABLE && LOW_POWER_MODE)
+        /* No periodic frames in low power mode, report the state after each batch */
+        if (evt_count != 0u)
+        {
+            telemetry_task();
+        }
+#endif /* (TELEMETRY_ENABLE && LOW_POWER_MODE) */
+
+        /* Poll VBUS on every tick while a fault channel of any port is not
+         * NORMAL or in a storm
+         */
+        idle = true;
+        for (port = 0; port < UVOV_PORT_COUNT; port++)
+        {
+            idle = idle && uvov_port_idle(&uvov_port[port]);
+        }
+        if (!idle && !sched_is_active(SCHED_TASK_FAULT_POLL))
+        {
+            sched_start(SCHED_TASK_FAULT_POLL, FAULT_POLL_MS, fault_poll_task);
+        }
+
+        /* Run the LED and recovery tasks that are due */
+        sched_run();
+
+        /* Seal the fault records, and commit them to flash when enabled once
+         * no fault is being handled
+         */
+        flight_rec_service(idle && !fault_event_pending());
+
+#if LOW_POWER_MODE
+        /* Sleep until the next comparator event when no fault is active */
+#if UART_ENABLE
+        if (!sched_any_active() && !uart_log_pending())
+#else
+        if (!sched_any_active())
+#endif /* UART_ENABLE */
+        {
+            low_power_idle();
+        }
+#endif /* LOW_POWER_MODE */
 #if DEBUG_PRINT
         if (ENTER_LOOP)
         {
-            Cy_SCB_UART_PutString(CYBSP_UART_HW, "Entered for loop\r\n");
+            uart_log_puts("Entered for loop\r\n");
             ENTER_LOOP = false;
         }
 #endif
@@ -0,0 +1,190 @@
+/******************************************************************************
+* File Name: scheduler.c
+*
+* Description: This file contains a cooperative scheduler driven by the SysTick time
+*              base. Tasks are run from the main loop when their period has elapsed.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "scheduler.h"
+#include "app_timer.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Scheduler task slot */
+typedef struct
+{
+    sched_cb_t cb;                  /* Task callback, NULL when the slot is idle */
+    uint32_t period;                /* Task period in ms */
+    uint32_t due;                   /* Time in ms at which the task runs next */
+} sched_task_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Task table indexed by sched_task_id_t */
+static sched_task_t sched_tasks[SCHED_TASK_COUNT];
+
+/*******************************************************************************
+* Function Name: sched_start
+********************************************************************************
+* Summary:
+*  Starts (or restarts) a periodic task. The first run happens one period
+*  after this call.
+*
+* Parameters:
+*  id - task identifier
+*  period_ms - task period in ms, at least one scheduler tick
+*  cb - task callback
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sched_start(sched_task_id_t id, uint32_t period_ms, sched_cb_t cb)
+{
+    if (period_ms < APP_TIMER_TICK_MS)
+    {
+        period_ms = APP_TIMER_TICK_MS;
+    }
+
+    sched_tasks[id].period = period_ms;
+    sched_tasks[id].due = app_timer_get_ms() + period_ms;
+    sched_tasks[id].cb = cb;
+}
+
+/*******************************************************************************
+* Function Name: sched_stop
+********************************************************************************
+* Summary:
+*  Stops a task.
+*
+* Parameters:
+*  id - task identifier
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sched_stop(sched_task_id_t id)
+{
+    sched_tasks[id].cb = NULL;
+}
+
+/*******************************************************************************
+* Function Name: sched_is_active
+********************************************************************************
+* Summary:
+*  Returns whether a task is running.
+*
+* Parameters:
+*  id - task identifier
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool sched_is_active(sched_task_id_t id)
+{
+    return (sched_tasks[id].cb != NULL);
+}
+
+/*******************************************************************************
+* Function Name: sched_any_active
+********************************************************************************
+* Summary:
+*  Returns whether any task is running.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool sched_any_active(void)
+{
+    uint8_t id;
+
+    for (id = 0; id < (uint8_t)SCHED_TASK_COUNT; id++)
+    {
+        if (sched_tasks[id].cb != NULL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: sched_run
+********************************************************************************
+* Summary:
+*  Runs every task whose period has elapsed. Called from the main loop; a
+*  task that has fallen behind runs once and is rescheduled from now.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sched_run(void)
+{
+    uint32_t now = app_timer_get_ms();
+    sched_task_t *task;
+    sched_cb_t cb;
+    uint8_t id;
+
+    for (id = 0; id < (uint8_t)SCHED_TASK_COUNT; id++)
+    {
+        task = &sched_tasks[id];
+        cb = task->cb;
+        if ((cb != NULL) && ((int32_t)(now - task->due) >= 0))
+        {
+            task->due += task->period;
+            if ((int32_t)(now - task->due) >= 0)
+            {
+                task->due = now + task->period;
+            }
+            cb();
+        }
+    }
+}
+
+/* [] END OF FILE */
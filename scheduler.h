@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name: scheduler.h
+*
+* Description: This is the header file for the tick based cooperative scheduler of the
+*              PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Scheduler task identifiers */
+typedef enum
+{
+    SCHED_TASK_FAULT_POLL = 0,      /* Polls VBUS for fault recovery */
+    SCHED_TASK_LED,                 /* Drives the fault indication LED pattern */
+    SCHED_TASK_UVP_COMPLETE,        /* Completes a deferred UVP enable */
+    SCHED_TASK_TELEMETRY,           /* Sends the periodic telemetry frames */
+    SCHED_TASK_VBUS_ADC,            /* Samples VBUS with the ADC */
+    SCHED_TASK_DVDT,                /* Predicts overvoltage from the VBUS slope */
+    SCHED_TASK_VBUS_LADDER,         /* Estimates VBUS with the UV comparator ladder */
+    SCHED_TASK_SHELL,               /* Executes the UART shell commands */
+    SCHED_TASK_COUNT
+} sched_task_id_t;
+
+/* Scheduler task callback */
+typedef void (*sched_cb_t)(void);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void sched_start(sched_task_id_t id, uint32_t period_ms, sched_cb_t cb);
+
+void sched_stop(sched_task_id_t id);
+
+bool sched_is_active(sched_task_id_t id);
+
+bool sched_any_active(void);
+
+void sched_run(void);
+
+#endif /* _SCHEDULER_H_ */
+
+/* End of file [] */
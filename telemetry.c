@@ -0,0 +1,312 @@
+/******************************************************************************
+* File Name: telemetry.c
+*
+* Description: This file contains the framing of the binary telemetry stream. Frames are
+*              queued on the UART logger ring and never block the caller.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "telemetry.h"
+#include "app_timer.h"
+#include "uart_log.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sequence number of the next frame */
+static uint8_t telemetry_seq = 0;
+
+/*******************************************************************************
+* Function Name: telemetry_put_u16
+********************************************************************************
+* Summary:
+*  Stores a 16-bit value in little endian order.
+*
+* Parameters:
+*  buf - destination
+*  value - value to store
+*
+* Return:
+*  uint8_t * - position after the stored value
+*
+*******************************************************************************/
+static uint8_t *telemetry_put_u16(uint8_t *buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    return (buf + 2);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_put_u32
+********************************************************************************
+* Summary:
+*  Stores a 32-bit value in little endian order.
+*
+* Parameters:
+*  buf - destination
+*  value - value to store
+*
+* Return:
+*  uint8_t * - position after the stored value
+*
+*******************************************************************************/
+static uint8_t *telemetry_put_u32(uint8_t *buf, uint32_t value)
+{
+    buf = telemetry_put_u16(buf, (uint16_t)value);
+    return telemetry_put_u16(buf, (uint16_t)(value >> 16));
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send
+********************************************************************************
+* Summary:
+*  Frames a payload and queues it for transmission. Called from the main loop.
+*  The frame is queued as a whole, so a full UART ring never leaves a partial
+*  frame in the stream.
+*
+* Parameters:
+*  type - frame type
+*  payload - payload bytes
+*  len - payload length, at most TELEMETRY_MAX_PAYLOAD
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void telemetry_send(telemetry_frame_type_t type, const uint8_t *payload, uint8_t len)
+{
+    uint8_t frame[TELEMETRY_HDR_LEN + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_LEN];
+    uint16_t crc;
+
+    frame[0] = TELEMETRY_SOF;
+    frame[1] = len;
+    frame[2] = telemetry_seq++;
+    frame[3] = (uint8_t)type;
+    memcpy(&frame[TELEMETRY_HDR_LEN], payload, len);
+
+    crc = telemetry_crc16(TELEMETRY_CRC_INIT, &frame[1], (uint32_t)(TELEMETRY_HDR_LEN - 1u) + len);
+    (void)telemetry_put_u16(&frame[TELEMETRY_HDR_LEN + len], crc);
+
+    (void)uart_log_write_frame(frame, (uint32_t)(TELEMETRY_HDR_LEN + TELEMETRY_CRC_LEN) + len);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_event
+********************************************************************************
+* Summary:
+*  Sends an EVENT frame for a fault event.
+*
+* Parameters:
+*  evt - fault event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_event(const fault_event_t *evt)
+{
+    uint8_t payload[TELEMETRY_EVENT_LEN];
+    uint8_t *pos = payload;
+
+    pos = telemetry_put_u32(pos, evt->timestamp);
+    pos = telemetry_put_u16(pos, evt->volt);
+    *pos++ = evt->type;
+    *pos++ = evt->comp_out;
+    *pos++ = evt->code;
+    pos = telemetry_put_u16(pos, evt->vbus);
+    *pos++ = evt->flags;
+    *pos = evt->port;
+
+    telemetry_send(TELEMETRY_FRAME_EVENT, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_status
+********************************************************************************
+* Summary:
+*  Sends a STATUS frame.
+*
+* Parameters:
+*  port - USBPD port
+*  vbus - VBUS comparator status
+*  ovp_volt - voltage used to arm the OVP comparator
+*  uvp_volt - voltage used to arm the UVP comparator
+*  ovp_state - OVP channel state
+*  uvp_state - UVP channel state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_status(uint8_t port, uint8_t vbus, uint16_t ovp_volt, uint16_t uvp_volt,
+        uint8_t ovp_state, uint8_t uvp_state)
+{
+    uint8_t payload[TELEMETRY_STATUS_LEN];
+    uint8_t *pos = payload;
+
+    pos = telemetry_put_u32(pos, app_timer_get_ms());
+    *pos++ = vbus;
+    pos = telemetry_put_u16(pos, ovp_volt);
+    pos = telemetry_put_u16(pos, uvp_volt);
+    *pos++ = ovp_state;
+    *pos++ = uvp_state;
+    *pos = port;
+
+    telemetry_send(TELEMETRY_FRAME_STATUS, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_counters
+********************************************************************************
+* Summary:
+*  Sends a COUNTERS frame with the fault event and logger counters.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_counters(void)
+{
+    const fault_event_stats_t *stats = fault_event_get_stats();
+    uint8_t payload[TELEMETRY_COUNTERS_LEN];
+    uint8_t *pos = payload;
+
+    pos = telemetry_put_u32(pos, app_timer_get_ms());
+    pos = telemetry_put_u32(pos, stats->count[FAULT_TYPE_OVP]);
+    pos = telemetry_put_u32(pos, stats->count[FAULT_TYPE_UVP]);
+    pos = telemetry_put_u32(pos, stats->dropped);
+    (void)telemetry_put_u32(pos, uart_log_get_overflow());
+
+    telemetry_send(TELEMETRY_FRAME_COUNTERS, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_text
+********************************************************************************
+* Summary:
+*  Sends text as TEXT frames, so that the UART shell replies do not break the
+*  binary stream. Matches uart_shell_out_t.
+*
+* Parameters:
+*  text - text to send, not terminated
+*  len - number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_text(const uint8_t *text, uint8_t len)
+{
+    uint8_t chunk;
+
+    while (len != 0u)
+    {
+        chunk = (len < TELEMETRY_MAX_PAYLOAD) ? len : (uint8_t)TELEMETRY_MAX_PAYLOAD;
+        telemetry_send(TELEMETRY_FRAME_TEXT, text, chunk);
+        text += chunk;
+        len -= chunk;
+    }
+}
+
+#if ISR_INSTR_ENABLE
+/*******************************************************************************
+* Function Name: telemetry_send_isr_stat
+********************************************************************************
+* Summary:
+*  Sends an ISR frame for one interrupt timing record.
+*
+* Parameters:
+*  meas - measurement of the record
+*  type - fault type of the record
+*  stat - statistics record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void telemetry_send_isr_stat(telemetry_isr_meas_t meas, fault_type_t type, const isr_instr_stat_t *stat)
+{
+    uint8_t payload[TELEMETRY_ISR_LEN];
+    uint8_t *pos = payload;
+    isr_instr_stat_t copy;
+
+    isr_instr_copy(&copy, stat);
+
+    *pos++ = (uint8_t)meas;
+    *pos++ = (uint8_t)type;
+    pos = telemetry_put_u32(pos, copy.count);
+    pos = telemetry_put_u32(pos, copy.min);
+    pos = telemetry_put_u32(pos, copy.max);
+    (void)telemetry_put_u32(pos, isr_instr_mean(&copy));
+
+    telemetry_send(TELEMETRY_FRAME_ISR, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+* Function Name: telemetry_send_isr
+********************************************************************************
+* Summary:
+*  Sends the ISR frames of the interrupt timing statistics of every fault
+*  type that has been dispatched at least once.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_isr(void)
+{
+    const isr_instr_t *instr = isr_instr_get();
+    uint8_t type;
+
+    for (type = 0; type < (uint8_t)FAULT_TYPE_COUNT; type++)
+    {
+        if (instr->dispatch[type].count != 0u)
+        {
+            telemetry_send_isr_stat(TELEMETRY_ISR_DISPATCH, (fault_type_t)type, &instr->dispatch[type]);
+            telemetry_send_isr_stat(TELEMETRY_ISR_DURATION, (fault_type_t)type, &instr->duration[type]);
+        }
+    }
+}
+#endif /* ISR_INSTR_ENABLE */
+
+/* [] END OF FILE */
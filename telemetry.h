@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name: telemetry.h
+*
+* Description: This is the header file for the binary telemetry stream of the PMG1 MCU
+*              Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "fault_event.h"
+#include "isr_instr.h"
+#include "telemetry_frame.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Telemetry macro, can also be set through DEFINES in the Makefile */
+#ifndef TELEMETRY_ENABLE
+#define TELEMETRY_ENABLE            (0u)
+#endif
+
+/* Period in ms of the STATUS and COUNTERS frames */
+#define TELEMETRY_PERIOD_MS         (1000u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void telemetry_send_event(const fault_event_t *evt);
+
+void telemetry_send_status(uint8_t port, uint8_t vbus, uint16_t ovp_volt, uint16_t uvp_volt,
+        uint8_t ovp_state, uint8_t uvp_state);
+
+void telemetry_send_counters(void);
+
+void telemetry_send_text(const uint8_t *text, uint8_t len);
+
+#if ISR_INSTR_ENABLE
+void telemetry_send_isr(void);
+#endif /* ISR_INSTR_ENABLE */
+
+#endif /* _TELEMETRY_H_ */
+
+/* End of file [] */
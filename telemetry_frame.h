@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name: telemetry_frame.h
+*
+* Description: This is the header file defining the binary telemetry frame format of the
+*              PMG1 MCU Using UVOV Blocks Code Example. It has no device dependencies
+*              and is shared by the firmware and the host-side decoder.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _TELEMETRY_FRAME_H_
+#define _TELEMETRY_FRAME_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/*
+ * Frame layout, multi-byte fields are little endian:
+ *
+ *   offset 0      TELEMETRY_SOF
+ *   offset 1      payload length N
+ *   offset 2      sequence number, incremented for every frame
+ *   offset 3      frame type, see telemetry_frame_type_t
+ *   offset 4      N bytes of payload
+ *   offset 4+N    CRC-16/CCITT-FALSE over offsets 1 to 3+N
+ */
+#define TELEMETRY_SOF               (0xA5u)
+#define TELEMETRY_HDR_LEN           (4u)
+#define TELEMETRY_CRC_LEN           (2u)
+#define TELEMETRY_MAX_PAYLOAD       (32u)
+#define TELEMETRY_CRC_INIT          (0xFFFFu)
+#define TELEMETRY_CRC_POLY          (0x1021u)
+
+/* Frame types */
+typedef enum
+{
+    TELEMETRY_FRAME_EVENT    = 1,   /* Fault event */
+    TELEMETRY_FRAME_STATUS   = 2,   /* Comparator state and thresholds */
+    TELEMETRY_FRAME_COUNTERS = 3,   /* Periodic counters */
+    TELEMETRY_FRAME_ISR      = 4,   /* Interrupt timing statistics */
+    TELEMETRY_FRAME_TEXT     = 5    /* UART shell reply text */
+} telemetry_frame_type_t;
+
+/* Interrupt timing measurements of the ISR frame */
+typedef enum
+{
+    TELEMETRY_ISR_DISPATCH   = 0,   /* Interrupt entry to fault callback */
+    TELEMETRY_ISR_DURATION   = 1    /* Interrupt entry to exit */
+} telemetry_isr_meas_t;
+
+/*
+ * EVENT payload:
+ *   u32 timestamp (ms), u16 volt (mV), u8 fault type, u8 comparator output,
+ *   u8 threshold code, u16 VBUS measured by the ADC (mV, 0 if unknown),
+ *   u8 event flags, u8 port
+ */
+#define TELEMETRY_EVENT_LEN         (13u)
+
+/*
+ * STATUS payload:
+ *   u32 timestamp (ms), u8 vbus status, u16 OVP volt (mV), u16 UVP volt (mV),
+ *   u8 OVP channel state, u8 UVP channel state, u8 port
+ */
+#define TELEMETRY_STATUS_LEN        (12u)
+
+/*
+ * COUNTERS payload:
+ *   u32 timestamp (ms), u32 OVP events, u32 UVP events, u32 dropped events,
+ *   u32 dropped log bytes
+ */
+#define TELEMETRY_COUNTERS_LEN      (20u)
+
+/*
+ * ISR payload, one frame per measurement and fault type, times in CPU cycles:
+ *   u8 measurement, u8 fault type, u32 samples, u32 min, u32 max, u32 mean
+ */
+#define TELEMETRY_ISR_LEN           (18u)
+
+/*
+ * TEXT payload:
+ *   1 to TELEMETRY_MAX_PAYLOAD bytes of ASCII reply text of the UART shell,
+ *   not terminated. A reply is sent line by line including the "\r\n"; a
+ *   longer line continues in the next TEXT frame.
+ */
+
+/*******************************************************************************
+* Function Name: telemetry_crc16
+********************************************************************************
+* Summary:
+*  Updates a CRC-16/CCITT-FALSE with a block of bytes.
+*
+* Parameters:
+*  crc - CRC value so far, TELEMETRY_CRC_INIT for a new frame
+*  data - bytes to add
+*  len - number of bytes
+*
+* Return:
+*  uint16_t
+*
+*******************************************************************************/
+static inline uint16_t telemetry_crc16(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+    uint8_t bit;
+
+    while (len-- != 0u)
+    {
+        crc ^= (uint16_t)((uint16_t)*data++ << 8);
+        for (bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x8000u) != 0u) ? (uint16_t)((crc << 1) ^ TELEMETRY_CRC_POLY) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+#endif /* _TELEMETRY_FRAME_H_ */
+
+/* End of file [] */
@@ -0,0 +1,1219 @@
+/******************************************************************************
+* File Name: tools/host_sim/host_sim.cpp
+*
+* Description: Core of the host simulator of the PMG1 MCU Using UVOV Blocks Code Example:
+*              simulated time, interrupt controller, USBPD register and comparator model,
+*              timers, UART and the firmware coroutine.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "sim_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* UVOV reference ladder of PMG1-S2, see uvov.h */
+#define SIM_LADDER_BOT              (2750u)
+#define SIM_LADDER_MID              (9000u)
+#define SIM_LADDER_MID_CODE         (25u)
+#define SIM_LADDER_LO_STEP          (250u)
+#define SIM_LADDER_HI_STEP          (500u)
+
+/* Largest debounce filter setting in filter clock cycles */
+#define SIM_FILTER_MAX              (0x20u)
+
+/* Name of the simulated device in the test reports */
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+#define SIM_SERIES                  "pmg1s2"
+#else
+#define SIM_SERIES                  "pmg1"
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+/* Stack of the firmware coroutine */
+#define SIM_STACK_SIZE              (1u << 20)
+
+#define SIM_NEVER                   (UINT64_MAX)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+sim_param_t sim_param =
+{
+    .filter_hz = 500000u,
+    .ilo_hz = 40000u,
+    .flash_write_us = 20000u,
+    .uart_baud = 115200u,
+    .adc_full_mv = 22000u,
+#ifdef SIM_PORT1
+    .vbus_mv = { 5000u, 5000u },
+#else
+    .vbus_mv = { 5000u },
+#endif /* SIM_PORT1 */
+};
+
+sim_stats_t sim_stats;
+sim_port_t sim_port[SIM_PORT_COUNT];
+PDSS_REGS_Type sim_pdss[SIM_PORT_COUNT];
+Cy_SysTick_Callback sim_systick_cb[5];
+bool sim_led_level = true;
+
+/* Linker generated bounds of the CY_NOINIT section, both NULL when the
+ * firmware has no CY_NOINIT data */
+extern "C" char __start_sim_noinit[] __attribute__((weak));
+extern "C" char __stop_sim_noinit[] __attribute__((weak));
+
+static struct
+{
+    uint64_t now;                   /* Cycles since the power-on */
+    uint64_t active;                /* Cycles the CPU was not in deep sleep */
+    uint64_t run_until;
+    bool running;                   /* The firmware coroutine is executing */
+    bool booted;
+    bool asleep;
+    sim_observer_t observer;
+
+    /* Interrupt controller */
+    bool primask;
+    uint64_t primask_at;
+    uint32_t prio_now;
+    cy_israddress isr[SIM_IRQ_COUNT];
+    uint32_t prio[SIM_IRQ_COUNT];
+    bool enabled[SIM_IRQ_COUNT];
+
+    /* SysTick, counts CPU cycles while the CPU is not in deep sleep */
+    bool systick_on;
+    uint32_t systick_reload;
+    uint64_t systick_start;
+    uint64_t systick_next;
+    bool systick_pending;
+
+    /* WDT counting the ILO */
+    bool wdt_on;
+    uint64_t wdt_start;
+    uint32_t wdt_match;
+    uint64_t wdt_next_tick;
+    bool wdt_intr;
+
+    /* UART */
+    uint8_t tx_fifo[SIM_UART_FIFO_SIZE];
+    uint32_t tx_count;
+    uint64_t tx_next;
+    uint32_t tx_level;
+    uint32_t tx_mask;
+    uint8_t rx_fifo[SIM_UART_FIFO_SIZE];
+    uint32_t rx_count;
+    uint32_t rx_mask;
+    uint8_t *tx_log;
+    size_t tx_log_len;
+    size_t tx_log_cap;
+    char *rx_queue;
+    size_t rx_queue_len;
+    size_t rx_queue_pos;
+    uint64_t rx_next;
+
+    /* Flash rows written by the firmware */
+    uint32_t row_count;
+    uint32_t row_addr[SIM_NV_ROWS];
+
+    ucontext_t test_ctx;
+    ucontext_t fw_ctx;
+    void *stack;
+} sim;
+
+/*******************************************************************************
+* Checks
+*******************************************************************************/
+void sim_check_failed(const char *file, int line, const char *cond)
+{
+    fprintf(stderr, "%s:%d: check failed: %s (at %llu us)\n", file, line, cond,
+            (unsigned long long)sim_time_us());
+    fflush(stderr);
+    _exit(1);
+}
+
+void sim_assert_failed(const char *file, int line)
+{
+    sim_check_failed(file, line, "CY_ASSERT");
+}
+
+/*******************************************************************************
+* Comparator model
+*******************************************************************************/
+uint16_t sim_ladder_mv(uint32_t code)
+{
+    if (code <= SIM_LADDER_MID_CODE)
+    {
+        return (uint16_t)(SIM_LADDER_BOT + (code * SIM_LADDER_LO_STEP));
+    }
+    return (uint16_t)(SIM_LADDER_MID + ((code - SIM_LADDER_MID_CODE) * SIM_LADDER_HI_STEP));
+}
+
+uint8_t sim_port_of(const cy_stc_usbpd_context_t *context)
+{
+    return (uint8_t)(context->base - sim_pdss);
+}
+
+void sim_notify(sim_evt_kind_t kind, uint8_t port, uint8_t comp, uint32_t value)
+{
+    sim_evt_t evt;
+
+    if (sim.observer != NULL)
+    {
+        evt.kind = kind;
+        evt.port = port;
+        evt.comp = comp;
+        evt.value = value;
+        evt.cycle = sim.now;
+        sim.observer(&evt);
+    }
+}
+
+/* Threshold in mV of a comparator, 0 while it is powered down */
+uint16_t sim_comp_threshold_mv(uint8_t port, uint8_t comp)
+{
+    sim_port_t *p = &sim_port[port];
+
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    if (((p->uvov_ctrl & PDSS_UVOV_CTRL_UVOV_ISO_N) == 0u) || ((p->uvov_ctrl & PDSS_UVOV_CTRL_PD_UVOV) != 0u))
+    {
+        return 0u;
+    }
+    return sim_ladder_mv(sim_comp_level(port, comp));
+#else
+    return p->comp[comp].enabled ? p->comp[comp].thr_mv : 0u;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+uint32_t sim_comp_level(uint8_t port, uint8_t comp)
+{
+    sim_port_t *p = &sim_port[port];
+
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    if (comp == SIM_COMP_OV)
+    {
+        return (p->uvov_ctrl & PDSS_UVOV_CTRL_OV_IN_MASK) >> PDSS_UVOV_CTRL_OV_IN_POS;
+    }
+    return (p->uvov_ctrl & PDSS_UVOV_CTRL_UV_IN_MASK) >> PDSS_UVOV_CTRL_UV_IN_POS;
+#else
+    return p->comp[comp].thr_mv;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/* Debounce of a comparator in CPU cycles. The filter setting is derived from
+ * the configured debounce as the PDL does; the PMG1-S2 UV filter follows the
+ * OVP debounce (PMG1S2_Vbus_UvpFilterSelGet()).
+ */
+static uint64_t sim_comp_filter(uint8_t port, uint8_t comp)
+{
+    uint32_t debounce = sim_ovp_config[port].debounce;
+    uint32_t sel;
+
+#if !defined(CY_DEVICE_SERIES_PMG1S2)
+    if (comp == SIM_COMP_UV)
+    {
+        debounce = sim_uvp_config[port].debounce;
+    }
+#endif /* !defined(CY_DEVICE_SERIES_PMG1S2) */
+    sel = (debounce + 1u) / 2u;
+    if (sel > SIM_FILTER_MAX)
+    {
+        sel = SIM_FILTER_MAX;
+    }
+    return ((uint64_t)sel * SIM_CPU_HZ) / sim_param.filter_hz;
+}
+
+/* The filtered output of a comparator changed */
+static void sim_comp_output(uint8_t port, uint8_t comp, bool out)
+{
+    sim_port_t *p = &sim_port[port];
+    sim_comp_t *c = &p->comp[comp];
+
+    c->out = out;
+    if (!out)
+    {
+        return;
+    }
+
+    sim_notify(SIM_EVT_TRIP, port, comp, sim_comp_level(port, comp));
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    p->intr3 |= (comp == SIM_COMP_OV) ? PDSS_INTR3_POS_OV_CHANGED : PDSS_INTR3_POS_UV_CHANGED;
+#else
+    if (c->enabled)
+    {
+        c->intr = true;
+    }
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+    if (c->auto_fet)
+    {
+        sim_fet_set(port, false);
+    }
+}
+
+/* Re-evaluates the raw comparator outputs after a change of VBUS or of the
+ * thresholds and starts the debounce of a changed output
+ */
+void sim_comp_eval(uint8_t port)
+{
+    sim_port_t *p = &sim_port[port];
+    uint8_t comp;
+    uint16_t thr;
+    bool raw;
+    uint64_t filter;
+
+    for (comp = 0; comp < 2u; comp++)
+    {
+        sim_comp_t *c = &p->comp[comp];
+
+        thr = sim_comp_threshold_mv(port, comp);
+        if (thr == 0u)
+        {
+            raw = false;
+        }
+        else
+        {
+            raw = (comp == SIM_COMP_OV) ? (p->vbus > thr) : (p->vbus < thr);
+        }
+
+        if (raw == c->raw)
+        {
+            continue;
+        }
+        c->raw = raw;
+        if (raw == c->out)
+        {
+            /* Glitch shorter than the filter */
+            c->change = false;
+            continue;
+        }
+        filter = sim_comp_filter(port, comp);
+        if (filter == 0u)
+        {
+            c->change = false;
+            sim_comp_output(port, comp, raw);
+        }
+        else
+        {
+            c->change = true;
+            c->due = sim.now + filter;
+        }
+    }
+}
+
+void sim_fet_set(uint8_t port, bool on)
+{
+    if (sim_port[port].fet_on != on)
+    {
+        sim_port[port].fet_on = on;
+        sim_notify(SIM_EVT_FET, port, 0u, on ? 1u : 0u);
+    }
+}
+
+/* Interrupt line of the USBPD block of a port */
+static bool sim_usbpd_irq(uint8_t port)
+{
+    sim_port_t *p = &sim_port[port];
+
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return ((p->intr3 & p->intr3_mask) != 0u);
+#else
+    return ((p->comp[SIM_COMP_OV].enabled && p->comp[SIM_COMP_OV].intr) ||
+            (p->comp[SIM_COMP_UV].enabled && p->comp[SIM_COMP_UV].intr));
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Register model
+*******************************************************************************/
+static uint8_t sim_reg_port(const void *reg)
+{
+    return (uint8_t)(((const char *)reg - (const char *)sim_pdss) / sizeof(PDSS_REGS_Type));
+}
+
+/* The NCELL status reports the comparators ahead of the debounce filter */
+static uint32_t sim_comp_status(uint8_t port)
+{
+    sim_port_t *p = &sim_port[port];
+
+    return (p->comp[SIM_COMP_OV].raw ? PDSS_NCELL_STATUS_OV_STATUS : 0u) |
+           (p->comp[SIM_COMP_UV].raw ? PDSS_NCELL_STATUS_UV_STATUS : 0u);
+}
+
+uint32_t sim_reg_read(const void *reg, sim_reg_id_t id)
+{
+    uint8_t port = sim_reg_port(reg);
+    sim_port_t *p = &sim_port[port];
+    uint32_t value = 0u;
+
+    sim_tick(SIM_CYCLES_REG);
+    switch (id)
+    {
+        case SIM_REG_INTR3:
+        case SIM_REG_INTR3_SET:
+            value = p->intr3;
+            break;
+        case SIM_REG_INTR3_MASK:
+            value = p->intr3_mask;
+            break;
+        case SIM_REG_INTR3_MASKED:
+            value = p->intr3 & p->intr3_mask;
+            break;
+        case SIM_REG_UVOV_CTRL:
+            value = p->uvov_ctrl;
+            break;
+        case SIM_REG_NCELL_STATUS:
+            value = sim_comp_status(port);
+            break;
+        case SIM_REG_INTR5_STATUS_0:
+            /* The UV filter output is inverted on this register */
+            value = (p->comp[SIM_COMP_OV].out ? PDSS_INTR5_STATUS_0_FILT_OV : 0u) |
+                    (p->comp[SIM_COMP_UV].out ? 0u : PDSS_INTR5_STATUS_0_FILT_UV);
+            break;
+        default:
+            break;
+    }
+    return value;
+}
+
+void sim_reg_write(void *reg, sim_reg_id_t id, uint32_t value)
+{
+    uint8_t port = sim_reg_port(reg);
+    sim_port_t *p = &sim_port[port];
+    uint32_t armed;
+    uint8_t comp;
+
+    switch (id)
+    {
+        case SIM_REG_INTR3:
+            for (comp = 0; comp < 2u; comp++)
+            {
+                uint32_t bit = (comp == SIM_COMP_OV) ? PDSS_INTR3_POS_OV_CHANGED : PDSS_INTR3_POS_UV_CHANGED;
+
+                if ((value & p->intr3 & bit) != 0u)
+                {
+                    sim_notify(SIM_EVT_ACK, port, comp, sim_comp_level(port, comp));
+                }
+            }
+            p->intr3 &= ~value;
+            break;
+        case SIM_REG_INTR3_SET:
+            p->intr3 |= value;
+            break;
+        case SIM_REG_INTR3_MASK:
+            armed = value & ~p->intr3_mask;
+            p->intr3_mask = value;
+            for (comp = 0; comp < 2u; comp++)
+            {
+                if ((armed & ((comp == SIM_COMP_OV) ? PDSS_INTR3_POS_OV_CHANGED : PDSS_INTR3_POS_UV_CHANGED)) != 0u)
+                {
+                    sim_notify(SIM_EVT_ARM, port, comp, sim_comp_level(port, comp));
+                }
+            }
+            break;
+        case SIM_REG_UVOV_CTRL:
+            p->uvov_ctrl = value;
+            sim_comp_eval(port);
+            break;
+        default:
+            /* Read-only */
+            break;
+    }
+    sim_tick(SIM_CYCLES_REG);
+}
+
+/*******************************************************************************
+* Time
+*******************************************************************************/
+uint64_t sim_cycles(void)
+{
+    return sim.now;
+}
+
+uint64_t sim_time_us(void)
+{
+    return sim.now / SIM_CYCLES_PER_US;
+}
+
+static uint64_t sim_uart_byte_cycles(void)
+{
+    /* Start, 8 data and stop bit */
+    return ((uint64_t)SIM_CPU_HZ * 10u) / sim_param.uart_baud;
+}
+
+static uint64_t sim_wdt_tick_cycle(uint64_t tick)
+{
+    return sim.wdt_start + ((tick * SIM_CPU_HZ) + sim_param.ilo_hz - 1u) / sim_param.ilo_hz;
+}
+
+static uint64_t sim_wdt_ticks(void)
+{
+    return ((sim.now - sim.wdt_start) * sim_param.ilo_hz) / SIM_CPU_HZ;
+}
+
+/* Time of the next event of the models, SIM_NEVER if there is none */
+static uint64_t sim_next_event(void)
+{
+    uint64_t next = SIM_NEVER;
+    uint64_t t;
+    uint8_t port;
+    uint8_t comp;
+
+    for (port = 0; port < SIM_PORT_COUNT; port++)
+    {
+        sim_port_t *p = &sim_port[port];
+
+        for (comp = 0; comp < 2u; comp++)
+        {
+            if (p->comp[comp].change && (p->comp[comp].due < next))
+            {
+                next = p->comp[comp].due;
+            }
+        }
+        if (p->trace_idx < p->trace_len)
+        {
+            t = p->trace_start + (p->trace[p->trace_idx].time_us * SIM_CYCLES_PER_US);
+            if (t < next)
+            {
+                next = t;
+            }
+        }
+    }
+    if (sim.systick_on && !sim.asleep)
+    {
+        t = sim.now + (sim.systick_next - sim.active);
+        if (t < next)
+        {
+            next = t;
+        }
+    }
+    if (sim.wdt_on)
+    {
+        t = sim_wdt_tick_cycle(sim.wdt_next_tick);
+        if (t < next)
+        {
+            next = t;
+        }
+    }
+    if ((sim.tx_count != 0u) && (sim.tx_next < next))
+    {
+        next = sim.tx_next;
+    }
+    if ((sim.rx_queue_pos < sim.rx_queue_len) && (sim.rx_next < next))
+    {
+        next = sim.rx_next;
+    }
+    return next;
+}
+
+/* Runs the events due at the current time */
+static void sim_process_events(void)
+{
+    uint8_t port;
+    uint8_t comp;
+
+    for (port = 0; port < SIM_PORT_COUNT; port++)
+    {
+        sim_port_t *p = &sim_port[port];
+
+        while ((p->trace_idx < p->trace_len) &&
+               ((p->trace_start + (p->trace[p->trace_idx].time_us * SIM_CYCLES_PER_US)) <= sim.now))
+        {
+            p->vbus = p->trace[p->trace_idx].vbus_mv;
+            p->trace_idx++;
+            sim_comp_eval(port);
+        }
+        for (comp = 0; comp < 2u; comp++)
+        {
+            if (p->comp[comp].change && (p->comp[comp].due <= sim.now))
+            {
+                p->comp[comp].change = false;
+                sim_comp_output(port, comp, p->comp[comp].raw);
+            }
+        }
+    }
+
+    if (sim.systick_on && !sim.asleep && (sim.active >= sim.systick_next))
+    {
+        sim.systick_pending = true;
+        sim.systick_next += (uint64_t)sim.systick_reload + 1u;
+    }
+
+    if (sim.wdt_on && (sim_wdt_tick_cycle(sim.wdt_next_tick) <= sim.now))
+    {
+        sim.wdt_intr = true;
+        sim.wdt_next_tick += 0x10000u;
+    }
+
+    if ((sim.tx_count != 0u) && (sim.tx_next <= sim.now))
+    {
+        if (sim.tx_log_len == sim.tx_log_cap)
+        {
+            sim.tx_log_cap = (sim.tx_log_cap == 0u) ? 4096u : (sim.tx_log_cap * 2u);
+            sim.tx_log = (uint8_t *)realloc(sim.tx_log, sim.tx_log_cap);
+        }
+        sim.tx_log[sim.tx_log_len++] = sim.tx_fifo[0];
+        memmove(&sim.tx_fifo[0], &sim.tx_fifo[1], sim.tx_count - 1u);
+        sim.tx_count--;
+        sim.tx_next = sim.now + sim_uart_byte_cycles();
+    }
+
+    if ((sim.rx_queue_pos < sim.rx_queue_len) && (sim.rx_next <= sim.now))
+    {
+        if (sim.rx_count < SIM_UART_FIFO_SIZE)
+        {
+            sim.rx_fifo[sim.rx_count++] = (uint8_t)sim.rx_queue[sim.rx_queue_pos];
+        }
+        sim.rx_queue_pos++;
+        sim.rx_next = sim.now + sim_uart_byte_cycles();
+    }
+}
+
+void sim_advance(uint64_t until)
+{
+    uint64_t next;
+
+    for (;;)
+    {
+        next = sim_next_event();
+        if (next > until)
+        {
+            next = until;
+        }
+        if (next > sim.now)
+        {
+            if (sim.asleep)
+            {
+                sim_stats.sleep_cycles += next - sim.now;
+            }
+            else
+            {
+                sim.active += next - sim.now;
+            }
+            sim.now = next;
+        }
+        sim_process_events();
+        if (next >= until)
+        {
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Interrupt controller
+*******************************************************************************/
+void sim_primask_set(bool set)
+{
+    uint64_t off;
+
+    if (set && !sim.primask)
+    {
+        sim.primask_at = sim.now;
+    }
+    else if (!set && sim.primask)
+    {
+        off = sim.now - sim.primask_at;
+        sim_stats.irq_off_total += off;
+        if (off > sim_stats.irq_off_max)
+        {
+            sim_stats.irq_off_max = off;
+        }
+    }
+    sim.primask = set;
+}
+
+bool sim_primask_get(void)
+{
+    return sim.primask;
+}
+
+void sim_irq_register(IRQn_Type irq, uint32_t prio, cy_israddress isr)
+{
+    sim.isr[irq] = isr;
+    sim.prio[irq] = prio;
+}
+
+void sim_irq_enable(IRQn_Type irq, bool enable)
+{
+    sim.enabled[irq] = enable;
+}
+
+bool sim_in_firmware(void)
+{
+    return sim.running;
+}
+
+/* Level of an interrupt line */
+static bool sim_irq_level(uint32_t irq)
+{
+    switch (irq)
+    {
+        case usbpd_0_interrupt_wakeup_IRQn:
+            return sim_usbpd_irq(0u);
+#ifdef SIM_PORT1
+        case usbpd_1_interrupt_wakeup_IRQn:
+            return sim_usbpd_irq(1u);
+#endif /* SIM_PORT1 */
+        case scb_4_interrupt_IRQn:
+            return ((sim_uart_tx_status() | sim_uart_rx_status()) != 0u);
+        case srss_interrupt_IRQn:
+            return sim.wdt_intr;
+        default:
+            return false;
+    }
+}
+
+/* Takes the pending interrupts of a priority above the running code */
+static void sim_irq_deliver(void)
+{
+    uint32_t irq;
+    int32_t best;
+    uint32_t best_prio;
+    uint32_t saved;
+
+    while (!sim.primask)
+    {
+        best = -2;
+        best_prio = sim.prio_now;
+
+        /* SysTick wins over the external interrupts of the same priority */
+        if (sim.systick_pending && (3u < best_prio))
+        {
+            best = -1;
+            best_prio = 3u;
+        }
+        for (irq = 0; irq < SIM_IRQ_COUNT; irq++)
+        {
+            if (sim.enabled[irq] && (sim.isr[irq] != NULL) && (sim.prio[irq] < best_prio) && sim_irq_level(irq))
+            {
+                best = (int32_t)irq;
+                best_prio = sim.prio[irq];
+            }
+        }
+        if (best == -2)
+        {
+            break;
+        }
+
+        saved = sim.prio_now;
+        sim.prio_now = best_prio;
+        sim_advance(sim.now + SIM_CYCLES_IRQ_ENTRY);
+        if (best == -1)
+        {
+            sim.systick_pending = false;
+            sim_stats.systick_taken++;
+            for (irq = 0; irq < 5u; irq++)
+            {
+                if (sim_systick_cb[irq] != NULL)
+                {
+                    sim_systick_cb[irq]();
+                }
+            }
+        }
+        else
+        {
+            sim_stats.irq_taken[best]++;
+            sim.isr[best]();
+        }
+        sim_advance(sim.now + SIM_CYCLES_IRQ_EXIT);
+        sim.prio_now = saved;
+    }
+}
+
+static void sim_yield(void)
+{
+    sim.running = false;
+    swapcontext(&sim.fw_ctx, &sim.test_ctx);
+    sim.running = true;
+}
+
+void sim_tick(uint32_t cycles)
+{
+    sim_advance(sim.now + cycles);
+    sim_irq_deliver();
+    if (sim.running && (sim.now >= sim.run_until))
+    {
+        sim_yield();
+        sim_irq_deliver();
+    }
+}
+
+/*******************************************************************************
+* Deep sleep
+*******************************************************************************/
+/* Interrupts able to wake the CPU; WFI also returns with PRIMASK set */
+static bool sim_wakeup_pending(void)
+{
+    uint32_t irq;
+
+    for (irq = 0; irq < SIM_IRQ_COUNT; irq++)
+    {
+        if ((irq != scb_4_interrupt_IRQn) && sim.enabled[irq] && sim_irq_level(irq))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void sim_deep_sleep(void)
+{
+    uint64_t next;
+
+    sim.asleep = true;
+    sim_stats.sleeps++;
+    sim_notify(SIM_EVT_SLEEP, 0u, 0u, 1u);
+    while (!sim_wakeup_pending())
+    {
+        next = sim_next_event();
+        if (next > sim.run_until)
+        {
+            sim_advance(sim.run_until);
+            if (!sim.running)
+            {
+                break;
+            }
+            sim_yield();
+            continue;
+        }
+        sim_advance(next);
+    }
+    sim_advance(sim.now + (SIM_WAKEUP_US * SIM_CYCLES_PER_US));
+    sim.asleep = false;
+    sim_notify(SIM_EVT_SLEEP, 0u, 0u, 0u);
+}
+
+bool sim_asleep(void)
+{
+    return sim.asleep;
+}
+
+/*******************************************************************************
+* SysTick
+*******************************************************************************/
+void sim_systick_init(uint32_t reload)
+{
+    sim.systick_on = true;
+    sim.systick_reload = reload;
+    sim.systick_start = sim.active;
+    sim.systick_next = sim.active + reload + 1u;
+}
+
+uint32_t sim_systick_value(void)
+{
+    uint64_t phase = (sim.active - sim.systick_start) % ((uint64_t)sim.systick_reload + 1u);
+
+    return (uint32_t)(sim.systick_reload - phase);
+}
+
+/*******************************************************************************
+* WDT
+*******************************************************************************/
+static void sim_wdt_next(void)
+{
+    uint64_t ticks = sim_wdt_ticks();
+    uint64_t next = (ticks & ~(uint64_t)0xFFFFu) + sim.wdt_match;
+
+    if (next <= ticks)
+    {
+        next += 0x10000u;
+    }
+    sim.wdt_next_tick = next;
+}
+
+void sim_wdt_enable(bool enable)
+{
+    if (enable && !sim.wdt_on)
+    {
+        sim.wdt_start = sim.now;
+    }
+    sim.wdt_on = enable;
+    sim_wdt_next();
+}
+
+uint32_t sim_wdt_count(void)
+{
+    return sim.wdt_on ? (uint32_t)(sim_wdt_ticks() & 0xFFFFu) : 0u;
+}
+
+void sim_wdt_match(uint32_t match)
+{
+    sim.wdt_match = match & 0xFFFFu;
+    sim_wdt_next();
+}
+
+uint32_t sim_wdt_get_match(void)
+{
+    return sim.wdt_match;
+}
+
+bool sim_wdt_intr(void)
+{
+    return sim.wdt_intr;
+}
+
+void sim_wdt_clear(void)
+{
+    sim.wdt_intr = false;
+}
+
+/*******************************************************************************
+* UART
+*******************************************************************************/
+bool sim_uart_put(uint8_t data)
+{
+    if (sim.tx_count >= SIM_UART_FIFO_SIZE)
+    {
+        return false;
+    }
+    if (sim.tx_count == 0u)
+    {
+        sim.tx_next = sim.now + sim_uart_byte_cycles();
+    }
+    sim.tx_fifo[sim.tx_count++] = data;
+    return true;
+}
+
+uint32_t sim_uart_get(void)
+{
+    uint32_t data;
+
+    if (sim.rx_count == 0u)
+    {
+        return CY_SCB_UART_RX_NO_DATA;
+    }
+    data = sim.rx_fifo[0];
+    memmove(&sim.rx_fifo[0], &sim.rx_fifo[1], sim.rx_count - 1u);
+    sim.rx_count--;
+    return data;
+}
+
+void sim_uart_tx_level(uint32_t level)
+{
+    sim.tx_level = level;
+}
+
+void sim_uart_tx_mask(uint32_t mask)
+{
+    sim.tx_mask = mask;
+}
+
+void sim_uart_rx_mask(uint32_t mask)
+{
+    sim.rx_mask = mask;
+}
+
+/* The level trigger is active while the FIFO holds fewer entries than the level */
+uint32_t sim_uart_tx_status(void)
+{
+    return ((sim.tx_count < sim.tx_level) ? CY_SCB_TX_INTR_LEVEL : 0u) & sim.tx_mask;
+}
+
+uint32_t sim_uart_rx_status(void)
+{
+    return ((sim.rx_count != 0u) ? CY_SCB_RX_INTR_NOT_EMPTY : 0u) & sim.rx_mask;
+}
+
+bool sim_uart_tx_idle(void)
+{
+    return (sim.tx_count == 0u);
+}
+
+size_t sim_uart_tx(const uint8_t **data)
+{
+    *data = sim.tx_log;
+    return sim.tx_log_len;
+}
+
+void sim_uart_tx_clear(void)
+{
+    sim.tx_log_len = 0u;
+}
+
+void sim_uart_rx(const char *text)
+{
+    size_t len = strlen(text);
+
+    if (sim.rx_queue_pos >= sim.rx_queue_len)
+    {
+        sim.rx_queue_pos = 0u;
+        sim.rx_queue_len = 0u;
+        sim.rx_next = sim.now;
+    }
+    sim.rx_queue = (char *)realloc(sim.rx_queue, sim.rx_queue_len + len);
+    memcpy(&sim.rx_queue[sim.rx_queue_len], text, len);
+    sim.rx_queue_len += len;
+}
+
+/*******************************************************************************
+* Flash
+*******************************************************************************/
+static void sim_flash_copy(uint32_t addr, const void *data)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    uintptr_t base = (uintptr_t)addr & ~(uintptr_t)(page - 1);
+
+    /* The flash is the read-only data of the host image */
+    if (mprotect((void *)base, (size_t)page, PROT_READ | PROT_WRITE) != 0)
+    {
+        sim_check_failed(__FILE__, __LINE__, "flash row outside the image");
+    }
+    memcpy((void *)(uintptr_t)addr, data, CY_FLASH_SIZEOF_ROW);
+    (void)mprotect((void *)base, (size_t)page, PROT_READ);
+}
+
+void sim_flash_write(uint32_t addr, const void *data)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < sim.row_count; idx++)
+    {
+        if (sim.row_addr[idx] == addr)
+        {
+            break;
+        }
+    }
+    if (idx == sim.row_count)
+    {
+        SIM_CHECK(sim.row_count < SIM_NV_ROWS);
+        sim.row_addr[sim.row_count++] = addr;
+    }
+    sim_flash_copy(addr, data);
+    sim_stats.flash_writes++;
+    sim_notify(SIM_EVT_FLASH, 0u, 0u, addr);
+}
+
+/*******************************************************************************
+* Test interface
+*******************************************************************************/
+void sim_vbus_set(uint8_t port, uint16_t mv)
+{
+    sim_port[port].vbus = mv;
+    sim_port[port].trace_len = 0u;
+    sim_comp_eval(port);
+}
+
+uint16_t sim_vbus_get(uint8_t port)
+{
+    return sim_port[port].vbus;
+}
+
+void sim_adc_freeze(uint8_t port, bool freeze)
+{
+    sim_port[port].adc_frozen = freeze;
+    sim_port[port].adc_mv = sim_port[port].vbus;
+}
+
+void sim_vbus_trace(uint8_t port, const sim_sample_t *samples, size_t count)
+{
+    sim_port_t *p = &sim_port[port];
+
+    p->trace = samples;
+    p->trace_len = count;
+    p->trace_idx = 0u;
+    p->trace_start = sim.now;
+    sim_process_events();
+}
+
+bool sim_vbus_trace_done(uint8_t port)
+{
+    return (sim_port[port].trace_idx >= sim_port[port].trace_len);
+}
+
+bool sim_fet_on(uint8_t port)
+{
+    return sim_port[port].fet_on;
+}
+
+bool sim_comp_out(uint8_t port, uint8_t comp)
+{
+    return sim_port[port].comp[comp].out;
+}
+
+bool sim_comp_armed(uint8_t port, uint8_t comp)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return ((sim_port[port].intr3_mask &
+            ((comp == SIM_COMP_OV) ? PDSS_INTR3_POS_OV_CHANGED : PDSS_INTR3_POS_UV_CHANGED)) != 0u);
+#else
+    return sim_port[port].comp[comp].enabled;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+bool sim_led_on(void)
+{
+    return !sim_led_level;
+}
+
+void sim_observe(sim_observer_t observer)
+{
+    sim.observer = observer;
+}
+
+static void sim_firmware_entry(void)
+{
+    sim.running = true;
+    (void)firmware_main();
+    sim_check_failed(__FILE__, __LINE__, "firmware main() returned");
+}
+
+void sim_boot(const sim_nv_t *nv)
+{
+    size_t noinit = (size_t)(__stop_sim_noinit - __start_sim_noinit);
+    uint32_t idx;
+    uint8_t port;
+
+    SIM_CHECK(!sim.booted);
+    SIM_CHECK(noinit <= SIM_NV_NOINIT_SIZE);
+    sim.booted = true;
+
+    /* RAM holds noise after a power-on, CY_NOINIT data survives a reset */
+    if ((nv != NULL) && (nv->noinit_size == noinit))
+    {
+        memcpy(__start_sim_noinit, nv->noinit, noinit);
+    }
+    else
+    {
+        for (idx = 0; idx < noinit; idx++)
+        {
+            __start_sim_noinit[idx] = (char)(rand() >> 7);
+        }
+    }
+    if (nv != NULL)
+    {
+        for (idx = 0; idx < nv->row_count; idx++)
+        {
+            sim_flash_copy(nv->row_addr[idx], nv->row[idx]);
+            sim.row_addr[idx] = nv->row_addr[idx];
+        }
+        sim.row_count = nv->row_count;
+    }
+
+    sim.prio_now = SIM_PRIO_THREAD;
+    for (port = 0; port < SIM_PORT_COUNT; port++)
+    {
+        sim_port[port].vbus = sim_param.vbus_mv[port];
+        sim_port[port].fet_on = true;
+    }
+
+    sim.stack = malloc(SIM_STACK_SIZE);
+    getcontext(&sim.fw_ctx);
+    sim.fw_ctx.uc_stack.ss_sp = sim.stack;
+    sim.fw_ctx.uc_stack.ss_size = SIM_STACK_SIZE;
+    sim.fw_ctx.uc_link = NULL;
+    makecontext(&sim.fw_ctx, sim_firmware_entry, 0);
+}
+
+void sim_run_cycles(uint64_t cycles)
+{
+    SIM_CHECK(sim.booted);
+    sim.run_until = sim.now + cycles;
+    swapcontext(&sim.test_ctx, &sim.fw_ctx);
+}
+
+void sim_run_us(uint64_t us)
+{
+    sim_run_cycles(us * SIM_CYCLES_PER_US);
+}
+
+void sim_save_nv(sim_nv_t *nv)
+{
+    uint32_t idx;
+
+    nv->noinit_size = (uint32_t)(__stop_sim_noinit - __start_sim_noinit);
+    memcpy(nv->noinit, __start_sim_noinit, nv->noinit_size);
+    nv->row_count = sim.row_count;
+    for (idx = 0; idx < sim.row_count; idx++)
+    {
+        nv->row_addr[idx] = sim.row_addr[idx];
+        memcpy(nv->row[idx], (const void *)(uintptr_t)sim.row_addr[idx], CY_FLASH_SIZEOF_ROW);
+    }
+}
+
+int sim_fork(void (*scenario)(void))
+{
+    pid_t pid;
+    int status;
+
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if (pid == 0)
+    {
+        scenario();
+        fflush(stdout);
+        _exit(0);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return -1;
+    }
+    if (WIFSIGNALED(status))
+    {
+        fprintf(stderr, "scenario killed by signal %d\n", WTERMSIG(status));
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+int sim_run_scenarios(const char *suite, const sim_scenario_t *list, size_t count)
+{
+    size_t idx;
+    int failed = 0;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        if (sim_fork(list[idx].run) == 0)
+        {
+            printf("PASS %s %s/%s\n", SIM_SERIES, suite, list[idx].name);
+        }
+        else
+        {
+            printf("FAIL %s %s/%s\n", SIM_SERIES, suite, list[idx].name);
+            failed++;
+        }
+    }
+    fflush(stdout);
+    return failed;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,209 @@
+/******************************************************************************
+* File Name: tools/host_sim/host_sim.h
+*
+* Description: Host simulator of the PMG1 MCU Using UVOV Blocks Code Example. Runs the
+*              unmodified firmware against a model of the USBPD UV/OV block, the
+*              interrupt controller and the timers used by the firmware.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _HOST_SIM_H_
+#define _HOST_SIM_H_
+
+#include "cy_pdl.h"
+
+/*
+ * The firmware main() runs as a coroutine on simulated time. Simulated time
+ * is counted in CPU cycles at SIM_CPU_HZ; every call into the PDL and every
+ * USBPD register access is a point at which time advances by a fixed cost,
+ * the modelled peripherals update and pending interrupts are taken. The
+ * firmware code between two such points costs no time, so cycle counts are
+ * a model of the PDL cost and not of the compiled firmware.
+ *
+ * A test sets the configuration, calls sim_boot() and then alternates
+ * sim_run_us() with VBUS changes and checks. sim_fork() runs every scenario
+ * in a child process, so each one starts from a freshly loaded image as the
+ * device does after a power-on.
+ */
+
+#define SIM_CPU_HZ                  (48000000u)
+#define SIM_CYCLES_PER_US           (SIM_CPU_HZ / 1000000u)
+
+/* Ports of the simulated board */
+#ifdef SIM_PORT1
+#define SIM_PORT_COUNT              (2u)
+#else
+#define SIM_PORT_COUNT              (1u)
+#endif /* SIM_PORT1 */
+
+/* Comparators of a port */
+#define SIM_COMP_OV                 (0u)
+#define SIM_COMP_UV                 (1u)
+
+/* Model parameters, set before sim_boot() */
+typedef struct
+{
+    uint32_t filter_hz;             /* Debounce filter clock of the comparators */
+    uint32_t ilo_hz;                /* Actual ILO frequency clocking the WDT */
+    uint32_t flash_write_us;        /* Duration of a flash row write */
+    uint32_t uart_baud;             /* Baud rate of the debug UART */
+    uint16_t adc_full_mv;           /* VBUS at the full scale of the 8-bit ADC */
+    uint16_t vbus_mv[SIM_PORT_COUNT];   /* VBUS at boot */
+} sim_param_t;
+
+extern sim_param_t sim_param;
+
+/* Configurator settings of the ports, read by the firmware through
+ * mtb_usbpd_portN_config. Tests change them before sim_boot().
+ */
+extern cy_stc_fault_vbus_ovp_cfg_t sim_ovp_config[SIM_PORT_COUNT];
+extern cy_stc_fault_vbus_uvp_cfg_t sim_uvp_config[SIM_PORT_COUNT];
+
+/* One VBUS sample of a trace, time relative to the start of the trace */
+typedef struct
+{
+    uint64_t time_us;
+    uint16_t vbus_mv;
+} sim_sample_t;
+
+/* Events reported to the observer */
+typedef enum
+{
+    SIM_EVT_ARM = 0,                /* A comparator interrupt was unmasked */
+    SIM_EVT_TRIP,                   /* The filtered comparator output rose */
+    SIM_EVT_ACK,                    /* The firmware acknowledged the interrupt */
+    SIM_EVT_FET,                    /* The provider FET was switched */
+    SIM_EVT_SLEEP,                  /* The CPU entered (value 1) or left (0) deep sleep */
+    SIM_EVT_FLASH                   /* A flash row was written, value is the address */
+} sim_evt_kind_t;
+
+typedef struct
+{
+    sim_evt_kind_t kind;
+    uint8_t port;
+    uint8_t comp;                   /* SIM_COMP_OV or SIM_COMP_UV */
+    uint32_t value;                 /* Ladder code (PMG1-S2) or mV threshold, FET state */
+    uint64_t cycle;
+} sim_evt_t;
+
+typedef void (*sim_observer_t)(const sim_evt_t *evt);
+
+/* Statistics of the model */
+typedef struct
+{
+    uint64_t irq_off_max;           /* Longest interval with PRIMASK set, in cycles */
+    uint64_t irq_off_total;         /* Sum of the intervals with PRIMASK set */
+    uint64_t irq_taken[SIM_IRQ_COUNT];
+    uint64_t systick_taken;
+    uint64_t sleep_cycles;          /* Time spent in deep sleep */
+    uint32_t sleeps;
+    uint32_t flash_writes;
+} sim_stats_t;
+
+extern sim_stats_t sim_stats;
+
+/* Image kept over a simulated reset: the CY_NOINIT RAM and the flash rows
+ * written by the firmware
+ */
+#define SIM_NV_NOINIT_SIZE          (1024u)
+#define SIM_NV_ROWS                 (4u)
+
+typedef struct
+{
+    uint32_t noinit_size;
+    uint8_t noinit[SIM_NV_NOINIT_SIZE];
+    uint32_t row_count;
+    uint32_t row_addr[SIM_NV_ROWS];
+    uint8_t row[SIM_NV_ROWS][CY_FLASH_SIZEOF_ROW];
+} sim_nv_t;
+
+/* Firmware entry point, main() of main.c */
+int firmware_main(void);
+
+void sim_boot(const sim_nv_t *nv);
+void sim_run_us(uint64_t us);
+void sim_run_cycles(uint64_t cycles);
+uint64_t sim_cycles(void);
+uint64_t sim_time_us(void);
+void sim_save_nv(sim_nv_t *nv);
+
+void sim_vbus_set(uint8_t port, uint16_t mv);
+uint16_t sim_vbus_get(uint8_t port);
+void sim_vbus_trace(uint8_t port, const sim_sample_t *samples, size_t count);
+bool sim_vbus_trace_done(uint8_t port);
+
+/* Holds the ADC reading of a port at the present VBUS, or releases it */
+void sim_adc_freeze(uint8_t port, bool freeze);
+
+bool sim_fet_on(uint8_t port);
+bool sim_comp_out(uint8_t port, uint8_t comp);
+bool sim_comp_armed(uint8_t port, uint8_t comp);
+uint32_t sim_comp_level(uint8_t port, uint8_t comp);
+uint16_t sim_comp_threshold_mv(uint8_t port, uint8_t comp);
+bool sim_led_on(void);
+bool sim_asleep(void);
+
+void sim_observe(sim_observer_t observer);
+
+size_t sim_uart_tx(const uint8_t **data);
+void sim_uart_tx_clear(void);
+void sim_uart_rx(const char *text);
+
+/* Runs a scenario in a child process, returns 0 when it exited with 0 */
+int sim_fork(void (*scenario)(void));
+
+/* Named scenario of a test program */
+typedef struct
+{
+    const char *name;
+    void (*run)(void);
+} sim_scenario_t;
+
+/* Runs the scenarios one by one and reports each, returns the failure count */
+int sim_run_scenarios(const char *suite, const sim_scenario_t *list, size_t count);
+
+/* Check inside a scenario, ends the child with a failure */
+#define SIM_CHECK(cond) \
+    do { if (!(cond)) { sim_check_failed(__FILE__, __LINE__, #cond); } } while (0)
+
+void sim_check_failed(const char *file, int line, const char *cond);
+
+/* Ladder voltage in mV of a PMG1-S2 UVOV reference code */
+uint16_t sim_ladder_mv(uint32_t code);
+
+#endif /* _HOST_SIM_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,65 @@
+################################################################################
+# \file host_sim.mk
+# \version 1.0
+#
+# \brief
+# Rules building the firmware of the PMG1 MCU Using UVOV Blocks Code Example
+# for the host simulator. Included by the host tools that run the firmware.
+#
+# The firmware sources are compiled unmodified as C++ against the simulated
+# PDL in sim/, main() is renamed to firmware_main(). Every configuration of
+# toggles is built into its own archive:
+#
+#   $(eval $(call sim_firmware,NAME,FLAGS))
+#
+# defines $(SIM_BUILD)/NAME/firmware.a, built with the extra compiler flags
+# FLAGS, e.g. -DCY_DEVICE_SERIES_PMG1S2 -DLOW_POWER_MODE=1u.
+#
+################################################################################
+# \copyright
+# Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company)
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+SIM_ROOT:=$(abspath $(dir $(lastword $(MAKEFILE_LIST))))
+SIM_APP:=$(abspath $(SIM_ROOT)/../..)
+SIM_BUILD?=build
+
+SIM_CXX?=g++
+SIM_CXXFLAGS?=-std=c++17 -O2 -g -Wall -Wno-unused-parameter -Wno-unused-function -Wno-missing-field-initializers
+# DEFINES of the application Makefile
+SIM_DEFINES:=-DVBUS_OVP_ENABLE=1 -DVBUS_UVP_ENABLE=1 -DPMG1_FLIPPED_FET_CTRL=1
+SIM_CPPFLAGS:=-fno-pie -I$(SIM_ROOT)/sim -I$(SIM_ROOT) -I$(SIM_APP) $(SIM_DEFINES)
+SIM_LDFLAGS:=-no-pie
+
+SIM_FW_SOURCES:=$(notdir $(wildcard $(SIM_APP)/*.c))
+SIM_CORE_SOURCES:=host_sim.cpp sim_pdl.cpp
+SIM_HEADERS:=$(wildcard $(SIM_APP)/*.h) $(wildcard $(SIM_ROOT)/sim/*.h) $(wildcard $(SIM_ROOT)/*.h)
+
+define sim_firmware
+$(SIM_BUILD)/$(1)/%.o: $(SIM_APP)/%.c $(SIM_HEADERS)
+	@mkdir -p $$(@D)
+	$(SIM_CXX) -x c++ $(SIM_CXXFLAGS) $(SIM_CPPFLAGS) $(2) $$(if $$(filter main.c,$$(notdir $$<)),-Dmain=firmware_main) -c $$< -o $$@
+
+$(SIM_BUILD)/$(1)/%.o: $(SIM_ROOT)/%.cpp $(SIM_HEADERS)
+	@mkdir -p $$(@D)
+	$(SIM_CXX) $(SIM_CXXFLAGS) $(SIM_CPPFLAGS) $(2) -c $$< -o $$@
+
+$(SIM_BUILD)/$(1)/firmware.a: $(addprefix $(SIM_BUILD)/$(1)/,$(SIM_FW_SOURCES:.c=.o) $(SIM_CORE_SOURCES:.cpp=.o))
+	@rm -f $$@
+	ar rcs $$@ $$^
+
+SIM_FLAGS_$(1):=$(2)
+endef
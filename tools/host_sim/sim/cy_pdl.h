@@ -0,0 +1,445 @@
+/******************************************************************************
+* File Name: tools/host_sim/sim/cy_pdl.h
+*
+* Description: Host simulator replacement of the PDL header for the PMG1 MCU Using UVOV
+*              Blocks Code Example. Declares the register model of the USBPD block and the
+*              PDL functions used by the firmware.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _SIM_CY_PDL_H_
+#define _SIM_CY_PDL_H_
+
+/*
+ * Only the part of the PDL used by the firmware is declared here, with the
+ * names and signatures of the device library. The firmware sources are
+ * compiled as C++ so that the USBPD registers can be proxy objects: every
+ * access goes through the register model in host_sim.cpp, which implements
+ * the write-1-to-clear/set semantics and the comparator behaviour.
+ */
+
+#ifndef __cplusplus
+#error "The firmware is built as C++ against the host simulator, see tools/host_sim/host_sim.mk"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+* Register model
+*******************************************************************************/
+typedef enum
+{
+    SIM_REG_INTR3 = 0,
+    SIM_REG_INTR3_SET,
+    SIM_REG_INTR3_MASK,
+    SIM_REG_INTR3_MASKED,
+    SIM_REG_UVOV_CTRL,
+    SIM_REG_NCELL_STATUS,
+    SIM_REG_INTR5_STATUS_0,
+    SIM_REG_COUNT
+} sim_reg_id_t;
+
+uint32_t sim_reg_read(const void *reg, sim_reg_id_t id);
+void sim_reg_write(void *reg, sim_reg_id_t id, uint32_t value);
+
+/* One 32-bit register. Reads and writes are forwarded to the model, a
+ * read-modify-write is a read followed by a write as on the bus.
+ */
+template <sim_reg_id_t ID>
+class sim_reg
+{
+public:
+    operator uint32_t() const { return sim_reg_read(this, ID); }
+    sim_reg &operator=(uint32_t value) { sim_reg_write(this, ID, value); return *this; }
+    sim_reg &operator|=(uint32_t value) { return (*this = ((uint32_t)*this | value)); }
+    sim_reg &operator&=(uint32_t value) { return (*this = ((uint32_t)*this & value)); }
+
+private:
+    uint32_t raw;
+};
+
+/* The registers of the USBPD block used by the firmware, in model order */
+typedef struct
+{
+    sim_reg<SIM_REG_INTR3> intr3;                   /* W1C interrupt status */
+    sim_reg<SIM_REG_INTR3_SET> intr3_set;           /* W1S, reads back intr3 */
+    sim_reg<SIM_REG_INTR3_MASK> intr3_mask;
+    sim_reg<SIM_REG_INTR3_MASKED> intr3_masked;     /* intr3 & intr3_mask, read-only */
+    sim_reg<SIM_REG_UVOV_CTRL> uvov_ctrl;
+    sim_reg<SIM_REG_NCELL_STATUS> ncell_status;     /* Unfiltered comparator outputs, read-only */
+    sim_reg<SIM_REG_INTR5_STATUS_0> intr5_status_0; /* Inverted filter outputs, read-only */
+} PDSS_REGS_Type;
+
+typedef PDSS_REGS_Type *PPDSS_REGS_T;
+
+extern PDSS_REGS_Type sim_pdss[];
+
+#define PDSS_INTR3_POS_OV_CHANGED                   (1u << 0)
+#define PDSS_INTR3_POS_UV_CHANGED                   (1u << 1)
+#define PDSS_UVOV_CTRL_PD_UVOV                      (1u << 0)
+#define PDSS_UVOV_CTRL_UVOV_ISO_N                   (1u << 1)
+#define PDSS_UVOV_CTRL_UV_IN_POS                    (8u)
+#define PDSS_UVOV_CTRL_UV_IN_MASK                   (0x3Fu << PDSS_UVOV_CTRL_UV_IN_POS)
+#define PDSS_UVOV_CTRL_OV_IN_POS                    (16u)
+#define PDSS_UVOV_CTRL_OV_IN_MASK                   (0x3Fu << PDSS_UVOV_CTRL_OV_IN_POS)
+#define PDSS_NCELL_STATUS_OV_STATUS                 (1u << 0)
+#define PDSS_NCELL_STATUS_UV_STATUS                 (1u << 1)
+#define PDSS_INTR5_STATUS_0_FILT_UV                 (1u << 0)
+#define PDSS_INTR5_STATUS_0_FILT_OV                 (1u << 1)
+
+/*******************************************************************************
+* Core and system library
+*******************************************************************************/
+typedef enum
+{
+    SysTick_IRQn = -1,
+    srss_interrupt_IRQn = 4,
+    scb_4_interrupt_IRQn = 8,
+    usbpd_0_interrupt_wakeup_IRQn = 12,
+    usbpd_1_interrupt_wakeup_IRQn = 13,
+    SIM_IRQ_COUNT = 16
+} IRQn_Type;
+
+#define CY_ASSERT(x)                do { if (!(x)) { sim_assert_failed(__FILE__, __LINE__); } } while (0)
+#define CY_NOINIT                   __attribute__((section("sim_noinit")))
+#define CY_ALIGN(align)             __attribute__((aligned(align)))
+#define CY_UNUSED_PARAMETER(x)      (void)(x)
+
+void sim_assert_failed(const char *file, int line);
+
+void __enable_irq(void);
+void __disable_irq(void);
+void __DMB(void);
+
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+void Cy_SysLib_Delay(uint32_t milliseconds);
+
+typedef void (*cy_israddress)(void);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS = 0,
+    CY_SYSINT_BAD_PARAM
+} cy_en_sysint_status_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+uint32_t Cy_SysClk_ClkSysGetFrequency(void);
+
+typedef void (*Cy_SysTick_Callback)(void);
+
+typedef enum
+{
+    CY_SYSTICK_CLOCK_SOURCE_CLK_LF = 0,
+    CY_SYSTICK_CLOCK_SOURCE_CLK_CPU
+} cy_en_systick_clock_source_t;
+
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval);
+Cy_SysTick_Callback Cy_SysTick_SetCallback(uint32_t number, Cy_SysTick_Callback function);
+uint32_t Cy_SysTick_GetValue(void);
+
+/*******************************************************************************
+* Watchdog timer, counts the ILO in deep sleep
+*******************************************************************************/
+void Cy_WDT_Enable(void);
+void Cy_WDT_Disable(void);
+uint32_t Cy_WDT_GetCount(void);
+void Cy_WDT_SetMatch(uint32_t match);
+uint32_t Cy_WDT_GetMatch(void);
+uint32_t Cy_WDT_GetInterruptStatus(void);
+void Cy_WDT_ClearInterrupt(void);
+
+/*******************************************************************************
+* Power modes
+*******************************************************************************/
+typedef enum
+{
+    CY_SYSPM_SUCCESS = 0,
+    CY_SYSPM_FAIL
+} cy_en_syspm_status_t;
+
+typedef enum
+{
+    CY_SYSPM_CHECK_READY        = 0x01u,
+    CY_SYSPM_CHECK_FAIL         = 0x02u,
+    CY_SYSPM_BEFORE_TRANSITION  = 0x04u,
+    CY_SYSPM_AFTER_TRANSITION   = 0x08u
+} cy_en_syspm_callback_mode_t;
+
+typedef enum
+{
+    CY_SYSPM_SLEEP = 0,
+    CY_SYSPM_DEEPSLEEP
+} cy_en_syspm_callback_type_t;
+
+typedef struct
+{
+    void *base;
+    void *context;
+} cy_stc_syspm_callback_params_t;
+
+typedef cy_en_syspm_status_t (*Cy_SysPmCallback)(cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode);
+
+typedef struct cy_stc_syspm_callback
+{
+    Cy_SysPmCallback callback;
+    cy_en_syspm_callback_type_t type;
+    uint32_t skipMode;
+    cy_stc_syspm_callback_params_t *callbackParams;
+    struct cy_stc_syspm_callback *prevItm;
+    struct cy_stc_syspm_callback *nextItm;
+} cy_stc_syspm_callback_t;
+
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler);
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void);
+
+/*******************************************************************************
+* GPIO
+*******************************************************************************/
+typedef struct
+{
+    uint32_t out;
+} GPIO_PRT_Type;
+
+void Cy_GPIO_Set(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_Clr(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pinNum);
+
+/*******************************************************************************
+* SCB UART
+*******************************************************************************/
+typedef struct
+{
+    uint32_t id;
+} CySCB_Type;
+
+typedef struct
+{
+    uint32_t baudRate;
+} cy_stc_scb_uart_config_t;
+
+typedef struct
+{
+    uint32_t state;
+} cy_stc_scb_uart_context_t;
+
+typedef enum
+{
+    CY_SCB_UART_SUCCESS = 0,
+    CY_SCB_UART_BAD_PARAM
+} cy_en_scb_uart_status_t;
+
+#define CY_SCB_UART_RX_NO_DATA                      (0xFFFFFFFFUL)
+#define CY_SCB_TX_INTR_LEVEL                        (1u << 0)
+#define CY_SCB_RX_INTR_NOT_EMPTY                    (1u << 2)
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, const cy_stc_scb_uart_config_t *config,
+        cy_stc_scb_uart_context_t *context);
+void Cy_SCB_UART_Enable(CySCB_Type *base);
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data);
+void Cy_SCB_UART_PutString(CySCB_Type *base, char const string[]);
+uint32_t Cy_SCB_UART_Get(CySCB_Type *base);
+uint32_t Cy_SCB_GetFifoSize(CySCB_Type *base);
+void Cy_SCB_SetTxFifoLevel(CySCB_Type *base, uint32_t level);
+void Cy_SCB_SetTxInterruptMask(CySCB_Type *base, uint32_t interruptMask);
+uint32_t Cy_SCB_GetTxInterruptStatusMasked(CySCB_Type *base);
+void Cy_SCB_ClearTxInterrupt(CySCB_Type *base, uint32_t interruptMask);
+void Cy_SCB_SetRxInterruptMask(CySCB_Type *base, uint32_t interruptMask);
+uint32_t Cy_SCB_GetRxInterruptStatusMasked(CySCB_Type *base);
+void Cy_SCB_ClearRxInterrupt(CySCB_Type *base, uint32_t interruptMask);
+cy_en_syspm_status_t Cy_SCB_UART_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+* Flash
+*******************************************************************************/
+/* The simulated flash is the host memory holding the program, the firmware
+ * only writes to rows it reserves itself
+ */
+#define CY_FLASH_BASE                               (0x00000000u)
+#define CY_FLASH_SIZE                               (0x00020000u)
+#define CY_FLASH_SIZEOF_ROW                         (128u)
+
+typedef enum
+{
+    CY_FLASH_DRV_SUCCESS = 0,
+    CY_FLASH_DRV_INVALID_INPUT_PARAMETERS
+} cy_en_flashdrv_status_t;
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t *data);
+
+/*******************************************************************************
+* USBPD
+*******************************************************************************/
+/* Driver features selected by the application DEFINES, as in the PDL */
+#if (defined(VBUS_OVP_ENABLE) && (VBUS_OVP_ENABLE))
+#define PDL_VBUS_OVP_ENABLE                         (1u)
+#endif /* VBUS_OVP_ENABLE */
+#if (defined(VBUS_UVP_ENABLE) && (VBUS_UVP_ENABLE))
+#define PDL_VBUS_UVP_ENABLE                         (1u)
+#endif /* VBUS_UVP_ENABLE */
+
+typedef void (*cy_cb_vbus_fault_t)(void *context, bool compOut);
+
+typedef enum
+{
+    CY_USBPD_VBUS_OVP_MODE_ADC = 0,
+    CY_USBPD_VBUS_OVP_MODE_UVOV,
+    CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL
+} cy_en_usbpd_vbus_ovp_mode_t;
+
+typedef enum
+{
+    CY_USBPD_VBUS_UVP_MODE_ADC = 0,
+    CY_USBPD_VBUS_UVP_MODE_INT_COMP,
+    CY_USBPD_VBUS_UVP_MODE_INT_COMP_AUTOCTRL
+} cy_en_usbpd_vbus_uvp_mode_t;
+
+typedef enum
+{
+    CY_USBPD_VBUS_FILTER_ID_UV = 0,
+    CY_USBPD_VBUS_FILTER_ID_OV
+} cy_en_usbpd_vbus_filter_id_t;
+
+typedef enum
+{
+    CY_USBPD_STAT_SUCCESS = 0,
+    CY_USBPD_STAT_BAD_PARAM
+} cy_en_usbpd_status_t;
+
+typedef enum
+{
+    CY_USBPD_ADC_ID_0 = 0,
+    CY_USBPD_ADC_ID_1
+} cy_en_usbpd_adc_id_t;
+
+typedef enum
+{
+    CY_USBPD_ADC_INPUT_AMUX_A = 0,
+    CY_USBPD_ADC_INPUT_AMUX_B
+} cy_en_usbpd_adc_input_t;
+
+typedef struct
+{
+    uint8_t enable;
+    uint8_t mode;
+    uint8_t threshold;
+    uint8_t debounce;
+    uint8_t retryCount;
+} cy_stc_fault_vbus_ovp_cfg_t;
+
+typedef struct
+{
+    uint8_t enable;
+    uint8_t mode;
+    uint8_t threshold;
+    uint8_t debounce;
+    uint8_t retryCount;
+} cy_stc_fault_vbus_uvp_cfg_t;
+
+typedef struct
+{
+    const cy_stc_fault_vbus_ovp_cfg_t *vbusOvpConfig;
+    const cy_stc_fault_vbus_uvp_cfg_t *vbusUvpConfig;
+} cy_stc_usbpd_config_t;
+
+typedef struct cy_stc_usbpd_context
+{
+    PPDSS_REGS_T base;
+    const cy_stc_usbpd_config_t *usbpdConfig;
+    cy_cb_vbus_fault_t vbusUvpCbk;
+    cy_cb_vbus_fault_t vbusOvpCbk;
+    uint8_t port;
+} cy_stc_usbpd_context_t;
+
+typedef struct
+{
+    uint8_t reserved;
+} cy_stc_pd_dpm_config_t;
+
+typedef struct
+{
+    uint8_t reserved;
+} cy_stc_usbpd_trim_t;
+
+#define GET_VBUS_OVP_TABLE(context)                 ((context)->usbpdConfig->vbusOvpConfig)
+#define GET_VBUS_UVP_TABLE(context)                 ((context)->usbpdConfig->vbusUvpConfig)
+#define CY_USBPD_GET_MIN(a, b)                      (((a) < (b)) ? (a) : (b))
+#define CY_USBPD_GET_MAX(a, b)                      (((a) > (b)) ? (a) : (b))
+
+cy_en_usbpd_status_t Cy_USBPD_Init(cy_stc_usbpd_context_t *context, uint8_t port, void *base,
+        void *trimsConfig, cy_stc_usbpd_config_t *usbpdConfig,
+        cy_stc_pd_dpm_config_t *(*dpmGetConfig)(void));
+void Cy_USBPD_Intr1Handler(cy_stc_usbpd_context_t *context);
+bool Cy_USBPD_SystemDeepSleep(cy_stc_usbpd_context_t *context);
+bool Cy_USBPD_SystemWakeup(cy_stc_usbpd_context_t *context);
+
+void Cy_USBPD_Fault_Vbus_OvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt,
+        cy_cb_vbus_fault_t cb, bool pctrl);
+void Cy_USBPD_Fault_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt,
+        cy_cb_vbus_fault_t cb, bool pctrl);
+void Cy_USBPD_Fault_Vbus_OvpIntrHandler(cy_stc_usbpd_context_t *context);
+bool Cy_USBPD_Fault_FetAutoModeEnable(cy_stc_usbpd_context_t *context, bool pctrl,
+        cy_en_usbpd_vbus_filter_id_t filterIndex);
+void Cy_USBPD_Fault_FetAutoModeDisable(cy_stc_usbpd_context_t *context, bool pctrl,
+        cy_en_usbpd_vbus_filter_id_t filterIndex);
+void Cy_USBPD_Vbus_GdrvPfetOn(cy_stc_usbpd_context_t *context, bool turnOnSeq);
+void Cy_USBPD_Vbus_GdrvPfetOff(cy_stc_usbpd_context_t *context, bool turnOffSeq);
+
+cy_en_usbpd_status_t Cy_USBPD_Adc_Init(cy_stc_usbpd_context_t *context, cy_en_usbpd_adc_id_t adcId);
+uint8_t Cy_USBPD_Adc_Sample(cy_stc_usbpd_context_t *context, cy_en_usbpd_adc_id_t adcId,
+        cy_en_usbpd_adc_input_t input);
+uint16_t Cy_USBPD_Adc_GetVbusVolt(cy_stc_usbpd_context_t *context, cy_en_usbpd_adc_id_t adcId,
+        uint8_t level);
+
+#endif /* _SIM_CY_PDL_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name: tools/host_sim/sim/cybsp.h
+*
+* Description: Host simulator replacement of the board support header for the PMG1 MCU
+*              Using UVOV Blocks Code Example. Maps the board resources used by the
+*              firmware to the simulated peripherals.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _SIM_CYBSP_H_
+#define _SIM_CYBSP_H_
+
+#include "cy_pdl.h"
+
+/*
+ * The simulated board has the USBPD port 0 of every PMG1 kit. Building with
+ * SIM_PORT1 adds the second port of the dual-port parts, which the firmware
+ * detects through mtb_usbpd_port1_HW as it does with the generated
+ * configuration.
+ */
+
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS                             ((cy_rslt_t)0x00000000U)
+
+cy_rslt_t cybsp_init(void);
+
+/* User LED, driven low to light */
+extern GPIO_PRT_Type sim_led_port;
+#define CYBSP_USER_LED_PORT                         (&sim_led_port)
+#define CYBSP_USER_LED_PIN                          (0u)
+
+/* Debug UART */
+extern CySCB_Type sim_uart_scb;
+extern const cy_stc_scb_uart_config_t CYBSP_UART_config;
+#define CYBSP_UART_HW                               (&sim_uart_scb)
+#define CYBSP_UART_IRQ                              (scb_4_interrupt_IRQn)
+
+/* USBPD port 0, the configuration is the RAM object set up by the test */
+extern const cy_stc_usbpd_config_t mtb_usbpd_port0_config;
+#define mtb_usbpd_port0_HW                          (&sim_pdss[0])
+#define mtb_usbpd_port0_HW_TRIM                     (NULL)
+#define mtb_usbpd_port0_DS_IRQ                      (usbpd_0_interrupt_wakeup_IRQn)
+
+#ifdef SIM_PORT1
+extern const cy_stc_usbpd_config_t mtb_usbpd_port1_config;
+#define mtb_usbpd_port1_HW                          (&sim_pdss[1])
+#define mtb_usbpd_port1_HW_TRIM                     (NULL)
+#define mtb_usbpd_port1_DS_IRQ                      (usbpd_1_interrupt_wakeup_IRQn)
+#endif /* SIM_PORT1 */
+
+#endif /* _SIM_CYBSP_H_ */
+
+/* [] END OF FILE */
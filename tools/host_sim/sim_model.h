@@ -0,0 +1,151 @@
+/******************************************************************************
+* File Name: tools/host_sim/sim_model.h
+*
+* Description: Internal state of the host simulator of the PMG1 MCU Using UVOV Blocks
+*              Code Example, shared between the core and the PDL models.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _SIM_MODEL_H_
+#define _SIM_MODEL_H_
+
+#include "host_sim.h"
+
+/* Cost in CPU cycles of the modelled operations */
+#define SIM_CYCLES_REG              (4u)    /* USBPD register access over the AHB bridge */
+#define SIM_CYCLES_CALL             (20u)   /* Call into a PDL function, small body */
+#define SIM_CYCLES_BARRIER          (30u)   /* __DMB(), carries the loop body without PDL calls */
+#define SIM_CYCLES_IRQ_ENTRY        (16u)   /* Exception entry of the Cortex-M0+ */
+#define SIM_CYCLES_IRQ_EXIT         (12u)
+#define SIM_CYCLES_ADC_SAMPLE       (240u)  /* One SAR conversion with the PDL overhead */
+#define SIM_WAKEUP_US               (35u)   /* Deep sleep exit to the first instruction */
+
+/* Thread mode priority, below every interrupt */
+#define SIM_PRIO_THREAD             (4u)
+
+/* UART FIFO depth of the SCB */
+#define SIM_UART_FIFO_SIZE          (8u)
+
+/* One comparator with its debounce filter */
+typedef struct
+{
+    bool raw;                       /* Unfiltered comparator output */
+    bool out;                       /* Filtered output */
+    bool change;                    /* A raw change waits for the filter */
+    uint64_t due;                   /* Cycle at which the waiting change reaches the output */
+    bool auto_fet;                  /* The output turns the provider FET off */
+
+    /* State of the PDL driver on the devices other than PMG1-S2 */
+    bool enabled;
+    bool intr;
+    uint16_t thr_mv;
+} sim_comp_t;
+
+typedef struct
+{
+    uint32_t intr3;
+    uint32_t intr3_mask;
+    uint32_t uvov_ctrl;
+    sim_comp_t comp[2];
+    uint16_t vbus;
+    const sim_sample_t *trace;
+    size_t trace_len;
+    size_t trace_idx;
+    uint64_t trace_start;
+    bool adc_frozen;                /* The ADC reads adc_mv instead of VBUS */
+    uint16_t adc_mv;
+    bool fet_on;
+    cy_stc_usbpd_context_t *context;
+} sim_port_t;
+
+extern sim_port_t sim_port[SIM_PORT_COUNT];
+
+/* Advances the time by the cost of an operation, takes the pending
+ * interrupts and returns to the test when the run has ended
+ */
+void sim_tick(uint32_t cycles);
+
+/* Advances the time without taking interrupts, e.g. while the CPU is stalled */
+void sim_advance(uint64_t until);
+
+/* Comparator model */
+void sim_comp_eval(uint8_t port);
+void sim_fet_set(uint8_t port, bool on);
+void sim_notify(sim_evt_kind_t kind, uint8_t port, uint8_t comp, uint32_t value);
+uint8_t sim_port_of(const cy_stc_usbpd_context_t *context);
+
+/* Interrupt controller */
+void sim_primask_set(bool set);
+bool sim_primask_get(void);
+void sim_irq_register(IRQn_Type irq, uint32_t prio, cy_israddress isr);
+void sim_irq_enable(IRQn_Type irq, bool enable);
+bool sim_in_firmware(void);
+
+/* Deep sleep, returns when a wake-up interrupt is pending */
+void sim_deep_sleep(void);
+
+/* SysTick */
+void sim_systick_init(uint32_t reload);
+uint32_t sim_systick_value(void);
+extern Cy_SysTick_Callback sim_systick_cb[5];
+
+/* WDT */
+void sim_wdt_enable(bool enable);
+uint32_t sim_wdt_count(void);
+void sim_wdt_match(uint32_t match);
+uint32_t sim_wdt_get_match(void);
+bool sim_wdt_intr(void);
+void sim_wdt_clear(void);
+
+/* UART */
+bool sim_uart_put(uint8_t data);
+uint32_t sim_uart_get(void);
+void sim_uart_tx_level(uint32_t level);
+void sim_uart_tx_mask(uint32_t mask);
+void sim_uart_rx_mask(uint32_t mask);
+uint32_t sim_uart_tx_status(void);
+uint32_t sim_uart_rx_status(void);
+bool sim_uart_tx_idle(void);
+
+/* Flash */
+void sim_flash_write(uint32_t addr, const void *data);
+
+/* GPIO */
+extern bool sim_led_level;
+
+#endif /* _SIM_MODEL_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,771 @@
+/******************************************************************************
+* File Name: tools/host_sim/sim_pdl.cpp
+*
+* Description: PDL models of the host simulator of the PMG1 MCU Using UVOV Blocks Code
+*              Example. Implements the PDL functions used by the firmware on top of the
+*              peripheral models of host_sim.cpp.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "sim_model.h"
+#include "cybsp.h"
+
+/*
+ * The USBPD fault functions follow the register sequences of the PDL for
+ * PMG1-S2. On the other devices the UV/OV block is owned by the PDL and is
+ * modelled at the level of the driver: a threshold in mV, an enable and a
+ * pending interrupt per comparator.
+ */
+
+/*******************************************************************************
+* Board configuration
+*******************************************************************************/
+cy_stc_fault_vbus_ovp_cfg_t sim_ovp_config[SIM_PORT_COUNT] =
+{
+    { 1u, CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL, 30u, 10u, 2u },
+#ifdef SIM_PORT1
+    { 1u, CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL, 30u, 10u, 2u },
+#endif /* SIM_PORT1 */
+};
+
+cy_stc_fault_vbus_uvp_cfg_t sim_uvp_config[SIM_PORT_COUNT] =
+{
+    { 1u, CY_USBPD_VBUS_UVP_MODE_INT_COMP_AUTOCTRL, 70u, 10u, 2u },
+#ifdef SIM_PORT1
+    { 1u, CY_USBPD_VBUS_UVP_MODE_INT_COMP_AUTOCTRL, 70u, 10u, 2u },
+#endif /* SIM_PORT1 */
+};
+
+const cy_stc_usbpd_config_t mtb_usbpd_port0_config =
+{
+    .vbusOvpConfig = &sim_ovp_config[0],
+    .vbusUvpConfig = &sim_uvp_config[0],
+};
+
+#ifdef SIM_PORT1
+const cy_stc_usbpd_config_t mtb_usbpd_port1_config =
+{
+    .vbusOvpConfig = &sim_ovp_config[1],
+    .vbusUvpConfig = &sim_uvp_config[1],
+};
+#endif /* SIM_PORT1 */
+
+GPIO_PRT_Type sim_led_port;
+CySCB_Type sim_uart_scb;
+const cy_stc_scb_uart_config_t CYBSP_UART_config = { .baudRate = 115200u };
+
+cy_rslt_t cybsp_init(void)
+{
+    sim_tick(SIM_CYCLES_CALL);
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Core and system library
+*******************************************************************************/
+void __enable_irq(void)
+{
+    sim_primask_set(false);
+    sim_tick(1u);
+}
+
+void __disable_irq(void)
+{
+    sim_tick(1u);
+    sim_primask_set(true);
+}
+
+void __DMB(void)
+{
+    sim_tick(SIM_CYCLES_BARRIER);
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    uint32_t state = sim_primask_get() ? 1u : 0u;
+
+    sim_tick(SIM_CYCLES_CALL / 2u);
+    sim_primask_set(true);
+    return state;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    sim_primask_set(savedIntrStatus != 0u);
+    sim_tick(SIM_CYCLES_CALL / 2u);
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    sim_tick((uint32_t)microseconds * SIM_CYCLES_PER_US);
+}
+
+/* Ticks a millisecond at a time so the interrupts are taken and a run ends
+ * during a long delay
+ */
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+    while (milliseconds-- != 0u)
+    {
+        sim_tick(1000u * SIM_CYCLES_PER_US);
+    }
+}
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr)
+{
+    if ((config->intrSrc < 0) || (config->intrSrc >= SIM_IRQ_COUNT) || (config->intrPriority > 3u))
+    {
+        return CY_SYSINT_BAD_PARAM;
+    }
+    sim_irq_register(config->intrSrc, config->intrPriority, userIsr);
+    sim_tick(SIM_CYCLES_CALL);
+    return CY_SYSINT_SUCCESS;
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    sim_irq_enable(IRQn, true);
+    sim_tick(SIM_CYCLES_REG);
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    sim_irq_enable(IRQn, false);
+    sim_tick(SIM_CYCLES_REG);
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    (void)IRQn;
+    sim_tick(SIM_CYCLES_REG);
+}
+
+uint32_t Cy_SysClk_ClkSysGetFrequency(void)
+{
+    sim_tick(SIM_CYCLES_CALL);
+    return SIM_CPU_HZ;
+}
+
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval)
+{
+    (void)clockSource;
+    sim_systick_init(interval);
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+Cy_SysTick_Callback Cy_SysTick_SetCallback(uint32_t number, Cy_SysTick_Callback function)
+{
+    Cy_SysTick_Callback prev = sim_systick_cb[number];
+
+    sim_systick_cb[number] = function;
+    sim_tick(SIM_CYCLES_CALL);
+    return prev;
+}
+
+uint32_t Cy_SysTick_GetValue(void)
+{
+    sim_tick(SIM_CYCLES_REG);
+    return sim_systick_value();
+}
+
+/*******************************************************************************
+* WDT
+*******************************************************************************/
+void Cy_WDT_Enable(void)
+{
+    sim_wdt_enable(true);
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+void Cy_WDT_Disable(void)
+{
+    sim_wdt_enable(false);
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+uint32_t Cy_WDT_GetCount(void)
+{
+    sim_tick(SIM_CYCLES_REG);
+    return sim_wdt_count();
+}
+
+void Cy_WDT_SetMatch(uint32_t match)
+{
+    sim_wdt_match(match);
+    sim_tick(SIM_CYCLES_REG);
+}
+
+uint32_t Cy_WDT_GetMatch(void)
+{
+    sim_tick(SIM_CYCLES_REG);
+    return sim_wdt_get_match();
+}
+
+uint32_t Cy_WDT_GetInterruptStatus(void)
+{
+    sim_tick(SIM_CYCLES_REG);
+    return sim_wdt_intr() ? 1u : 0u;
+}
+
+void Cy_WDT_ClearInterrupt(void)
+{
+    sim_wdt_clear();
+    sim_tick(SIM_CYCLES_REG);
+}
+
+/*******************************************************************************
+* Power modes
+*******************************************************************************/
+static cy_stc_syspm_callback_t *sim_syspm_first;
+
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler)
+{
+    cy_stc_syspm_callback_t *last = sim_syspm_first;
+
+    handler->nextItm = NULL;
+    handler->prevItm = NULL;
+    if (last == NULL)
+    {
+        sim_syspm_first = handler;
+    }
+    else
+    {
+        while (last->nextItm != NULL)
+        {
+            last = last->nextItm;
+        }
+        last->nextItm = handler;
+        handler->prevItm = last;
+    }
+    sim_tick(SIM_CYCLES_CALL);
+    return true;
+}
+
+/* Calls the deep sleep callbacks in registration order, the ones after the
+ * transition in reverse order. Returns the callback that failed.
+ */
+static cy_stc_syspm_callback_t *sim_syspm_call(cy_en_syspm_callback_mode_t mode)
+{
+    cy_stc_syspm_callback_t *cb = sim_syspm_first;
+
+    if (mode == CY_SYSPM_AFTER_TRANSITION)
+    {
+        while ((cb != NULL) && (cb->nextItm != NULL))
+        {
+            cb = cb->nextItm;
+        }
+        for (; cb != NULL; cb = cb->prevItm)
+        {
+            (void)cb->callback(cb->callbackParams, mode);
+        }
+        return NULL;
+    }
+    for (; cb != NULL; cb = cb->nextItm)
+    {
+        if ((cb->type == CY_SYSPM_DEEPSLEEP) && (cb->callback(cb->callbackParams, mode) != CY_SYSPM_SUCCESS))
+        {
+            return cb;
+        }
+    }
+    return NULL;
+}
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void)
+{
+    cy_stc_syspm_callback_t *failed;
+    cy_stc_syspm_callback_t *cb;
+    uint32_t state = Cy_SysLib_EnterCriticalSection();
+
+    failed = sim_syspm_call(CY_SYSPM_CHECK_READY);
+    if (failed != NULL)
+    {
+        for (cb = sim_syspm_first; cb != failed; cb = cb->nextItm)
+        {
+            (void)cb->callback(cb->callbackParams, CY_SYSPM_CHECK_FAIL);
+        }
+        Cy_SysLib_ExitCriticalSection(state);
+        return CY_SYSPM_FAIL;
+    }
+    (void)sim_syspm_call(CY_SYSPM_BEFORE_TRANSITION);
+    sim_deep_sleep();
+    (void)sim_syspm_call(CY_SYSPM_AFTER_TRANSITION);
+    Cy_SysLib_ExitCriticalSection(state);
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* GPIO
+*******************************************************************************/
+void Cy_GPIO_Set(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    (void)pinNum;
+    sim_led_level = true;
+    sim_tick(SIM_CYCLES_REG);
+}
+
+void Cy_GPIO_Clr(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    (void)pinNum;
+    sim_led_level = false;
+    sim_tick(SIM_CYCLES_REG);
+}
+
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    (void)pinNum;
+    sim_led_level = !sim_led_level;
+    sim_tick(SIM_CYCLES_REG);
+}
+
+/*******************************************************************************
+* SCB UART
+*******************************************************************************/
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, const cy_stc_scb_uart_config_t *config,
+        cy_stc_scb_uart_context_t *context)
+{
+    (void)base;
+    (void)config;
+    (void)context;
+    sim_tick(SIM_CYCLES_CALL);
+    return CY_SCB_UART_SUCCESS;
+}
+
+void Cy_SCB_UART_Enable(CySCB_Type *base)
+{
+    (void)base;
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data)
+{
+    uint32_t put = sim_uart_put((uint8_t)data) ? 1u : 0u;
+
+    (void)base;
+    sim_tick(SIM_CYCLES_REG);
+    return put;
+}
+
+/* Blocks until the string is in the TX FIFO, as the PDL does */
+void Cy_SCB_UART_PutString(CySCB_Type *base, char const string[])
+{
+    uint32_t idx;
+
+    for (idx = 0; string[idx] != '\0'; idx++)
+    {
+        while (Cy_SCB_UART_Put(base, (uint32_t)string[idx]) == 0u)
+        {
+        }
+    }
+}
+
+uint32_t Cy_SCB_UART_Get(CySCB_Type *base)
+{
+    (void)base;
+    sim_tick(SIM_CYCLES_REG);
+    return sim_uart_get();
+}
+
+uint32_t Cy_SCB_GetFifoSize(CySCB_Type *base)
+{
+    (void)base;
+    return SIM_UART_FIFO_SIZE;
+}
+
+void Cy_SCB_SetTxFifoLevel(CySCB_Type *base, uint32_t level)
+{
+    (void)base;
+    sim_uart_tx_level(level);
+    sim_tick(SIM_CYCLES_REG);
+}
+
+void Cy_SCB_SetTxInterruptMask(CySCB_Type *base, uint32_t interruptMask)
+{
+    (void)base;
+    sim_uart_tx_mask(interruptMask);
+    sim_tick(SIM_CYCLES_REG);
+}
+
+uint32_t Cy_SCB_GetTxInterruptStatusMasked(CySCB_Type *base)
+{
+    (void)base;
+    sim_tick(SIM_CYCLES_REG);
+    return sim_uart_tx_status();
+}
+
+void Cy_SCB_ClearTxInterrupt(CySCB_Type *base, uint32_t interruptMask)
+{
+    /* The level trigger is set again while the condition holds */
+    (void)base;
+    (void)interruptMask;
+    sim_tick(SIM_CYCLES_REG);
+}
+
+void Cy_SCB_SetRxInterruptMask(CySCB_Type *base, uint32_t interruptMask)
+{
+    (void)base;
+    sim_uart_rx_mask(interruptMask);
+    sim_tick(SIM_CYCLES_REG);
+}
+
+uint32_t Cy_SCB_GetRxInterruptStatusMasked(CySCB_Type *base)
+{
+    (void)base;
+    sim_tick(SIM_CYCLES_REG);
+    return sim_uart_rx_status();
+}
+
+void Cy_SCB_ClearRxInterrupt(CySCB_Type *base, uint32_t interruptMask)
+{
+    (void)base;
+    (void)interruptMask;
+    sim_tick(SIM_CYCLES_REG);
+}
+
+cy_en_syspm_status_t Cy_SCB_UART_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams,
+        cy_en_syspm_callback_mode_t mode)
+{
+    (void)callbackParams;
+    sim_tick(SIM_CYCLES_CALL);
+    if ((mode == CY_SYSPM_CHECK_READY) && !sim_uart_tx_idle())
+    {
+        return CY_SYSPM_FAIL;
+    }
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* Flash
+*******************************************************************************/
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t *data)
+{
+    if ((rowAddr % CY_FLASH_SIZEOF_ROW) != 0u)
+    {
+        return CY_FLASH_DRV_INVALID_INPUT_PARAMETERS;
+    }
+
+    /* The SROM call stalls the CPU, interrupts wait until it returns */
+    sim_advance(sim_cycles() + ((uint64_t)sim_param.flash_write_us * SIM_CYCLES_PER_US));
+    sim_flash_write(rowAddr, data);
+    sim_tick(SIM_CYCLES_CALL);
+    return CY_FLASH_DRV_SUCCESS;
+}
+
+/*******************************************************************************
+* USBPD
+*******************************************************************************/
+cy_en_usbpd_status_t Cy_USBPD_Init(cy_stc_usbpd_context_t *context, uint8_t port, void *base,
+        void *trimsConfig, cy_stc_usbpd_config_t *usbpdConfig,
+        cy_stc_pd_dpm_config_t *(*dpmGetConfig)(void))
+{
+    (void)trimsConfig;
+    (void)dpmGetConfig;
+    if ((port >= SIM_PORT_COUNT) || (base != (void *)&sim_pdss[port]))
+    {
+        return CY_USBPD_STAT_BAD_PARAM;
+    }
+    context->base = (PPDSS_REGS_T)base;
+    context->port = port;
+    context->usbpdConfig = usbpdConfig;
+    sim_port[port].context = context;
+    sim_tick(SIM_CYCLES_CALL);
+    return CY_USBPD_STAT_SUCCESS;
+}
+
+bool Cy_USBPD_SystemDeepSleep(cy_stc_usbpd_context_t *context)
+{
+    (void)context;
+    sim_tick(SIM_CYCLES_CALL);
+    return true;
+}
+
+bool Cy_USBPD_SystemWakeup(cy_stc_usbpd_context_t *context)
+{
+    (void)context;
+    sim_tick(SIM_CYCLES_CALL);
+    return true;
+}
+
+bool Cy_USBPD_Fault_FetAutoModeEnable(cy_stc_usbpd_context_t *context, bool pctrl,
+        cy_en_usbpd_vbus_filter_id_t filterIndex)
+{
+    uint8_t port = sim_port_of(context);
+    uint8_t comp = (filterIndex == CY_USBPD_VBUS_FILTER_ID_OV) ? SIM_COMP_OV : SIM_COMP_UV;
+
+    (void)pctrl;
+    sim_port[port].comp[comp].auto_fet = true;
+    if (sim_port[port].comp[comp].out)
+    {
+        sim_fet_set(port, false);
+    }
+    sim_tick(SIM_CYCLES_CALL);
+    return true;
+}
+
+void Cy_USBPD_Fault_FetAutoModeDisable(cy_stc_usbpd_context_t *context, bool pctrl,
+        cy_en_usbpd_vbus_filter_id_t filterIndex)
+{
+    uint8_t port = sim_port_of(context);
+    uint8_t comp = (filterIndex == CY_USBPD_VBUS_FILTER_ID_OV) ? SIM_COMP_OV : SIM_COMP_UV;
+
+    (void)pctrl;
+    sim_port[port].comp[comp].auto_fet = false;
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+void Cy_USBPD_Vbus_GdrvPfetOn(cy_stc_usbpd_context_t *context, bool turnOnSeq)
+{
+    (void)turnOnSeq;
+    sim_fet_set(sim_port_of(context), true);
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+void Cy_USBPD_Vbus_GdrvPfetOff(cy_stc_usbpd_context_t *context, bool turnOffSeq)
+{
+    (void)turnOffSeq;
+    sim_fet_set(sim_port_of(context), false);
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+/* OV ladder code of a threshold in mV, rounded up as the PDL does */
+static uint32_t sim_ov_code(uint32_t thr)
+{
+    uint32_t code;
+
+    if (thr <= 2750u)
+    {
+        return 0u;
+    }
+    if (thr <= 9000u)
+    {
+        code = (thr - 2750u + 249u) / 250u;
+    }
+    else
+    {
+        code = 25u + ((thr - 9000u + 499u) / 500u);
+    }
+    return (code > 63u) ? 63u : code;
+}
+
+/* PMG1-S2 register sequence of the PDL: the OV ladder is not used below 6 V,
+ * the FET auto control is suspended while the reference changes and the new
+ * threshold settles for 10 us before the status is checked.
+ */
+void Cy_USBPD_Fault_Vbus_OvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt,
+        cy_cb_vbus_fault_t cb, bool pctrl)
+{
+    PPDSS_REGS_T pd = context->base;
+    uint32_t thr = (uint32_t)volt + (((uint32_t)volt * GET_VBUS_OVP_TABLE(context)->threshold) / 100u);
+    uint32_t code = sim_ov_code(thr);
+    uint32_t regVal;
+
+    sim_tick(SIM_CYCLES_CALL * 4u);
+    if (code < 13u)
+    {
+        code = 13u;
+    }
+    context->vbusOvpCbk = cb;
+    if (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL)
+    {
+        Cy_USBPD_Fault_FetAutoModeDisable(context, pctrl, CY_USBPD_VBUS_FILTER_ID_OV);
+    }
+    pd->intr3 = PDSS_INTR3_POS_OV_CHANGED;
+    regVal = pd->uvov_ctrl & ~(PDSS_UVOV_CTRL_OV_IN_MASK | PDSS_UVOV_CTRL_PD_UVOV);
+    pd->uvov_ctrl = (code << PDSS_UVOV_CTRL_OV_IN_POS) | regVal | PDSS_UVOV_CTRL_UVOV_ISO_N;
+    if (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL)
+    {
+        Cy_USBPD_Fault_FetAutoModeEnable(context, pctrl, CY_USBPD_VBUS_FILTER_ID_OV);
+        Cy_SysLib_DelayUs(10u);
+    }
+    if ((pd->ncell_status & PDSS_NCELL_STATUS_OV_STATUS) != 0u)
+    {
+        pd->intr3_set = PDSS_INTR3_POS_OV_CHANGED;
+    }
+    pd->intr3_mask |= PDSS_INTR3_POS_OV_CHANGED;
+}
+
+void Cy_USBPD_Fault_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt,
+        cy_cb_vbus_fault_t cb, bool pctrl)
+{
+    /* Not supported by the PDL on PMG1-S2, see PMG1S2_Vbus_UvpEnable() */
+    (void)context;
+    (void)volt;
+    (void)cb;
+    (void)pctrl;
+    sim_check_failed(__FILE__, __LINE__, "Cy_USBPD_Fault_Vbus_UvpEnable on PMG1-S2");
+}
+
+void Cy_USBPD_Fault_Vbus_OvpIntrHandler(cy_stc_usbpd_context_t *context)
+{
+    sim_tick(SIM_CYCLES_CALL);
+    if (context->vbusOvpCbk != NULL)
+    {
+        context->vbusOvpCbk(context, true);
+    }
+}
+
+void Cy_USBPD_Intr1Handler(cy_stc_usbpd_context_t *context)
+{
+    /* PMG1-S2 reports UV/OV on INTR3, handled by PMG1S2_USBPD_Intr1Handler() */
+    (void)context;
+    sim_tick(SIM_CYCLES_CALL);
+}
+#else
+/* Arms a comparator of the PDL driver model */
+static void sim_comp_arm(cy_stc_usbpd_context_t *context, uint8_t comp, uint16_t thr, bool autoCtrl, bool pctrl)
+{
+    uint8_t port = sim_port_of(context);
+    sim_comp_t *c = &sim_port[port].comp[comp];
+    cy_en_usbpd_vbus_filter_id_t id = (comp == SIM_COMP_OV) ? CY_USBPD_VBUS_FILTER_ID_OV : CY_USBPD_VBUS_FILTER_ID_UV;
+
+    sim_tick(SIM_CYCLES_CALL * 8u);
+    if (autoCtrl)
+    {
+        Cy_USBPD_Fault_FetAutoModeDisable(context, pctrl, id);
+    }
+    c->intr = false;
+    c->thr_mv = thr;
+    c->enabled = true;
+    sim_comp_eval(port);
+    if (autoCtrl)
+    {
+        Cy_USBPD_Fault_FetAutoModeEnable(context, pctrl, id);
+    }
+
+    /* An output already above the threshold raises the interrupt */
+    if (c->raw)
+    {
+        c->intr = true;
+    }
+    sim_notify(SIM_EVT_ARM, port, comp, thr);
+    sim_tick(SIM_CYCLES_REG);
+}
+
+void Cy_USBPD_Fault_Vbus_OvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt,
+        cy_cb_vbus_fault_t cb, bool pctrl)
+{
+    uint32_t thr = (uint32_t)volt + (((uint32_t)volt * GET_VBUS_OVP_TABLE(context)->threshold) / 100u);
+
+    context->vbusOvpCbk = cb;
+    sim_comp_arm(context, SIM_COMP_OV, (uint16_t)thr,
+            (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL), pctrl);
+}
+
+void Cy_USBPD_Fault_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt,
+        cy_cb_vbus_fault_t cb, bool pctrl)
+{
+    uint32_t thr = ((uint32_t)volt * GET_VBUS_UVP_TABLE(context)->threshold) / 100u;
+
+    context->vbusUvpCbk = cb;
+    sim_comp_arm(context, SIM_COMP_UV, (uint16_t)thr,
+            (GET_VBUS_UVP_TABLE(context)->mode == CY_USBPD_VBUS_UVP_MODE_INT_COMP_AUTOCTRL), pctrl);
+}
+
+void Cy_USBPD_Fault_Vbus_OvpIntrHandler(cy_stc_usbpd_context_t *context)
+{
+    (void)context;
+    sim_tick(SIM_CYCLES_CALL);
+}
+
+/* The PDL disables a comparator that fired and calls its callback */
+void Cy_USBPD_Intr1Handler(cy_stc_usbpd_context_t *context)
+{
+    uint8_t port = sim_port_of(context);
+    sim_comp_t *ov = &sim_port[port].comp[SIM_COMP_OV];
+    sim_comp_t *uv = &sim_port[port].comp[SIM_COMP_UV];
+
+    sim_tick(SIM_CYCLES_CALL * 2u);
+    if (ov->enabled && ov->intr)
+    {
+        sim_notify(SIM_EVT_ACK, port, SIM_COMP_OV, ov->thr_mv);
+        ov->enabled = false;
+        ov->intr = false;
+        sim_tick(SIM_CYCLES_REG * 2u);
+        if (context->vbusOvpCbk != NULL)
+        {
+            context->vbusOvpCbk(context, true);
+        }
+    }
+    if (uv->enabled && uv->intr)
+    {
+        sim_notify(SIM_EVT_ACK, port, SIM_COMP_UV, uv->thr_mv);
+        uv->enabled = false;
+        uv->intr = false;
+        sim_tick(SIM_CYCLES_REG * 2u);
+        if (context->vbusUvpCbk != NULL)
+        {
+            context->vbusUvpCbk(context, true);
+        }
+    }
+}
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+/*******************************************************************************
+* ADC
+*******************************************************************************/
+cy_en_usbpd_status_t Cy_USBPD_Adc_Init(cy_stc_usbpd_context_t *context, cy_en_usbpd_adc_id_t adcId)
+{
+    (void)context;
+    (void)adcId;
+    sim_tick(SIM_CYCLES_CALL);
+    return CY_USBPD_STAT_SUCCESS;
+}
+
+uint8_t Cy_USBPD_Adc_Sample(cy_stc_usbpd_context_t *context, cy_en_usbpd_adc_id_t adcId,
+        cy_en_usbpd_adc_input_t input)
+{
+    sim_port_t *p = &sim_port[sim_port_of(context)];
+    uint32_t level = ((uint32_t)(p->adc_frozen ? p->adc_mv : p->vbus) * 255u) / sim_param.adc_full_mv;
+
+    (void)adcId;
+    (void)input;
+    sim_tick(SIM_CYCLES_ADC_SAMPLE);
+    return (uint8_t)((level > 255u) ? 255u : level);
+}
+
+uint16_t Cy_USBPD_Adc_GetVbusVolt(cy_stc_usbpd_context_t *context, cy_en_usbpd_adc_id_t adcId,
+        uint8_t level)
+{
+    (void)context;
+    (void)adcId;
+    sim_tick(SIM_CYCLES_CALL);
+    return (uint16_t)(((uint32_t)level * sim_param.adc_full_mv) / 255u);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,197 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/bench_fault_path.cpp
+*
+* Description: Host simulator benchmark of the PMG1-S2 fault path functions of the PMG1
+*              MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*
+ * Reports per call the modelled CPU cycles (PDL and register cost of the
+ * simulator, see host_sim.h) and the host time of the code under test
+ * together with the model. The host time tracks changes in the amount of
+ * work done on a path; it is not a measurement of the device.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "host_sim.h"
+#include "cybsp.h"
+#include "uvov.h"
+#include "vbus_ladder.h"
+
+#define BENCH_CALLS                 (100000u)
+
+static cy_stc_usbpd_context_t bench_context;
+
+static void bench_cb(void *context, bool compOut)
+{
+    (void)context;
+    (void)compOut;
+}
+
+static uint64_t bench_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_report(const char *name, uint64_t cycles, uint64_t ns)
+{
+    printf("%-36s %8.1f cycles %8.1f ns\n", name, (double)cycles / BENCH_CALLS, (double)ns / BENCH_CALLS);
+}
+
+static void bench_uvp_enable(void)
+{
+    uint64_t cycles = sim_cycles();
+    uint64_t ns = bench_ns();
+    uint32_t idx;
+
+    for (idx = 0; idx < BENCH_CALLS; idx++)
+    {
+        (void)PMG1S2_Vbus_UvpEnable(&bench_context, 5000u, bench_cb, true);
+    }
+    bench_report("PMG1S2_Vbus_UvpEnable", sim_cycles() - cycles, bench_ns() - ns);
+
+    cycles = sim_cycles();
+    ns = bench_ns();
+    for (idx = 0; idx < BENCH_CALLS; idx++)
+    {
+        PMG1S2_Vbus_UvpEnableComplete(&bench_context);
+    }
+    bench_report("PMG1S2_Vbus_UvpEnableComplete", sim_cycles() - cycles, bench_ns() - ns);
+}
+
+static void bench_dispatch(const char *name, uint32_t sources)
+{
+    PPDSS_REGS_T pd = bench_context.base;
+    uint64_t cycles = 0u;
+    uint64_t ns = 0u;
+    uint64_t start;
+    uint64_t start_ns;
+    uint32_t idx;
+
+    for (idx = 0; idx < BENCH_CALLS; idx++)
+    {
+        pd->intr3_mask = sources;
+        pd->intr3_set = sources;
+        start = sim_cycles();
+        start_ns = bench_ns();
+        PMG1S2_USBPD_Intr1Handler(&bench_context);
+        cycles += sim_cycles() - start;
+        ns += bench_ns() - start_ns;
+    }
+    bench_report(name, cycles, ns);
+}
+
+static void bench_level_get(void)
+{
+    uint64_t ns = bench_ns();
+    uint32_t idx;
+    volatile uint8_t level;
+
+    for (idx = 0; idx < BENCH_CALLS; idx++)
+    {
+        level = PMG1S2_Vbus_UvLevelGet((uint16_t)(2750u + (idx % 18750u)));
+    }
+    (void)level;
+    bench_report("PMG1S2_Vbus_UvLevelGet", 0u, bench_ns() - ns);
+}
+
+#if VBUS_LADDER_ENABLE
+static void bench_irq_off_report(const char *name)
+{
+    printf("%-36s %8llu cycles %8.2f us\n", name, (unsigned long long)sim_stats.irq_off_max,
+            (double)sim_stats.irq_off_max / SIM_CYCLES_PER_US);
+}
+
+/* One probe per call, as run by the ladder task */
+static void bench_uv_search_step(void)
+{
+    PMG1S2_UvSearch_t search;
+    uint64_t cycles = sim_cycles();
+    uint64_t ns = bench_ns();
+    uint32_t idx;
+
+    sim_stats.irq_off_max = 0u;
+    PMG1S2_Vbus_UvSearchStart(&search);
+    for (idx = 0; idx < BENCH_CALLS; idx++)
+    {
+        if (PMG1S2_Vbus_UvSearchStep(&bench_context, &search, true))
+        {
+            PMG1S2_Vbus_UvSearchStart(&search);
+        }
+    }
+    bench_report("PMG1S2_Vbus_UvSearchStep", sim_cycles() - cycles, bench_ns() - ns);
+    bench_irq_off_report("UV search step, irq off max");
+}
+
+/* The firmware over two estimates: longest interval with interrupts off */
+static void bench_ladder_firmware(void)
+{
+    sim_boot(NULL);
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(20000u);
+
+    sim_stats.irq_off_max = 0u;
+    sim_run_us(2u * VBUS_LADDER_PERIOD_MS * 1000u);
+    bench_irq_off_report("Firmware with ladder, irq off max");
+}
+#endif /* VBUS_LADDER_ENABLE */
+
+int main(void)
+{
+    (void)Cy_USBPD_Init(&bench_context, 0u, mtb_usbpd_port0_HW, NULL,
+            (cy_stc_usbpd_config_t *)&mtb_usbpd_port0_config, NULL);
+    PMG1S2_USBPD_Intr1Init();
+    bench_context.vbusOvpCbk = bench_cb;
+    bench_context.vbusUvpCbk = bench_cb;
+    sim_vbus_set(0u, 5000u);
+
+    bench_uvp_enable();
+    bench_dispatch("PMG1S2_USBPD_Intr1Handler (1 source)", PDSS_INTR3_POS_UV_CHANGED);
+    bench_dispatch("PMG1S2_USBPD_Intr1Handler (2 sources)", PDSS_INTR3_POS_UV_CHANGED | PDSS_INTR3_POS_OV_CHANGED);
+    bench_level_get();
+#if VBUS_LADDER_ENABLE
+    bench_uv_search_step();
+    bench_ladder_firmware();
+#endif /* VBUS_LADDER_ENABLE */
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/bench_irq_off.cpp
+*
+* Description: Host simulator measurement of the longest interrupts-disabled
+*              time of the fault handling of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+/*
+ * Runs the firmware through OVP and UVP trips and recoveries and reports the
+ * longest time with PRIMASK set in each phase, in modelled CPU cycles and us
+ * at 48 MHz. The UVP re-arm is also run as it was before the settle check
+ * was deferred: level set, 10 us busy-wait and completion in one critical
+ * section. The numbers come from the cost model of the simulator (see
+ * host_sim.h), not from the device.
+ */
+
+#include <stdio.h>
+#include "host_sim.h"
+#include "cybsp.h"
+#include "uvov.h"
+
+static void bench_report(const char *name, uint64_t cycles)
+{
+    printf("%-40s %6llu cycles %6.2f us\n", name, (unsigned long long)cycles,
+            (double)cycles / SIM_CYCLES_PER_US);
+}
+
+/* Runs the firmware with VBUS at a level and reports the longest interval */
+static void bench_phase(const char *name, uint16_t vbus_mv, uint32_t run_us)
+{
+    sim_stats.irq_off_max = 0u;
+    sim_vbus_set(0u, vbus_mv);
+    sim_run_us(run_us);
+    bench_report(name, sim_stats.irq_off_max);
+}
+
+static void bench_cb(void *context, bool compOut)
+{
+    (void)context;
+    (void)compOut;
+}
+
+/* The UVP re-arm in one critical section, with the settle busy-wait */
+static void bench_uvp_inline(void)
+{
+    cy_stc_usbpd_context_t context;
+    uint32_t intr_state;
+
+    (void)Cy_USBPD_Init(&context, 0u, mtb_usbpd_port0_HW, NULL,
+            (cy_stc_usbpd_config_t *)&mtb_usbpd_port0_config, NULL);
+    sim_vbus_set(0u, 5000u);
+
+    sim_stats.irq_off_max = 0u;
+    intr_state = Cy_SysLib_EnterCriticalSection();
+    if (PMG1S2_Vbus_UvpEnable(&context, 5000u, bench_cb, true))
+    {
+        Cy_SysLib_DelayUs(UVP_SETTLE_TIME_US);
+        PMG1S2_Vbus_UvpEnableComplete(&context);
+    }
+    Cy_SysLib_ExitCriticalSection(intr_state);
+    bench_report("UVP re-arm, settle check inline", sim_stats.irq_off_max);
+}
+
+int main(void)
+{
+    sim_boot(NULL);
+    sim_run_us(20000u);
+
+    /* Firmware fault handling with the deferred settle check */
+    bench_phase("OVP trip", 7000u, 5000u);
+    bench_phase("OVP recovery", 5000u, 50000u);
+    bench_phase("UVP trip", 3000u, 5000u);
+    bench_phase("UVP recovery", 5000u, 50000u);
+
+    bench_uvp_inline();
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,288 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_dvdt.cpp
+*
+* Description: Host test of the per-port dV/dt overvoltage predictor of the PMG1
+*              MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "host_sim.h"
+#include "uvov_profile.h"
+#include "vbus_dvdt.h"
+
+void vbus_set_contract(uint8_t port, uint16_t volt);
+
+/* Period of the generated VBUS ramps */
+#define TEST_RAMP_STEP_US           (100u)
+
+/* Longest generated VBUS ramp */
+#define TEST_RAMP_MAX               (1024u)
+
+/* FET switches, VBUS and time at the first turn-off per port */
+static uint32_t test_fet_off[SIM_PORT_COUNT];
+static uint32_t test_fet_on[SIM_PORT_COUNT];
+static uint16_t test_off_vbus[SIM_PORT_COUNT];
+static uint64_t test_off_us[SIM_PORT_COUNT];
+
+static sim_sample_t test_ramp[TEST_RAMP_MAX];
+
+static void test_observer(const sim_evt_t *evt)
+{
+    if (evt->kind != SIM_EVT_FET)
+    {
+        return;
+    }
+    if (evt->value == 0u)
+    {
+        if (test_fet_off[evt->port] == 0u)
+        {
+            test_off_vbus[evt->port] = sim_vbus_get(evt->port);
+            test_off_us[evt->port] = evt->cycle / SIM_CYCLES_PER_US;
+        }
+        test_fet_off[evt->port]++;
+    }
+    else
+    {
+        test_fet_on[evt->port]++;
+    }
+}
+
+/* Starts a linear VBUS ramp on a port, in mV per ms */
+static void test_ramp_start(uint8_t port, uint16_t from, uint16_t to, uint16_t slope)
+{
+    uint32_t count = ((((uint32_t)to - from) * 1000u) / slope) / TEST_RAMP_STEP_US;
+    uint32_t idx;
+
+    SIM_CHECK((count > 0u) && (count <= TEST_RAMP_MAX));
+    for (idx = 0u; idx < count; idx++)
+    {
+        test_ramp[idx].time_us = (uint64_t)(idx + 1u) * TEST_RAMP_STEP_US;
+        test_ramp[idx].vbus_mv = (uint16_t)(from + ((((uint32_t)to - from) * (idx + 1u)) / count));
+    }
+    sim_vbus_trace(port, test_ramp, count);
+}
+
+static void test_boot(void)
+{
+    sim_observe(test_observer);
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    SIM_CHECK(sim_fet_on(0u));
+    SIM_CHECK(sim_fet_on(1u));
+}
+
+/* A fast rise on port 1 that stops below the trip threshold: port 1 turns
+ * its FET off ahead of the comparator and on again once the OVP channel is
+ * back to NORMAL, port 0 is not affected
+ */
+static void test_port1_false_alarm(void)
+{
+    test_boot();
+    test_ramp_start(1u, 5000u, 6000u, 500u);
+    sim_run_us(5000u);
+    SIM_CHECK(test_fet_off[1] == 1u);
+    SIM_CHECK(test_off_vbus[1] < sim_comp_threshold_mv(1u, SIM_COMP_OV));
+    SIM_CHECK(test_fet_off[0] == 0u);
+
+    sim_run_us(50000u);
+    SIM_CHECK(sim_fet_on(1u));
+    SIM_CHECK(test_fet_on[1] == 1u);
+    SIM_CHECK(sim_fet_on(0u));
+}
+
+/* Both ports ramp together, each predictor acts on its own port */
+static void test_both_ports(void)
+{
+    static sim_sample_t ramp1[TEST_RAMP_MAX];
+
+    test_boot();
+    test_ramp_start(0u, 5000u, 6000u, 500u);
+    memcpy(ramp1, test_ramp, sizeof(ramp1));
+    sim_vbus_trace(1u, ramp1, 20u);
+    sim_run_us(5000u);
+    SIM_CHECK(test_fet_off[0] == 1u);
+    SIM_CHECK(test_fet_off[1] == 1u);
+    sim_run_us(50000u);
+    SIM_CHECK(sim_fet_on(0u));
+    SIM_CHECK(sim_fet_on(1u));
+}
+
+/* After a new contract the slope is projected to the new trip threshold: a
+ * 200 mV/ms rise at 9 V is only acted on within the lead time of the 9 V
+ * threshold, not at the 5 V one
+ */
+static void test_contract_9v(void)
+{
+    uint16_t trip;
+
+    test_boot();
+
+    /* Slow rise to 6.4 V, inside the limits of both the 5 V and the 9 V
+     * contract, then on to 9 V
+     */
+    test_ramp_start(0u, 5000u, 6400u, 50u);
+    sim_run_us(40000u);
+    vbus_set_contract(0u, 9000u);
+    test_ramp_start(0u, 6400u, 9000u, 50u);
+    sim_run_us(60000u);
+    SIM_CHECK(sim_vbus_trace_done(0u));
+    trip = uvov_profile_get(0u, 9000u)->ov_trip_volt;
+    SIM_CHECK(sim_comp_threshold_mv(0u, SIM_COMP_OV) == trip);
+    SIM_CHECK(test_fet_off[0] == 0u);
+
+    test_ramp_start(0u, 9000u, 13000u, 200u);
+    sim_run_us(30000u);
+    SIM_CHECK(test_fet_off[0] >= 1u);
+    printf("  9 V contract: FET off at %u mV, trip %u mV\n", (unsigned)test_off_vbus[0], (unsigned)trip);
+    SIM_CHECK(test_off_vbus[0] < trip);
+    SIM_CHECK(test_off_vbus[0] >= (trip - (VBUS_DVDT_LEAD_MS * 2u * 200u)));
+}
+
+/* The predictor turns the FET off ahead of the comparator alone. Both ports
+ * see the same 200 mV/ms ramp through the 9 V trip threshold, 3 V above the
+ * contract so the slope filter has settled; the ADC of port 1 is held, so
+ * its predictor sees no slope and only the comparator acts there. The ramp
+ * starts phase_us after a 1 ms boundary, moving the predictor samples along it.
+ */
+static void test_lead_time(uint32_t phase_us)
+{
+    static sim_sample_t ramp1[TEST_RAMP_MAX];
+    uint16_t trip;
+    uint64_t lead;
+
+    /* Both ports move to 9 V through 6.4 V, inside the limits of both
+     * contracts: port 1 in steps with its ADC held, port 0 below the minimum
+     * slope
+     */
+    test_boot();
+    sim_adc_freeze(1u, true);
+    sim_vbus_set(1u, 6400u);
+    test_ramp_start(0u, 5000u, 6400u, 50u);
+    sim_run_us(40000u);
+    vbus_set_contract(0u, 9000u);
+    vbus_set_contract(1u, 9000u);
+    sim_vbus_set(1u, 9000u);
+    test_ramp_start(0u, 6400u, 9000u, 50u);
+    sim_run_us(60000u);
+    SIM_CHECK(sim_vbus_trace_done(0u));
+    SIM_CHECK((test_fet_off[0] == 0u) && (test_fet_off[1] == 0u));
+
+    sim_run_us(phase_us);
+    test_ramp_start(0u, 9000u, 13000u, 200u);
+    memcpy(ramp1, test_ramp, sizeof(ramp1));
+    sim_vbus_trace(1u, ramp1, ((13000u - 9000u) * 1000u / 200u) / TEST_RAMP_STEP_US);
+    sim_run_us(30000u);
+    SIM_CHECK(test_fet_off[0] >= 1u);
+    SIM_CHECK(test_fet_off[1] >= 1u);
+    trip = uvov_profile_get(1u, 9000u)->ov_trip_volt;
+    SIM_CHECK(test_off_vbus[0] < trip);
+    SIM_CHECK(test_off_vbus[1] >= trip);
+    SIM_CHECK(test_off_us[0] < test_off_us[1]);
+
+    lead = test_off_us[1] - test_off_us[0];
+    printf("  200 mV/ms at 9 V, phase %u us: FET off %llu us ahead of the comparator\n",
+           (unsigned)phase_us, (unsigned long long)lead);
+    SIM_CHECK(lead >= ((VBUS_DVDT_LEAD_MS - VBUS_DVDT_PERIOD_MS) * 1000u));
+}
+
+static void test_lead_time_0(void)
+{
+    test_lead_time(0u);
+}
+
+static void test_lead_time_250(void)
+{
+    test_lead_time(250u);
+}
+
+static void test_lead_time_500(void)
+{
+    test_lead_time(500u);
+}
+
+static void test_lead_time_750(void)
+{
+    test_lead_time(750u);
+}
+
+/* A threshold change through the shell moves the predictor to the new trip
+ * level as well
+ */
+static void test_shell_set_ovp(void)
+{
+    const uint8_t *data;
+    size_t len;
+    uint16_t trip;
+
+    test_boot();
+    sim_uart_tx_clear();
+    sim_uart_rx("set 0 ovp 50 10\r");
+    sim_run_us(50000u);
+    len = sim_uart_tx(&data);
+    SIM_CHECK(std::string((const char *)data, len).find("OK\r\n") != std::string::npos);
+    trip = uvov_profile_get(0u, 5000u)->ov_trip_volt;
+    SIM_CHECK(trip > 7000u);
+    SIM_CHECK(sim_comp_threshold_mv(0u, SIM_COMP_OV) == trip);
+
+    test_ramp_start(0u, 5000u, 9000u, 200u);
+    sim_run_us(30000u);
+    SIM_CHECK(test_fet_off[0] >= 1u);
+    SIM_CHECK(test_off_vbus[0] < trip);
+    SIM_CHECK(test_off_vbus[0] >= (trip - (VBUS_DVDT_LEAD_MS * 2u * 200u)));
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "port1_false_alarm", test_port1_false_alarm },
+    { "both_ports", test_both_ports },
+    { "contract_9v", test_contract_9v },
+    { "lead_time_0", test_lead_time_0 },
+    { "lead_time_250", test_lead_time_250 },
+    { "lead_time_500", test_lead_time_500 },
+    { "lead_time_750", test_lead_time_750 },
+    { "shell_set_ovp", test_shell_set_ovp },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("dvdt", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
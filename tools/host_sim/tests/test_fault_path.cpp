@@ -0,0 +1,247 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_fault_path.cpp
+*
+* Description: Host simulator test of the UV/OV fault path of the PMG1 MCU Using UVOV
+*              Blocks Code Example: trip, hysteresis and recovery of both channels.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "host_sim.h"
+#include "fault_event.h"
+
+/* Thresholds of the 5 V contract with the default configuration, 30 % */
+#define TEST_OV_TRIP_MV             (6500u)
+#define TEST_UV_TRIP_MV             (3500u)
+
+/* Threshold armed first, last threshold armed and the interrupts taken at
+ * the first one per comparator
+ */
+static uint32_t test_trip[2];
+static uint32_t test_armed[2];
+static uint32_t test_trips[2];
+
+static void test_observer(const sim_evt_t *evt)
+{
+    if (evt->port != 0u)
+    {
+        return;
+    }
+    if (evt->kind == SIM_EVT_ARM)
+    {
+        if (test_trip[evt->comp] == 0u)
+        {
+            test_trip[evt->comp] = evt->value;
+        }
+        test_armed[evt->comp] = evt->value;
+    }
+    else if ((evt->kind == SIM_EVT_ACK) && (test_trip[evt->comp] != 0u) &&
+             (evt->value == test_trip[evt->comp]))
+    {
+        test_trips[evt->comp]++;
+    }
+}
+
+static void test_boot(void)
+{
+    sim_observe(test_observer);
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_UV));
+    SIM_CHECK(sim_fet_on(0u));
+}
+
+static void test_ovp_trip_recover(void)
+{
+    test_boot();
+    SIM_CHECK(sim_comp_threshold_mv(0u, SIM_COMP_OV) == TEST_OV_TRIP_MV);
+
+    /* Overvoltage: the hardware turns the FET off, the firmware records the
+     * event and arms the lower hysteresis threshold
+     */
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 1u);
+    SIM_CHECK(fault_event_get_stats()->count[FAULT_TYPE_OVP] >= 1u);
+    SIM_CHECK(!sim_fet_on(0u));
+    SIM_CHECK(test_armed[SIM_COMP_OV] < test_trip[SIM_COMP_OV]);
+    sim_run_us(50000u);
+
+    /* Back to 5 V: the trip threshold is armed again */
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(50000u);
+    SIM_CHECK(test_armed[SIM_COMP_OV] == test_trip[SIM_COMP_OV]);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 1u);
+    SIM_CHECK(fault_event_get_stats()->count[FAULT_TYPE_UVP] == 0u);
+
+    /* The LED is on while VBUS is normal */
+    SIM_CHECK(sim_led_on());
+
+    /* The channel trips again on the next overvoltage */
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 2u);
+}
+
+static void test_uvp_trip_recover(void)
+{
+    test_boot();
+    SIM_CHECK(sim_comp_threshold_mv(0u, SIM_COMP_UV) == TEST_UV_TRIP_MV);
+
+    /* The UV threshold of PMG1-S2 is armed after the settle delay */
+    sim_vbus_set(0u, 3000u);
+    sim_run_us(5000u);
+    SIM_CHECK(test_trips[SIM_COMP_UV] == 1u);
+    SIM_CHECK(!sim_fet_on(0u));
+    SIM_CHECK(test_armed[SIM_COMP_UV] > test_trip[SIM_COMP_UV]);
+
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(50000u);
+    SIM_CHECK(test_armed[SIM_COMP_UV] == test_trip[SIM_COMP_UV]);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_UV));
+    SIM_CHECK(test_trips[SIM_COMP_UV] == 1u);
+    SIM_CHECK(fault_event_get_stats()->count[FAULT_TYPE_OVP] == 0u);
+}
+
+/* A fault that persists after the trip is reported once, not once per poll:
+ * one event at the trip threshold and one when the hysteresis threshold is
+ * armed while VBUS is still beyond it
+ */
+static void test_fault_held(void)
+{
+    test_boot();
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(200000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 1u);
+    SIM_CHECK(fault_event_get_stats()->count[FAULT_TYPE_OVP] == 2u);
+    SIM_CHECK(sim_comp_out(0u, SIM_COMP_OV));
+}
+
+/* A spike shorter than the debounce filter (10 cycles -> 5 filter clocks, 10 us) */
+static void test_glitch_filtered(void)
+{
+    test_boot();
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(6u);
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(10000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 0u);
+    SIM_CHECK(sim_fet_on(0u));
+
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(12u);
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(10000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 1u);
+}
+
+/* A fault present while the comparator is armed at boot is reported */
+static void test_fault_at_boot(void)
+{
+    sim_param.vbus_mv[0] = 7000u;
+    sim_observe(test_observer);
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 1u);
+    SIM_CHECK(!sim_fet_on(0u));
+}
+
+/* Any OVP mode other than "HW controlled FET OFF" selects the software FET
+ * control: the fault callback turns the FET off and the FET is turned back on
+ * once both channels are normal again
+ */
+static void test_boot_sw(void)
+{
+    sim_ovp_config[0].mode = CY_USBPD_VBUS_OVP_MODE_UVOV;
+    sim_uvp_config[0].mode = CY_USBPD_VBUS_UVP_MODE_INT_COMP;
+    test_boot();
+}
+
+static void test_sw_fet_ovp(void)
+{
+    test_boot_sw();
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 1u);
+    SIM_CHECK(!sim_fet_on(0u));
+    sim_run_us(50000u);
+    SIM_CHECK(!sim_fet_on(0u));
+
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(50000u);
+    SIM_CHECK(test_armed[SIM_COMP_OV] == test_trip[SIM_COMP_OV]);
+    SIM_CHECK(sim_fet_on(0u));
+
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    SIM_CHECK(test_trips[SIM_COMP_OV] == 2u);
+    SIM_CHECK(!sim_fet_on(0u));
+}
+
+static void test_sw_fet_uvp(void)
+{
+    test_boot_sw();
+    sim_vbus_set(0u, 3000u);
+    sim_run_us(5000u);
+    SIM_CHECK(test_trips[SIM_COMP_UV] == 1u);
+    SIM_CHECK(!sim_fet_on(0u));
+
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(50000u);
+    SIM_CHECK(test_armed[SIM_COMP_UV] == test_trip[SIM_COMP_UV]);
+    SIM_CHECK(sim_fet_on(0u));
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "ovp_trip_recover", test_ovp_trip_recover },
+    { "uvp_trip_recover", test_uvp_trip_recover },
+    { "fault_held", test_fault_held },
+    { "glitch_filtered", test_glitch_filtered },
+    { "fault_at_boot", test_fault_at_boot },
+    { "sw_fet_ovp", test_sw_fet_ovp },
+    { "sw_fet_uvp", test_sw_fet_uvp },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("fault_path", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,133 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_fault_storm.cpp
+*
+* Description: Host test of the fault storm window of the PMG1 MCU Using UVOV
+*              Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "host_sim.h"
+#include "fault_storm.h"
+
+/* Start time of the trip sequences, away from 0 so a cleared slot is not
+ * inside the window
+ */
+#define TEST_START_MS               (100000u)
+
+/* Trip interval that puts FAULT_STORM_TRIPS trips just inside the window */
+#define TEST_INSIDE_MS              ((FAULT_STORM_WINDOW_MS - 1u) / (FAULT_STORM_TRIPS - 1u))
+
+/* Runs FAULT_STORM_TRIPS trips from start, interval ms apart, and returns the
+ * trip that entered the storm, 0 if none did
+ */
+static uint32_t test_burst(fault_storm_t *storm, uint32_t start, uint32_t interval)
+{
+    uint32_t trip;
+
+    for (trip = 1u; trip <= FAULT_STORM_TRIPS; trip++)
+    {
+        if (fault_storm_trip(storm, start + ((trip - 1u) * interval)) == FAULT_STORM_ENTER)
+        {
+            return trip;
+        }
+    }
+    return 0u;
+}
+
+/* Exactly FAULT_STORM_TRIPS trips inside the window enter the storm at the last one */
+static void test_trips_inside(void)
+{
+    fault_storm_t storm;
+
+    memset(&storm, 0, sizeof(storm));
+    SIM_CHECK(test_burst(&storm, TEST_START_MS, TEST_INSIDE_MS) == FAULT_STORM_TRIPS);
+    SIM_CHECK(fault_storm_active(&storm));
+}
+
+/* FAULT_STORM_TRIPS trips spanning the full window are not a storm; the
+ * next trip inside the window of the last FAULT_STORM_TRIPS is
+ */
+static void test_trips_straddling(void)
+{
+    fault_storm_t storm;
+    uint32_t last;
+    uint32_t trip;
+
+    memset(&storm, 0, sizeof(storm));
+    for (trip = 0u; trip < (FAULT_STORM_TRIPS - 1u); trip++)
+    {
+        SIM_CHECK(fault_storm_trip(&storm, TEST_START_MS + (trip * TEST_INSIDE_MS)) == FAULT_STORM_NONE);
+    }
+    SIM_CHECK(fault_storm_trip(&storm, TEST_START_MS + FAULT_STORM_WINDOW_MS) == FAULT_STORM_NONE);
+    SIM_CHECK(!fault_storm_active(&storm));
+
+    last = TEST_START_MS + FAULT_STORM_WINDOW_MS;
+    SIM_CHECK(fault_storm_trip(&storm, last + 1u) == FAULT_STORM_ENTER);
+}
+
+/* The trips of a storm that ended do not count towards the next one */
+static void test_trips_after_exit(void)
+{
+    fault_storm_t storm;
+    uint32_t now;
+
+    memset(&storm, 0, sizeof(storm));
+    SIM_CHECK(test_burst(&storm, TEST_START_MS, 1u) == FAULT_STORM_TRIPS);
+
+    /* Quiet until the storm is over */
+    now = storm.rearm_at + FAULT_STORM_WINDOW_MS + (FAULT_STORM_BACKOFF_MS << (storm.level - 1u));
+    SIM_CHECK(fault_storm_update(&storm, now) == FAULT_STORM_EXIT);
+
+    /* A new burst needs FAULT_STORM_TRIPS trips of its own */
+    SIM_CHECK(test_burst(&storm, now, 1u) == FAULT_STORM_TRIPS);
+    SIM_CHECK(storm.entries == 2u);
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "trips_inside", test_trips_inside },
+    { "trips_straddling", test_trips_straddling },
+    { "trips_after_exit", test_trips_after_exit },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("fault_storm", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,195 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_flight_rec.cpp
+*
+* Description: Host simulator test of the reset-surviving fault flight recorder
+*              and of its flash commit of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "host_sim.h"
+#include "flight_rec.h"
+
+/* Overvoltage pulses: trips spaced out so no fault storm is entered */
+#define TEST_PULSE_US               (3000u)
+#define TEST_GAP_US                 (30000u)
+
+/* Flash writes and the VBUS level at each */
+static uint32_t test_flash_writes;
+static uint16_t test_flash_vbus;
+static uint64_t test_flash_us;
+
+/* State kept across the boots of a scenario */
+static sim_nv_t *test_nv;
+
+static void test_observer(const sim_evt_t *evt)
+{
+    if (evt->kind == SIM_EVT_FLASH)
+    {
+        test_flash_writes++;
+        test_flash_vbus = (test_flash_vbus > sim_vbus_get(0u)) ? test_flash_vbus : sim_vbus_get(0u);
+        test_flash_us = sim_time_us();
+    }
+}
+
+static void test_boot(const sim_nv_t *nv)
+{
+    sim_observe(test_observer);
+    sim_boot(nv);
+    sim_run_us(20000u);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+}
+
+static void test_ov_pulses(uint32_t count)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        sim_vbus_set(0u, 7000u);
+        sim_run_us(TEST_PULSE_US);
+        sim_vbus_set(0u, 5000u);
+        sim_run_us(TEST_GAP_US);
+    }
+}
+
+/* The flash row is written once FLIGHT_REC_COMMIT_EVENTS faults are recorded,
+ * not before the last fault has cleared
+ */
+static void test_commit_when_quiet(void)
+{
+    uint64_t cleared;
+
+    test_boot(NULL);
+    test_ov_pulses(FLIGHT_REC_COMMIT_EVENTS - 1u);
+    SIM_CHECK(test_flash_writes == 0u);
+
+    /* The last fault is held, the commit waits for it */
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(500000u);
+    SIM_CHECK(flight_rec_get()->total == FLIGHT_REC_COMMIT_EVENTS);
+    SIM_CHECK(test_flash_writes == 0u);
+
+    sim_vbus_set(0u, 5000u);
+    cleared = sim_time_us();
+    sim_run_us(100000u);
+    SIM_CHECK(test_flash_writes == 1u);
+    SIM_CHECK(test_flash_vbus == 5000u);
+    SIM_CHECK(test_flash_us > cleared);
+}
+
+/* Records FLIGHT_REC_COMMIT_EVENTS + 1 faults, one of them after the commit */
+static void test_record(void)
+{
+    test_boot(NULL);
+    test_ov_pulses(FLIGHT_REC_COMMIT_EVENTS);
+    sim_run_us(100000u);
+    SIM_CHECK(test_flash_writes == 1u);
+    test_ov_pulses(1u);
+    SIM_CHECK(flight_rec_get()->total == (FLIGHT_REC_COMMIT_EVENTS + 1u));
+    sim_save_nv(test_nv);
+}
+
+/* Boots from the saved state and checks the records and boot count kept */
+static uint32_t test_expect_total;
+static uint32_t test_expect_boots;
+
+static void test_reboot(void)
+{
+    test_boot(test_nv);
+    if ((flight_rec_get()->total != test_expect_total) || (flight_rec_get()->boots != test_expect_boots))
+    {
+        fprintf(stderr, "total %u boots %u, expected %u %u\n", (unsigned)flight_rec_get()->total,
+                (unsigned)flight_rec_get()->boots, (unsigned)test_expect_total, (unsigned)test_expect_boots);
+        SIM_CHECK(false);
+    }
+}
+
+static void test_reboot_expect(uint32_t total, uint32_t boots)
+{
+    test_expect_total = total;
+    test_expect_boots = boots;
+    SIM_CHECK(sim_fork(test_reboot) == 0);
+}
+
+static void test_reset_restore(void)
+{
+    sim_nv_t saved;
+
+    test_nv = (sim_nv_t *)mmap(NULL, sizeof(sim_nv_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    SIM_CHECK(test_nv != MAP_FAILED);
+    SIM_CHECK(sim_fork(test_record) == 0);
+    SIM_CHECK(test_nv->row_count == 1u);
+    SIM_CHECK(test_nv->noinit_size == sizeof(flight_rec_t));
+    saved = *test_nv;
+
+    /* Reset: the RAM image is valid and newer than the flash one */
+    test_reboot_expect(FLIGHT_REC_COMMIT_EVENTS + 1u, 2u);
+
+    /* Power-on: the RAM image is noise, the flash one is used */
+    test_nv->noinit_size = 0u;
+    test_reboot_expect(FLIGHT_REC_COMMIT_EVENTS, 2u);
+
+    /* Reset with a corrupted record in RAM: the CRC rejects it */
+    *test_nv = saved;
+    test_nv->noinit[offsetof(flight_rec_t, entry)] ^= 0x01u;
+    test_reboot_expect(FLIGHT_REC_COMMIT_EVENTS, 2u);
+
+    /* Corrupted flash row as well: the recorder starts over */
+    test_nv->row[0][offsetof(flight_rec_t, entry)] ^= 0x01u;
+    test_reboot_expect(0u, 1u);
+
+    /* Corrupted flash row only: the RAM image is used */
+    *test_nv = saved;
+    test_nv->row[0][offsetof(flight_rec_t, entry)] ^= 0x01u;
+    test_reboot_expect(FLIGHT_REC_COMMIT_EVENTS + 1u, 2u);
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "commit_when_quiet", test_commit_when_quiet },
+    { "reset_restore", test_reset_restore },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("flight_rec", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
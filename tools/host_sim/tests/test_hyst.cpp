@@ -0,0 +1,182 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_hyst.cpp
+*
+* Description: Host test of the ladder-aware hysteresis bands of the PMG1 MCU
+*              Using UVOV Blocks Code Example across the PD contract voltages.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "host_sim.h"
+
+void vbus_set_contract(uint8_t port, uint16_t volt);
+
+/* Comparator steps of the hysteresis bands, HYST_OVP_STEPS and HYST_UVP_STEPS */
+#define TEST_HYST_STEPS             (1u)
+
+/* Lowest OV ladder code, 6 V */
+#define TEST_OV_CODE_6V0            (13u)
+
+/* Fixed PDO contract voltages */
+static const uint16_t test_contracts[] = { 5000u, 9000u, 15000u, 20000u };
+
+/* Trip threshold of the band under test, last threshold armed and the
+ * interrupts taken at the trip threshold per comparator, in the form of
+ * sim_comp_level()
+ */
+static uint32_t test_trip[2];
+static uint32_t test_armed[2];
+static uint32_t test_trips[2];
+
+static void test_observer(const sim_evt_t *evt)
+{
+    if (evt->port != 0u)
+    {
+        return;
+    }
+    if (evt->kind == SIM_EVT_ARM)
+    {
+        test_armed[evt->comp] = evt->value;
+    }
+    else if ((evt->kind == SIM_EVT_ACK) && (evt->value == test_trip[evt->comp]))
+    {
+        test_trips[evt->comp]++;
+    }
+}
+
+/* Trips a comparator, checks that the hysteresis threshold is armed on the
+ * right side of the trip threshold and holds while VBUS stays inside the
+ * band, then recovers at the contract voltage
+ */
+static void test_band(uint16_t volt, uint8_t comp)
+{
+    uint32_t trip_mv = sim_comp_threshold_mv(0u, comp);
+    uint32_t hyst_mv;
+    uint32_t hyst;
+
+    test_trip[comp] = sim_comp_level(0u, comp);
+    test_trips[comp] = 0u;
+    sim_vbus_set(0u, (uint16_t)((comp == SIM_COMP_OV) ? (trip_mv + 100u) : (trip_mv - 100u)));
+    /* The UV threshold of PMG1-S2 is armed after the settle delay */
+    sim_run_us(5000u);
+    SIM_CHECK(test_trips[comp] == 1u);
+    hyst = test_armed[comp];
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    hyst_mv = sim_ladder_mv(hyst);
+#else
+    hyst_mv = hyst;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+    printf("  %5u mV %s: trip %5u mV, hysteresis %5u mV\n", (unsigned)volt,
+            (comp == SIM_COMP_OV) ? "OV" : "UV", (unsigned)trip_mv, (unsigned)hyst_mv);
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    /* One ladder code apart, never below the 6 V floor of the OV ladder */
+    if (comp == SIM_COMP_OV)
+    {
+        SIM_CHECK(hyst == (test_trip[comp] - TEST_HYST_STEPS));
+        SIM_CHECK(hyst >= TEST_OV_CODE_6V0);
+    }
+    else
+    {
+        SIM_CHECK(hyst == (test_trip[comp] + TEST_HYST_STEPS));
+    }
+    SIM_CHECK((comp == SIM_COMP_OV) ? (hyst_mv < trip_mv) : (hyst_mv > trip_mv));
+
+    /* Inside the band the hysteresis threshold stays armed */
+    sim_vbus_set(0u, (uint16_t)((hyst_mv + trip_mv) / 2u));
+    sim_run_us(50000u);
+    SIM_CHECK(test_armed[comp] == hyst);
+    SIM_CHECK(test_trips[comp] == 1u);
+#else
+    /* The PDL model powers a comparator down once it fired, so only the
+     * threshold it was armed with is checked
+     */
+    SIM_CHECK((comp == SIM_COMP_OV) ? (hyst_mv < trip_mv) : (hyst_mv > trip_mv));
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+    /* Back to the contract voltage: the trip threshold is armed again */
+    sim_vbus_set(0u, volt);
+    sim_run_us(50000u);
+    SIM_CHECK(test_armed[comp] == test_trip[comp]);
+    SIM_CHECK(test_trips[comp] == 1u);
+}
+
+/* Every contract voltage gets a hysteresis band of the configured width with
+ * an OVP threshold percentage
+ */
+static void test_contracts_at(uint8_t percent)
+{
+    size_t idx;
+
+    sim_ovp_config[0].threshold = percent;
+    sim_observe(test_observer);
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    for (idx = 0u; idx < (sizeof(test_contracts) / sizeof(test_contracts[0])); idx++)
+    {
+        vbus_set_contract(0u, test_contracts[idx]);
+        sim_vbus_set(0u, test_contracts[idx]);
+        sim_run_us(20000u);
+        SIM_CHECK(sim_comp_threshold_mv(0u, SIM_COMP_OV) > test_contracts[idx]);
+        SIM_CHECK(sim_comp_threshold_mv(0u, SIM_COMP_UV) < test_contracts[idx]);
+        test_band(test_contracts[idx], SIM_COMP_OV);
+        test_band(test_contracts[idx], SIM_COMP_UV);
+    }
+}
+
+/* 20 %: the 5 V trip threshold is at the bottom of the OV ladder, 6 V */
+static void test_ovp_20(void)
+{
+    test_contracts_at(20u);
+}
+
+static void test_ovp_30(void)
+{
+    test_contracts_at(30u);
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "ovp_20_percent", test_ovp_20 },
+    { "ovp_30_percent", test_ovp_30 },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("hyst", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
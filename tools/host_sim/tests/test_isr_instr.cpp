@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_isr_instr.cpp
+*
+* Description: Host simulator test of the interrupt timing instrumentation and its
+*              UART shell command of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "host_sim.h"
+#include "isr_instr.h"
+
+static void test_boot(void)
+{
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+}
+
+/* Sends a shell command and returns the reply */
+static std::string test_shell(const char *cmd)
+{
+    const uint8_t *data;
+    size_t len;
+
+    sim_uart_tx_clear();
+    sim_uart_rx(cmd);
+    sim_run_us(50000u);
+    len = sim_uart_tx(&data);
+    return std::string((const char *)data, len);
+}
+
+/* One OVP interrupt is recorded, dispatch before exit */
+static void test_ovp_recorded(void)
+{
+    const isr_instr_t *instr = isr_instr_get();
+
+    test_boot();
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+
+    SIM_CHECK(instr->dispatch[FAULT_TYPE_OVP].count >= 1u);
+    SIM_CHECK(instr->duration[FAULT_TYPE_OVP].count == instr->dispatch[FAULT_TYPE_OVP].count);
+    SIM_CHECK(instr->dispatch[FAULT_TYPE_OVP].max > 0u);
+    SIM_CHECK(instr->dispatch[FAULT_TYPE_OVP].max <= instr->duration[FAULT_TYPE_OVP].max);
+    SIM_CHECK(instr->dispatch[FAULT_TYPE_UVP].count == 0u);
+}
+
+/* The shell prints the records */
+static void test_shell_isr(void)
+{
+    char expect[64];
+    std::string reply;
+
+    test_boot();
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(50000u);
+
+    reply = test_shell("isr\r");
+    snprintf(expect, sizeof(expect), "ovp dispatch n=%u min=",
+            (unsigned)isr_instr_get()->dispatch[FAULT_TYPE_OVP].count);
+    SIM_CHECK(reply.find(expect) != std::string::npos);
+    SIM_CHECK(reply.find("ovp duration n=") != std::string::npos);
+    SIM_CHECK(reply.find("uvp dispatch n=0 min=0 max=0 mean=0 hist=0,0,0,0,0,0,0,0\r\n") != std::string::npos);
+    SIM_CHECK(reply.find("OK") != std::string::npos);
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "ovp_recorded", test_ovp_recorded },
+    { "shell_isr", test_shell_isr },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("isr_instr", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,265 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_ladder.cpp
+*
+* Description: Host test of the PMG1-S2 VBUS estimate through the UV comparator
+*              ladder of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include <stdio.h>
+#include <vector>
+#include "host_sim.h"
+#include "app_timer.h"
+#include "uvov.h"
+#include "uvov_profile.h"
+#include "vbus_ladder.h"
+
+void vbus_set_contract(uint8_t port, uint16_t volt);
+
+/* Time after boot at which the first estimate starts, with a margin */
+#define TEST_BOOT_US                (VBUS_LADDER_PERIOD_MS * 1000u - 20000u)
+
+/* Sampling period of the comparators, shorter than a probe */
+#define TEST_SAMPLE_US              (2u)
+
+/* Window covering one estimate, a probe per 1 ms tick */
+#define TEST_WINDOW_US              (40000u)
+
+/* UV and OV trip codes of the 5 V contract with the default configuration */
+#define TEST_UV_TRIP_CODE           (3u)
+#define TEST_OV_TRIP_CODE           (15u)
+
+/* Longest UV suspension of a probe: two settle times and the register accesses */
+#define TEST_PROBE_MAX_US           (2u * UVP_SETTLE_TIME_US + 10u)
+
+/* Longest critical section accepted while estimates run, in us */
+#define TEST_IRQ_OFF_MAX_US         (5u)
+
+/* Probes seen on the UV comparator, in us since boot */
+typedef struct
+{
+    uint64_t us;
+    uint32_t level;
+} test_probe_t;
+
+static std::vector<test_probe_t> test_probes;
+
+/* UV trip code in force outside the probes */
+static uint32_t test_uv_trip;
+
+/* Expected probe codes of the successive approximation for a VBUS level */
+static std::vector<uint32_t> test_expected(uint16_t vbus_mv)
+{
+    std::vector<uint32_t> codes;
+    uint32_t level = 0u;
+    uint32_t bit;
+
+    for (bit = 1u << (PMG1S2_UV_SEARCH_BITS - 1u); bit != 0u; bit >>= 1)
+    {
+        if ((level | bit) <= UVOV_CODE_TOP)
+        {
+            codes.push_back(level | bit);
+            if (sim_ladder_mv(level | bit) <= vbus_mv)
+            {
+                level |= bit;
+            }
+        }
+    }
+    return codes;
+}
+
+/* Runs the firmware for a time, recording the probes. Unless fault is set,
+ * the FET must stay on and OVP armed all along, a probe must not keep UVP
+ * suspended longer than TEST_PROBE_MAX_US, and UVP must be armed between the
+ * probes.
+ */
+static void test_run(uint64_t us, bool fault)
+{
+    uint64_t end = sim_time_us() + us;
+    uint64_t suspended = 0u;
+    uint32_t level = sim_comp_level(0u, SIM_COMP_UV);
+
+    while (sim_time_us() < end)
+    {
+        sim_run_us(TEST_SAMPLE_US);
+        if (sim_comp_level(0u, SIM_COMP_UV) != level)
+        {
+            level = sim_comp_level(0u, SIM_COMP_UV);
+            if (level != test_uv_trip)
+            {
+                test_probes.push_back({ sim_time_us(), level });
+            }
+        }
+        if (fault)
+        {
+            continue;
+        }
+
+        SIM_CHECK(sim_fet_on(0u));
+        SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+        if (sim_comp_armed(0u, SIM_COMP_UV))
+        {
+            suspended = 0u;
+        }
+        else
+        {
+            suspended = (suspended != 0u) ? suspended : sim_time_us();
+            SIM_CHECK((sim_time_us() - suspended) <= TEST_PROBE_MAX_US);
+        }
+    }
+}
+
+/* Boots at a VBUS level and runs up to the first estimate */
+static void test_boot(uint16_t vbus_mv)
+{
+    sim_param.vbus_mv[0] = vbus_mv;
+    sim_boot(NULL);
+    sim_run_us(TEST_BOOT_US);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_UV));
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == TEST_UV_TRIP_CODE);
+    test_uv_trip = TEST_UV_TRIP_CODE;
+    test_probes.clear();
+    sim_stats.irq_off_max = 0u;
+}
+
+/* Runs until the estimate has made a number of probes */
+static void test_run_probes(size_t count)
+{
+    while (test_probes.size() < count)
+    {
+        test_run(TEST_SAMPLE_US, false);
+        SIM_CHECK(sim_time_us() < (TEST_BOOT_US + TEST_WINDOW_US));
+    }
+}
+
+/* One probe per tick with interrupts enabled in between */
+static void test_estimate(uint16_t vbus_mv)
+{
+    std::vector<uint32_t> codes = test_expected(vbus_mv);
+    size_t idx;
+
+    test_boot(vbus_mv);
+    test_run(TEST_WINDOW_US, false);
+
+    SIM_CHECK(test_probes.size() == codes.size());
+    for (idx = 0; idx < codes.size(); idx++)
+    {
+        SIM_CHECK(test_probes[idx].level == codes[idx]);
+        if (idx != 0u)
+        {
+            SIM_CHECK((test_probes[idx].us - test_probes[idx - 1u].us) >= 900u);
+        }
+    }
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == TEST_UV_TRIP_CODE);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_OV) == TEST_OV_TRIP_CODE);
+    SIM_CHECK(sim_stats.irq_off_max <= (TEST_IRQ_OFF_MAX_US * SIM_CYCLES_PER_US));
+}
+
+static void test_estimate_5100(void)
+{
+    test_estimate(5100u);
+}
+
+static void test_estimate_6200(void)
+{
+    test_estimate(6200u);
+}
+
+/* OVP turns the FET off in hardware during an estimate, which is dropped */
+static void test_ov_during_estimate(void)
+{
+    uint64_t start;
+
+    test_boot(5100u);
+    test_run_probes(3u);
+
+    start = sim_time_us();
+    sim_vbus_set(0u, 7000u);
+    while (sim_fet_on(0u))
+    {
+        sim_run_us(1u);
+        SIM_CHECK((sim_time_us() - start) < 100u);
+    }
+
+    /* No probe after the fault */
+    test_probes.clear();
+    test_run(10000u, true);
+    SIM_CHECK(test_probes.empty());
+
+    /* Recovery re-arms the OV trip threshold */
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(100000u);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_OV) == TEST_OV_TRIP_CODE);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == TEST_UV_TRIP_CODE);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_UV));
+}
+
+/* A new contract between two probes: the probes restore its UV threshold.
+ * Both run from the main loop, so the change lands between two ticks.
+ */
+static void test_contract_change(void)
+{
+    test_boot(5100u);
+    test_run_probes(2u);
+    test_run((APP_TIMER_TICK_MS * 1000u) / 2u, false);
+
+    /* Between the 5 V OV and the 9 V UV trip thresholds over the change */
+    sim_vbus_set(0u, 6400u);
+    vbus_set_contract(0u, 9000u);
+    test_uv_trip = uvov_profile_get(0u, 9000u)->uv_trip;
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == test_uv_trip);
+    sim_vbus_set(0u, 9000u);
+
+    test_run(TEST_WINDOW_US, false);
+    SIM_CHECK(test_probes.size() > 2u);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == test_uv_trip);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_UV));
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "estimate_5100", test_estimate_5100 },
+    { "estimate_6200", test_estimate_6200 },
+    { "ov_during_estimate", test_ov_during_estimate },
+    { "contract_change", test_contract_change },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("ladder", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
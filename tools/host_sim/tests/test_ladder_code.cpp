@@ -0,0 +1,132 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_ladder_code.cpp
+*
+* Description: Host test of the divide-free PMG1-S2 ladder code and percentage
+*              conversions of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include <stdio.h>
+#include "host_sim.h"
+#include "cybsp.h"
+#include "uvov.h"
+
+/* Ladder code of a threshold with the original step divisions */
+static uint8_t test_level_div(uint16_t threshold)
+{
+    uint8_t level;
+
+    if (threshold < UVOV_LADDER_BOT)
+    {
+        level = UVOV_CODE_BOT;
+    }
+    else if (threshold > UVOV_LADDER_TOP)
+    {
+        level = UVOV_CODE_TOP;
+    }
+    else if (threshold <= UVOV_LADDER_MID)
+    {
+        level = (uint8_t)((threshold - UVOV_LADDER_BOT) / UVOV_LO_STEP_SZ);
+    }
+    else
+    {
+        level = (uint8_t)(((threshold - UVOV_LADDER_MID) / UVOV_HI_STEP_SZ) + UVOV_CODE_MID);
+    }
+
+    return level;
+}
+
+/* The reciprocal ladder code matches the division for every 16-bit threshold */
+static void test_level_exhaustive(void)
+{
+    uint32_t threshold;
+
+    for (threshold = 0u; threshold <= UINT16_MAX; threshold++)
+    {
+        if (PMG1S2_Vbus_UvLevelGet((uint16_t)threshold) != test_level_div((uint16_t)threshold))
+        {
+            fprintf(stderr, "threshold %u mV: code %u, expected %u\n", (unsigned)threshold,
+                    PMG1S2_Vbus_UvLevelGet((uint16_t)threshold), test_level_div((uint16_t)threshold));
+            SIM_CHECK(false);
+        }
+    }
+}
+
+/* Every code boundary lands on its ladder voltage */
+static void test_level_boundaries(void)
+{
+    uint32_t code;
+
+    for (code = UVOV_CODE_BOT + 1u; code <= UVOV_CODE_TOP; code++)
+    {
+        SIM_CHECK(PMG1S2_Vbus_UvLevelGet(sim_ladder_mv(code)) == code);
+        SIM_CHECK(PMG1S2_Vbus_UvLevelGet((uint16_t)(sim_ladder_mv(code) - 1u)) == (code - 1u));
+    }
+}
+
+/* The Q32 percentage scaling matches the division for every volt and 8-bit percentage */
+static void test_percent_exhaustive(void)
+{
+    uint32_t volt;
+    uint32_t percent;
+
+    for (percent = 0u; percent <= UINT8_MAX; percent++)
+    {
+        for (volt = 0u; volt <= UINT16_MAX; volt++)
+        {
+            if (UVOV_PERCENT_OF(volt, percent) != (uint16_t)((volt * percent) / 100u))
+            {
+                fprintf(stderr, "%u mV %u%%: %u, expected %u\n", (unsigned)volt, (unsigned)percent,
+                        (unsigned)UVOV_PERCENT_OF(volt, percent), (unsigned)((volt * percent) / 100u));
+                SIM_CHECK(false);
+            }
+        }
+    }
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "level_exhaustive", test_level_exhaustive },
+    { "level_boundaries", test_level_boundaries },
+    { "percent_exhaustive", test_percent_exhaustive },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("ladder_code", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,206 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_low_power.cpp
+*
+* Description: Host simulator test of the deep sleep idle mode and of the sleep
+*              time kept by the application timer of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include <stdio.h>
+#include "host_sim.h"
+#include "app_timer.h"
+#include "fault_event.h"
+#include "low_power.h"
+
+/* Hours of deep sleep simulated */
+#define TEST_SLEEP_HOURS            (3u)
+#define TEST_US_PER_HOUR            (3600ull * 1000000ull)
+
+/* Allowed application timer error, ILO measurement and ms truncation */
+#define TEST_MS_TOLERANCE_PPM       (2000u)
+
+/* OV trip threshold of the 5 V contract with the default configuration */
+#define TEST_OV_TRIP_MV             (6500u)
+
+/* Trips of the fault storm scenarios, more than FAULT_STORM_TRIPS */
+#define TEST_STORM_TRIPS            (10u)
+
+/* Time from the end of an overvoltage until the trip threshold is armed
+ * again and the device sleeps: a few ms without a storm, the backoff and the
+ * 100 ms storm window with one
+ */
+#define TEST_SETTLE_US              (20000u)
+#define TEST_STORM_SETTLE_US        (100000u)
+
+static void test_boot(void)
+{
+    sim_boot(NULL);
+    sim_run_us(100000u);
+    SIM_CHECK(low_power_get_stats()->ilo_ms_q16 != 0u);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_UV));
+}
+
+/* The application timer follows the real time over hours of deep sleep */
+static void check_time(void)
+{
+    uint64_t real_ms = sim_time_us() / 1000u;
+    uint64_t app_ms = app_timer_get_ms();
+    uint64_t error = (app_ms > real_ms) ? (app_ms - real_ms) : (real_ms - app_ms);
+
+    if ((error * 1000000u) > (real_ms * TEST_MS_TOLERANCE_PPM))
+    {
+        fprintf(stderr, "app timer %llu ms, real time %llu ms\n",
+                (unsigned long long)app_ms, (unsigned long long)real_ms);
+        SIM_CHECK(false);
+    }
+}
+
+static void test_sleep_timebase(void)
+{
+    test_boot();
+    sim_run_us(TEST_SLEEP_HOURS * TEST_US_PER_HOUR);
+
+    /* Asleep nearly all the time, woken by the WDT only */
+    SIM_CHECK(sim_stats.sleep_cycles > ((TEST_SLEEP_HOURS * TEST_US_PER_HOUR * 99u / 100u) * SIM_CYCLES_PER_US));
+    SIM_CHECK(low_power_get_stats()->fault_wakeups == 0u);
+    SIM_CHECK(low_power_get_stats()->sleep_ms > (TEST_SLEEP_HOURS * 3600u * 990u));
+    check_time();
+}
+
+/* The ILO is measured, an ILO off its nominal frequency keeps the time */
+static void test_ilo_offset(void)
+{
+    sim_param.ilo_hz = 27000u;
+    test_boot();
+    sim_run_us(TEST_US_PER_HOUR);
+    check_time();
+}
+
+/* A fault after an hour of sleep wakes the device and carries the real time */
+static void test_fault_after_sleep(void)
+{
+    const fault_event_stats_t *stats = fault_event_get_stats();
+
+    test_boot();
+    sim_run_us(TEST_US_PER_HOUR);
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    SIM_CHECK(stats->count[FAULT_TYPE_OVP] >= 1u);
+    SIM_CHECK(low_power_get_stats()->fault_wakeups >= 1u);
+    SIM_CHECK(!sim_fet_on(0u));
+    check_time();
+
+    /* Recovered, back to sleep */
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(1000000u);
+    SIM_CHECK(sim_led_on());
+    SIM_CHECK(sim_asleep());
+}
+
+/* Runs a 1 ms overvoltage and returns the time until the trip threshold is
+ * armed again and the device is back in deep sleep
+ */
+static uint64_t test_ov_pulse(void)
+{
+    uint64_t start;
+
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    sim_vbus_set(0u, 5000u);
+    start = sim_time_us();
+    while (!(sim_asleep() && sim_comp_armed(0u, SIM_COMP_OV) &&
+            (sim_comp_threshold_mv(0u, SIM_COMP_OV) == TEST_OV_TRIP_MV)))
+    {
+        SIM_CHECK((sim_time_us() - start) < 2000000u);
+        sim_run_us(100u);
+    }
+    return (sim_time_us() - start);
+}
+
+/* Trips 20 minutes apart are not a fault storm, however long the device
+ * sleeps in between
+ */
+static void test_storm_spread_trips(void)
+{
+    uint32_t trip;
+
+    test_boot();
+    for (trip = 0u; trip < TEST_STORM_TRIPS; trip++)
+    {
+        SIM_CHECK(test_ov_pulse() < TEST_SETTLE_US);
+        sim_run_us(20u * 60u * 1000000u);
+    }
+    check_time();
+}
+
+/* Trips 2 ms apart are a fault storm, the device stays awake with the re-arm
+ * backed off until the storm is over
+ */
+static void test_storm_fast_trips(void)
+{
+    uint64_t settle;
+    uint32_t storms = 0u;
+    uint32_t trip;
+
+    test_boot();
+    for (trip = 0u; trip < TEST_STORM_TRIPS; trip++)
+    {
+        settle = test_ov_pulse();
+        if (settle > TEST_STORM_SETTLE_US)
+        {
+            storms++;
+        }
+        sim_run_us(2000u);
+    }
+    SIM_CHECK(storms == 1u);
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "sleep_timebase", test_sleep_timebase },
+    { "ilo_offset", test_ilo_offset },
+    { "fault_after_sleep", test_fault_after_sleep },
+    { "storm_spread_trips", test_storm_spread_trips },
+    { "storm_fast_trips", test_storm_fast_trips },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("low_power", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
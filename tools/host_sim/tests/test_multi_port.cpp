@@ -0,0 +1,206 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_multi_port.cpp
+*
+* Description: Host test of the independent fault handling of two USBPD ports of the
+*              PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "host_sim.h"
+#include "fault_event.h"
+#include "fault_storm.h"
+
+/* Threshold armed first, last threshold armed and the interrupts taken at
+ * the first one per port and comparator
+ */
+static uint32_t test_trip[SIM_PORT_COUNT][2];
+static uint32_t test_armed[SIM_PORT_COUNT][2];
+static uint32_t test_trips[SIM_PORT_COUNT][2];
+
+/* Fill the ring of this port at its next OV trip, SIM_PORT_COUNT for none */
+static uint8_t test_flood_port = SIM_PORT_COUNT;
+
+static void test_observer(const sim_evt_t *evt)
+{
+    fault_event_t dummy;
+    uint32_t idx;
+
+    if (evt->kind == SIM_EVT_ARM)
+    {
+        if (test_trip[evt->port][evt->comp] == 0u)
+        {
+            test_trip[evt->port][evt->comp] = evt->value;
+        }
+        test_armed[evt->port][evt->comp] = evt->value;
+    }
+    else if ((evt->kind == SIM_EVT_ACK) && (evt->value == test_trip[evt->port][evt->comp]))
+    {
+        test_trips[evt->port][evt->comp]++;
+    }
+    else if ((evt->kind == SIM_EVT_TRIP) && (evt->port == test_flood_port) && (evt->comp == SIM_COMP_OV))
+    {
+        /* Events of another fault that is not handled, so the event of
+         * this trip is dropped by the interrupt
+         */
+        memset(&dummy, 0, sizeof(dummy));
+        dummy.type = FAULT_TYPE_OVP;
+        dummy.port = evt->port;
+        for (idx = 0u; idx < FAULT_EVENT_RING_SIZE; idx++)
+        {
+            fault_event_push(&dummy);
+        }
+        test_flood_port = SIM_PORT_COUNT;
+    }
+}
+
+static void test_boot(void)
+{
+    uint8_t port;
+
+    sim_observe(test_observer);
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    for (port = 0u; port < SIM_PORT_COUNT; port++)
+    {
+        SIM_CHECK(sim_comp_armed(port, SIM_COMP_OV));
+        SIM_CHECK(sim_comp_armed(port, SIM_COMP_UV));
+        SIM_CHECK(sim_fet_on(port));
+    }
+}
+
+/* Both ports trip at once; each one recovers when its own VBUS is back */
+static void test_simultaneous(void)
+{
+    test_boot();
+    sim_vbus_set(0u, 7000u);
+    sim_vbus_set(1u, 7000u);
+    sim_run_us(5000u);
+    SIM_CHECK(test_trips[0][SIM_COMP_OV] == 1u);
+    SIM_CHECK(test_trips[1][SIM_COMP_OV] == 1u);
+    SIM_CHECK(!sim_fet_on(0u));
+    SIM_CHECK(!sim_fet_on(1u));
+    SIM_CHECK(test_armed[0][SIM_COMP_OV] < test_trip[0][SIM_COMP_OV]);
+    SIM_CHECK(test_armed[1][SIM_COMP_OV] < test_trip[1][SIM_COMP_OV]);
+
+    /* Port 1 recovers while the fault of port 0 persists */
+    sim_vbus_set(1u, 5000u);
+    sim_run_us(20000u);
+    SIM_CHECK(test_armed[1][SIM_COMP_OV] == test_trip[1][SIM_COMP_OV]);
+    SIM_CHECK(sim_comp_armed(1u, SIM_COMP_OV));
+    SIM_CHECK(test_armed[0][SIM_COMP_OV] < test_trip[0][SIM_COMP_OV]);
+
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(20000u);
+    SIM_CHECK(test_armed[0][SIM_COMP_OV] == test_trip[0][SIM_COMP_OV]);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+    SIM_CHECK(test_trips[0][SIM_COMP_OV] == 1u);
+    SIM_CHECK(test_trips[1][SIM_COMP_OV] == 1u);
+    SIM_CHECK(test_trips[0][SIM_COMP_UV] == 0u);
+    SIM_CHECK(test_trips[1][SIM_COMP_UV] == 0u);
+}
+
+/* A fault storm on port 0 does not delay the re-arm of port 1 */
+static void test_storm_isolated(void)
+{
+    uint32_t cycle;
+
+    test_boot();
+    for (cycle = 0u; cycle < 40u; cycle++)
+    {
+        sim_vbus_set(0u, 7000u);
+        if (cycle == 20u)
+        {
+            sim_vbus_set(1u, 7000u);
+        }
+        sim_run_us(2000u);
+        sim_vbus_set(0u, 5000u);
+        if (cycle == 21u)
+        {
+            /* Port 1 is re-armed at the trip threshold within a few polls */
+            sim_vbus_set(1u, 5000u);
+            sim_run_us(3000u);
+            SIM_CHECK(test_armed[1][SIM_COMP_OV] == test_trip[1][SIM_COMP_OV]);
+            SIM_CHECK(sim_comp_armed(1u, SIM_COMP_OV));
+        }
+        else
+        {
+            sim_run_us(3000u);
+        }
+    }
+    SIM_CHECK(test_trips[0][SIM_COMP_OV] >= FAULT_STORM_TRIPS);
+    SIM_CHECK(test_trips[1][SIM_COMP_OV] == 1u);
+}
+
+/* A trip whose event is dropped because the ring of its port is full does
+ * not leave the channel masked, and the other port is not affected
+ */
+static void test_dropped_rearm(void)
+{
+    test_boot();
+    test_flood_port = 0u;
+    sim_vbus_set(0u, 7000u);
+    sim_vbus_set(1u, 7000u);
+    sim_run_us(20000u);
+    SIM_CHECK(fault_event_get_stats()->port_dropped[0] >= 1u);
+    SIM_CHECK(fault_event_get_stats()->port_dropped[1] == 0u);
+    SIM_CHECK(test_trips[0][SIM_COMP_OV] == 2u);
+    SIM_CHECK(test_trips[1][SIM_COMP_OV] == 1u);
+    SIM_CHECK(test_armed[0][SIM_COMP_OV] < test_trip[0][SIM_COMP_OV]);
+    SIM_CHECK(test_armed[1][SIM_COMP_OV] < test_trip[1][SIM_COMP_OV]);
+
+    sim_vbus_set(0u, 5000u);
+    sim_vbus_set(1u, 5000u);
+    sim_run_us(20000u);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+    SIM_CHECK(sim_comp_armed(1u, SIM_COMP_OV));
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "simultaneous", test_simultaneous },
+    { "storm_isolated", test_storm_isolated },
+    { "dropped_rearm", test_dropped_rearm },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("multi_port", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,195 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_profile.cpp
+*
+* Description: Host test of the contract voltage profile cache of the PMG1 MCU
+*              Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "host_sim.h"
+#include "uvov_profile.h"
+
+extern cy_stc_usbpd_context_t USBPD_context[];
+void vbus_set_contract(uint8_t port, uint16_t volt);
+
+/* Comparator steps of the hysteresis bands, HYST_OVP_STEPS and HYST_UVP_STEPS */
+#define TEST_HYST_STEPS             (1u)
+
+/* Ladder codes of the configured 130 % OVP and 70 % UVP thresholds, from
+ * Table 26 of the HardIP BROS: 250 mV steps from 2.75 V to 9 V, 500 mV above.
+ * OV codes round up, UV codes round down.
+ */
+#define TEST_5V_OV_TRIP_CODE        (15u)       /* 6.5 V */
+#define TEST_5V_OV_HYST_CODE        (14u)       /* 6.25 V, one step below */
+#define TEST_5V_UV_TRIP_CODE        (3u)        /* 3.5 V */
+#define TEST_9V02_OV_TRIP_CODE      (31u)       /* 11.726 V up to 12 V */
+#define TEST_9V02_UV_TRIP_CODE      (14u)       /* 6.314 V down to 6.25 V */
+#define TEST_9V02_OV_TRIP_MV        (12000u)
+
+/* The cached profiles and the ones computed on the fly are the same */
+static bool test_profile_equal(const uvov_profile_t *a, const uvov_profile_t *b)
+{
+    return (a->volt == b->volt) && (a->ovp_volt == b->ovp_volt) &&
+            (a->ovp_hyst_volt == b->ovp_hyst_volt) && (a->uvp_hyst_volt == b->uvp_hyst_volt) &&
+            (a->ov_trip_volt == b->ov_trip_volt) && (a->uv_trip == b->uv_trip) &&
+            (a->uv_hyst == b->uv_hyst);
+}
+
+/* Every grid voltage hits the cache with the profile uvov_profile_calc() gives */
+static void test_cache_grid(void)
+{
+    uvov_profile_t calc;
+    uint32_t volt;
+
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    for (volt = UVOV_PROFILE_MIN_MV; volt <= UVOV_PROFILE_MAX_MV; volt += UVOV_PROFILE_STEP_MV)
+    {
+        const uvov_profile_t *profile = uvov_profile_get(0u, (uint16_t)volt);
+
+        SIM_CHECK(profile != NULL);
+        SIM_CHECK(profile->volt == volt);
+        uvov_profile_calc(&USBPD_context[0], (uint16_t)volt, TEST_HYST_STEPS, TEST_HYST_STEPS, &calc);
+        SIM_CHECK(test_profile_equal(profile, &calc));
+    }
+}
+
+/* PPS voltages in 20 mV steps off the grid and voltages out of range miss */
+static void test_cache_miss(void)
+{
+    uint32_t volt;
+    uint32_t hits = 0u;
+
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    for (volt = 0u; volt <= UINT16_MAX; volt++)
+    {
+        const uvov_profile_t *profile = uvov_profile_get(0u, (uint16_t)volt);
+        bool on_grid = (volt >= UVOV_PROFILE_MIN_MV) && (volt <= UVOV_PROFILE_MAX_MV) &&
+                (((volt - UVOV_PROFILE_MIN_MV) % UVOV_PROFILE_STEP_MV) == 0u);
+
+        SIM_CHECK((profile != NULL) == on_grid);
+        if (profile != NULL)
+        {
+            SIM_CHECK(profile->volt == volt);
+            hits++;
+        }
+    }
+    SIM_CHECK(hits == UVOV_PROFILE_COUNT);
+}
+
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+/* The rounded-up OV ladder code matches the division for every 16-bit threshold */
+static void test_ov_level_exhaustive(void)
+{
+    uint32_t threshold;
+
+    for (threshold = 0u; threshold <= UINT16_MAX; threshold++)
+    {
+        uint32_t code;
+
+        if (threshold <= UVOV_LADDER_BOT)
+        {
+            code = UVOV_CODE_BOT;
+        }
+        else if (threshold <= UVOV_LADDER_MID)
+        {
+            code = (threshold - UVOV_LADDER_BOT + UVOV_LO_STEP_SZ - 1u) / UVOV_LO_STEP_SZ;
+        }
+        else
+        {
+            code = UVOV_CODE_MID + ((threshold - UVOV_LADDER_MID + UVOV_HI_STEP_SZ - 1u) / UVOV_HI_STEP_SZ);
+        }
+        code = (code > UVOV_CODE_MAX) ? UVOV_CODE_MAX : code;
+        if (PMG1S2_Vbus_OvLevelGet((uint16_t)threshold) != code)
+        {
+            fprintf(stderr, "threshold %u mV: code %u, expected %u\n", (unsigned)threshold,
+                    PMG1S2_Vbus_OvLevelGet((uint16_t)threshold), (unsigned)code);
+            SIM_CHECK(false);
+        }
+    }
+}
+
+/* The voltages cached for the PDL OVP enable and the UV images arm the ladder
+ * codes of the thresholds, on the grid and for a PPS contract off the grid
+ */
+static void test_armed_levels(void)
+{
+    uvov_profile_t calc;
+
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_OV) == TEST_5V_OV_TRIP_CODE);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == TEST_5V_UV_TRIP_CODE);
+
+    /* Overvoltage: the hysteresis threshold is armed */
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(1000u);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_OV) == TEST_5V_OV_HYST_CODE);
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(50000u);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_OV) == TEST_5V_OV_TRIP_CODE);
+
+    /* 9.02 V PPS contract */
+    vbus_set_contract(0u, 9020u);
+    sim_vbus_set(0u, 9020u);
+    sim_run_us(20000u);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_OV) == TEST_9V02_OV_TRIP_CODE);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == TEST_9V02_UV_TRIP_CODE);
+    SIM_CHECK(sim_comp_threshold_mv(0u, SIM_COMP_OV) == TEST_9V02_OV_TRIP_MV);
+    uvov_profile_calc(&USBPD_context[0], 9020u, TEST_HYST_STEPS, TEST_HYST_STEPS, &calc);
+    SIM_CHECK(calc.ov_trip_volt == TEST_9V02_OV_TRIP_MV);
+}
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "cache_grid", test_cache_grid },
+    { "cache_miss", test_cache_miss },
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    { "ov_level_exhaustive", test_ov_level_exhaustive },
+    { "armed_levels", test_armed_levels },
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("profile", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
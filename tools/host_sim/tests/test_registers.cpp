@@ -0,0 +1,225 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_registers.cpp
+*
+* Description: Host simulator test of the PMG1-S2 INTR3 register model and of the UVP
+*              enable and interrupt dispatch of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "host_sim.h"
+#include "cybsp.h"
+#include "uvov.h"
+
+/* INTR3 source of another driver, without a handler in the dispatcher */
+#define TEST_INTR3_OTHER                (1u << 8)
+
+static cy_stc_usbpd_context_t test_context;
+static uint32_t test_uvp_calls;
+static uint32_t test_ovp_calls;
+
+static void test_uvp_cb(void *context, bool compOut)
+{
+    (void)context;
+    (void)compOut;
+    test_uvp_calls++;
+}
+
+static void test_ovp_cb(void *context, bool compOut)
+{
+    (void)context;
+    (void)compOut;
+    test_ovp_calls++;
+}
+
+static void test_init(void)
+{
+    SIM_CHECK(Cy_USBPD_Init(&test_context, 0u, mtb_usbpd_port0_HW, NULL,
+            (cy_stc_usbpd_config_t *)&mtb_usbpd_port0_config, NULL) == CY_USBPD_STAT_SUCCESS);
+    sim_vbus_set(0u, 5000u);
+}
+
+/* INTR3 is write-1-to-clear, INTR3_SET write-1-to-set, INTR3_MASKED the AND */
+static void test_intr3_semantics(void)
+{
+    PPDSS_REGS_T pd = mtb_usbpd_port0_HW;
+
+    test_init();
+    pd->intr3_set = PDSS_INTR3_POS_OV_CHANGED | PDSS_INTR3_POS_UV_CHANGED;
+    SIM_CHECK(pd->intr3 == (PDSS_INTR3_POS_OV_CHANGED | PDSS_INTR3_POS_UV_CHANGED));
+    SIM_CHECK(pd->intr3_masked == 0u);
+
+    pd->intr3_mask = PDSS_INTR3_POS_UV_CHANGED;
+    SIM_CHECK(pd->intr3_masked == PDSS_INTR3_POS_UV_CHANGED);
+
+    pd->intr3 = PDSS_INTR3_POS_UV_CHANGED;
+    SIM_CHECK(pd->intr3 == PDSS_INTR3_POS_OV_CHANGED);
+    SIM_CHECK(pd->intr3_masked == 0u);
+
+    /* Writing 0 leaves the status unchanged, the masked view is read-only */
+    pd->intr3 = 0u;
+    pd->intr3_masked = 0u;
+    SIM_CHECK(pd->intr3 == PDSS_INTR3_POS_OV_CHANGED);
+}
+
+/* The comparators follow VBUS once powered, UV is inverted on INTR5 */
+static void test_comparator_status(void)
+{
+    PPDSS_REGS_T pd = mtb_usbpd_port0_HW;
+
+    test_init();
+    SIM_CHECK(pd->ncell_status == 0u);
+
+    /* UV at code 3 (3500 mV), OV at code 15 (6500 mV) */
+    pd->uvov_ctrl = (3u << PDSS_UVOV_CTRL_UV_IN_POS) | (15u << PDSS_UVOV_CTRL_OV_IN_POS) |
+            PDSS_UVOV_CTRL_UVOV_ISO_N;
+    SIM_CHECK(pd->ncell_status == 0u);
+    SIM_CHECK(pd->intr5_status_0 == PDSS_INTR5_STATUS_0_FILT_UV);
+
+    sim_vbus_set(0u, 3400u);
+    SIM_CHECK(pd->ncell_status == PDSS_NCELL_STATUS_UV_STATUS);
+    sim_vbus_set(0u, 6600u);
+    SIM_CHECK(pd->ncell_status == PDSS_NCELL_STATUS_OV_STATUS);
+
+    /* Powered down, no output */
+    pd->uvov_ctrl = pd->uvov_ctrl | PDSS_UVOV_CTRL_PD_UVOV;
+    SIM_CHECK(pd->ncell_status == 0u);
+}
+
+/* A rising filtered output sets INTR3 after the debounce time */
+static void test_filter(void)
+{
+    PPDSS_REGS_T pd = mtb_usbpd_port0_HW;
+    uint64_t start;
+
+    test_init();
+    pd->uvov_ctrl = (15u << PDSS_UVOV_CTRL_OV_IN_POS) | PDSS_UVOV_CTRL_UVOV_ISO_N;
+    start = sim_cycles();
+    sim_vbus_set(0u, 7000u);
+
+    /* Debounce 10 -> 5 cycles of the 500 kHz filter clock, 10 us */
+    while ((pd->intr3 & PDSS_INTR3_POS_OV_CHANGED) == 0u)
+    {
+        SIM_CHECK((sim_cycles() - start) < (20u * SIM_CYCLES_PER_US));
+    }
+    SIM_CHECK((sim_cycles() - start) >= (10u * SIM_CYCLES_PER_US));
+}
+
+/* UVP enable with VBUS already below the threshold flags the interrupt */
+static void test_uvp_enable(void)
+{
+    PPDSS_REGS_T pd = mtb_usbpd_port0_HW;
+    bool deferred;
+
+    test_init();
+    sim_vbus_set(0u, 3000u);
+    deferred = PMG1S2_Vbus_UvpEnable(&test_context, 5000u, test_uvp_cb, true);
+    SIM_CHECK(deferred);
+    SIM_CHECK(sim_comp_level(0u, SIM_COMP_UV) == 3u);
+    SIM_CHECK((pd->intr3_mask & PDSS_INTR3_POS_UV_CHANGED) == 0u);
+
+    /* Completed after the settle time */
+    Cy_SysLib_DelayUs(UVP_SETTLE_TIME_US);
+    PMG1S2_Vbus_UvpEnableComplete(&test_context);
+    SIM_CHECK((pd->intr3_masked & PDSS_INTR3_POS_UV_CHANGED) != 0u);
+}
+
+/* The dispatcher masks, clears and handles every pending source once */
+static void test_dispatch(void)
+{
+    PPDSS_REGS_T pd = mtb_usbpd_port0_HW;
+
+    test_init();
+    PMG1S2_USBPD_Intr1Init();
+    test_context.vbusOvpCbk = test_ovp_cb;
+    test_context.vbusUvpCbk = test_uvp_cb;
+    pd->intr3_mask = PDSS_INTR3_POS_OV_CHANGED | PDSS_INTR3_POS_UV_CHANGED;
+    pd->intr3_set = PDSS_INTR3_POS_OV_CHANGED | PDSS_INTR3_POS_UV_CHANGED;
+
+    PMG1S2_USBPD_Intr1Handler(&test_context);
+    SIM_CHECK(test_ovp_calls == 1u);
+    SIM_CHECK(test_uvp_calls == 1u);
+    SIM_CHECK(pd->intr3 == 0u);
+    SIM_CHECK(pd->intr3_mask == 0u);
+
+    /* Nothing pending, nothing called */
+    PMG1S2_USBPD_Intr1Handler(&test_context);
+    SIM_CHECK(test_ovp_calls == 1u);
+}
+
+/* Sources without a handler stay enabled and pending for their owner */
+static void test_dispatch_unregistered(void)
+{
+    PPDSS_REGS_T pd = mtb_usbpd_port0_HW;
+
+    test_init();
+    PMG1S2_USBPD_Intr1Init();
+    test_context.vbusOvpCbk = test_ovp_cb;
+    pd->intr3_mask = PDSS_INTR3_POS_OV_CHANGED | TEST_INTR3_OTHER;
+    pd->intr3_set = PDSS_INTR3_POS_OV_CHANGED | TEST_INTR3_OTHER;
+
+    PMG1S2_USBPD_Intr1Handler(&test_context);
+    SIM_CHECK(test_ovp_calls == 1u);
+    SIM_CHECK(pd->intr3 == TEST_INTR3_OTHER);
+    SIM_CHECK(pd->intr3_mask == TEST_INTR3_OTHER);
+
+    /* A source registered and removed again is left alone as well */
+    PMG1S2_USBPD_Intr3Register(PDSS_INTR3_POS_OV_CHANGED, NULL);
+    pd->intr3_mask = PDSS_INTR3_POS_OV_CHANGED;
+    pd->intr3_set = PDSS_INTR3_POS_OV_CHANGED;
+    PMG1S2_USBPD_Intr1Handler(&test_context);
+    SIM_CHECK(test_ovp_calls == 1u);
+    SIM_CHECK((pd->intr3 & PDSS_INTR3_POS_OV_CHANGED) != 0u);
+    SIM_CHECK(pd->intr3_mask == PDSS_INTR3_POS_OV_CHANGED);
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "intr3_semantics", test_intr3_semantics },
+    { "comparator_status", test_comparator_status },
+    { "filter", test_filter },
+    { "uvp_enable", test_uvp_enable },
+    { "dispatch", test_dispatch },
+    { "dispatch_unregistered", test_dispatch_unregistered },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("registers", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
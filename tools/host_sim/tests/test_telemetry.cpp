@@ -0,0 +1,289 @@
+/******************************************************************************
+* File Name: tools/host_sim/tests/test_telemetry.cpp
+*
+* Description: Host simulator loopback test of the binary telemetry stream and of
+*              the host decoder of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+/*
+ * The telemetry stream sent on the simulated UART is fed to the decoder of
+ * tools/telemetry_decode, compiled into this test, and the CSV it prints is
+ * checked against the faults driven in the simulation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "host_sim.h"
+#include "fault_event.h"
+
+/* vbus_state_t of main.c, VBUS between the thresholds */
+#define TEST_VBUS_NORMAL            "2"
+
+#define main telemetry_decode_main
+#include "../telemetry_decode/telemetry_decode.c"
+#undef main
+
+/* Decoded CSV lines, split into fields */
+typedef std::vector<std::string> test_row_t;
+
+static std::vector<test_row_t> test_rows;
+static std::string test_summary;
+
+static std::string test_read_file(const char *path)
+{
+    std::string text;
+    char buf[4096];
+    size_t len;
+    FILE *f = fopen(path, "rb");
+
+    SIM_CHECK(f != NULL);
+    while ((len = fread(buf, 1u, sizeof(buf), f)) != 0u)
+    {
+        text.append(buf, len);
+    }
+    fclose(f);
+    return text;
+}
+
+/* Position of the comma ending the CSV field at start, skipping the commas
+ * inside a quoted field, npos for the last field
+ */
+static size_t test_field_end(const std::string &line, size_t start)
+{
+    size_t pos = start;
+    bool quoted = false;
+
+    for (; pos < line.size(); pos++)
+    {
+        if (line[pos] == '"')
+        {
+            quoted = !quoted;
+        }
+        else if ((line[pos] == ',') && !quoted)
+        {
+            return pos;
+        }
+    }
+    return std::string::npos;
+}
+
+/* Runs the decoder on the captured stream with stdout and stderr redirected */
+static void test_decode(const uint8_t *data, size_t len)
+{
+    char in_path[] = "/tmp/telemetry_in_XXXXXX";
+    char out_path[] = "/tmp/telemetry_out_XXXXXX";
+    char err_path[] = "/tmp/telemetry_err_XXXXXX";
+    char *argv[] = { (char *)"telemetry_decode", in_path, NULL };
+    int in_fd = mkstemp(in_path);
+    int out_fd = mkstemp(out_path);
+    int err_fd = mkstemp(err_path);
+    int saved_out = dup(STDOUT_FILENO);
+    int saved_err = dup(STDERR_FILENO);
+    std::string csv;
+    size_t pos = 0u;
+    size_t end;
+
+    SIM_CHECK((in_fd >= 0) && (out_fd >= 0) && (err_fd >= 0));
+    SIM_CHECK(write(in_fd, data, len) == (ssize_t)len);
+    close(in_fd);
+
+    fflush(stdout);
+    fflush(stderr);
+    dup2(out_fd, STDOUT_FILENO);
+    dup2(err_fd, STDERR_FILENO);
+    (void)telemetry_decode_main(2, argv);
+    fflush(stdout);
+    fflush(stderr);
+    dup2(saved_out, STDOUT_FILENO);
+    dup2(saved_err, STDERR_FILENO);
+    close(saved_out);
+    close(saved_err);
+    close(out_fd);
+    close(err_fd);
+
+    csv = test_read_file(out_path);
+    test_summary = test_read_file(err_path);
+    unlink(in_path);
+    unlink(out_path);
+    unlink(err_path);
+
+    while ((end = csv.find('\n', pos)) != std::string::npos)
+    {
+        test_row_t row;
+        std::string line = csv.substr(pos, end - pos);
+        size_t start = 0u;
+        size_t comma;
+
+        while ((comma = test_field_end(line, start)) != std::string::npos)
+        {
+            row.push_back(line.substr(start, comma - start));
+            start = comma + 1u;
+        }
+        row.push_back(line.substr(start));
+        test_rows.push_back(row);
+        pos = end + 1u;
+    }
+}
+
+/* Number of decoded rows of a frame kind */
+static uint32_t test_count(const char *frame)
+{
+    uint32_t count = 0u;
+    size_t idx;
+
+    for (idx = 1u; idx < test_rows.size(); idx++)
+    {
+        if (test_rows[idx][1] == frame)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Last decoded row of a frame kind */
+static const test_row_t &test_last(const char *frame)
+{
+    size_t idx;
+
+    for (idx = test_rows.size() - 1u; idx > 0u; idx--)
+    {
+        if (test_rows[idx][1] == frame)
+        {
+            return test_rows[idx];
+        }
+    }
+    SIM_CHECK(false);
+    return test_rows[0];
+}
+
+static void test_loopback(void)
+{
+    const uint8_t *data;
+    size_t len;
+    size_t idx;
+
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    sim_vbus_set(0u, 7000u);
+    sim_run_us(5000u);
+    sim_vbus_set(0u, 5000u);
+    sim_run_us(2500000u);
+
+    len = sim_uart_tx(&data);
+    SIM_CHECK(len > 0u);
+    test_decode(data, len);
+
+    /* Every frame decodes, in sequence, and every row has all the columns */
+    SIM_CHECK(test_summary.find("crc_errors=0 seq_gaps=0 skipped_bytes=0") != std::string::npos);
+    SIM_CHECK(test_rows.size() > 1u);
+    for (idx = 0u; idx < test_rows.size(); idx++)
+    {
+        SIM_CHECK(test_rows[idx].size() == test_rows[0].size());
+    }
+    SIM_CHECK(test_rows[0][0] == "seq");
+
+    /* The OVP trip: port 0, 5 V contract, trip code of 6.5 V */
+    SIM_CHECK(test_count("event") >= 1u);
+    SIM_CHECK(test_rows[1][1] == "event");
+    SIM_CHECK(test_rows[1][2] == "0");
+    SIM_CHECK(atoi(test_rows[1][4].c_str()) == FAULT_TYPE_OVP);
+    SIM_CHECK(test_rows[1][5] == "5000");
+
+    /* Two periodic reports, back to normal with the trip threshold armed */
+    SIM_CHECK(test_count("status") == 2u);
+    SIM_CHECK(test_count("counters") == 2u);
+    SIM_CHECK(test_last("status")[10] == TEST_VBUS_NORMAL);
+    SIM_CHECK(test_last("status")[11] == "5000");
+    SIM_CHECK(test_last("status")[12] == "5000");
+    SIM_CHECK(strtoul(test_last("counters")[15].c_str(), NULL, 10) ==
+            fault_event_get_stats()->count[FAULT_TYPE_OVP]);
+    SIM_CHECK(test_last("counters")[16] == "0");
+    SIM_CHECK(test_last("counters")[17] == "0");
+}
+
+/* Shell replies are sent as TEXT frames and leave the stream decodable */
+static void test_shell_text(void)
+{
+    const uint8_t *data;
+    std::string text;
+    size_t len;
+    size_t idx;
+
+    sim_boot(NULL);
+    sim_run_us(20000u);
+    sim_uart_rx("stats\r");
+    sim_run_us(50000u);
+    sim_uart_rx("bogus\r");
+    sim_run_us(50000u);
+
+    len = sim_uart_tx(&data);
+    SIM_CHECK(len > 0u);
+    test_decode(data, len);
+
+    SIM_CHECK(test_summary.find("crc_errors=0 seq_gaps=0 skipped_bytes=0") != std::string::npos);
+    for (idx = 0u; idx < test_rows.size(); idx++)
+    {
+        SIM_CHECK(test_rows[idx].size() == test_rows[0].size());
+        if (test_rows[idx][1] == "text")
+        {
+            text += test_rows[idx].back();
+        }
+    }
+    SIM_CHECK(test_rows[0].back() == "text");
+    SIM_CHECK(test_count("text") >= 4u);
+    SIM_CHECK(text.find("\"ovp=0 uvp=0 dropped=0") != std::string::npos);
+    SIM_CHECK(text.find("\"OK\\n\"") != std::string::npos);
+    SIM_CHECK(text.find("\"ERR cmd\\n\"") != std::string::npos);
+}
+
+static const sim_scenario_t test_scenarios[] =
+{
+    { "loopback", test_loopback },
+    { "shell_text", test_shell_text },
+};
+
+int main(void)
+{
+    return (sim_run_scenarios("telemetry", test_scenarios,
+            sizeof(test_scenarios) / sizeof(test_scenarios[0])) == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,264 @@
+/******************************************************************************
+* File Name: telemetry_decode.c
+*
+* Description: Host-side decoder converting a captured telemetry byte stream of the PMG1
+*              MCU Using UVOV Blocks Code Example into CSV.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*
+ * Host-side decoder for the binary telemetry stream. Reads a captured byte
+ * stream from a file (or stdin) and writes one CSV line per valid frame to
+ * stdout. Frames with a bad CRC are skipped and the stream is resynchronized
+ * on the next start-of-frame byte. The UART shell replies carried in TEXT
+ * frames are written to the last column as a quoted field. A summary is
+ * written to stderr.
+ *
+ * Build:  gcc -O2 -I../.. -o telemetry_decode telemetry_decode.c
+ * Usage:  telemetry_decode [capture.bin] > capture.csv
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "telemetry_frame.h"
+
+/* Decoder statistics */
+typedef struct
+{
+    unsigned long frames;           /* Valid frames */
+    unsigned long crc_errors;       /* Frames rejected by the CRC */
+    unsigned long seq_gaps;         /* Frames missing according to the sequence number */
+    unsigned long skipped;          /* Bytes skipped while searching for a frame */
+} decode_stats_t;
+
+static uint16_t get_u16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | ((uint16_t)buf[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *buf)
+{
+    return (uint32_t)get_u16(buf) | ((uint32_t)get_u16(buf + 2) << 16);
+}
+
+/* Drops the rejected frame start and continues from the next start-of-frame
+ * byte already in the buffer, if any. Returns the new fill level.
+ */
+static uint32_t resync(uint8_t *frame, uint32_t fill, decode_stats_t *stats)
+{
+    uint32_t pos;
+
+    for (pos = 1; pos < fill; pos++)
+    {
+        if (frame[pos] == TELEMETRY_SOF)
+        {
+            break;
+        }
+    }
+    stats->skipped += pos;
+    memmove(frame, &frame[pos], fill - pos);
+    return (fill - pos);
+}
+
+/* Prints the text of a TEXT frame as a quoted CSV field. Quotes are doubled,
+ * carriage returns are dropped and line feeds are written as \n.
+ */
+static void print_text(const uint8_t *text, uint8_t len)
+{
+    uint8_t idx;
+
+    putchar('"');
+    for (idx = 0; idx < len; idx++)
+    {
+        if (text[idx] == '"')
+        {
+            printf("\"\"");
+        }
+        else if (text[idx] == '\n')
+        {
+            printf("\\n");
+        }
+        else if (text[idx] != '\r')
+        {
+            putchar(text[idx]);
+        }
+    }
+    putchar('"');
+}
+
+/* Prints one decoded frame as a CSV line */
+static void print_frame(const uint8_t *frame)
+{
+    uint8_t len = frame[1];
+    const uint8_t *p = &frame[TELEMETRY_HDR_LEN];
+
+    switch (frame[3])
+    {
+        case TELEMETRY_FRAME_EVENT:
+            if (len == TELEMETRY_EVENT_LEN)
+            {
+                printf("%u,event,%u,%lu,%u,%u,%u,%u,%u,%u,,,,,,,,,,,,,,,\n", frame[2], p[12], (unsigned long)get_u32(p),
+                        p[6], get_u16(p + 4), p[7], p[8], get_u16(p + 9), p[11]);
+                return;
+            }
+            break;
+
+        case TELEMETRY_FRAME_STATUS:
+            if (len == TELEMETRY_STATUS_LEN)
+            {
+                printf("%u,status,%u,%lu,,,,,,,%u,%u,%u,%u,%u,,,,,,,,,,\n", frame[2], p[11], (unsigned long)get_u32(p),
+                        p[4], get_u16(p + 5), get_u16(p + 7), p[9], p[10]);
+                return;
+            }
+            break;
+
+        case TELEMETRY_FRAME_COUNTERS:
+            if (len == TELEMETRY_COUNTERS_LEN)
+            {
+                printf("%u,counters,,%lu,,,,,,,,,,,,%lu,%lu,%lu,%lu,,,,,,\n", frame[2], (unsigned long)get_u32(p),
+                        (unsigned long)get_u32(p + 4), (unsigned long)get_u32(p + 8),
+                        (unsigned long)get_u32(p + 12), (unsigned long)get_u32(p + 16));
+                return;
+            }
+            break;
+
+        case TELEMETRY_FRAME_ISR:
+            if (len == TELEMETRY_ISR_LEN)
+            {
+                printf("%u,isr,,,%u,,,,,,,,,,,,,,,%s,%lu,%lu,%lu,%lu,\n", frame[2], p[1],
+                        (p[0] == TELEMETRY_ISR_DISPATCH) ? "dispatch" : "duration",
+                        (unsigned long)get_u32(p + 2), (unsigned long)get_u32(p + 6),
+                        (unsigned long)get_u32(p + 10), (unsigned long)get_u32(p + 14));
+                return;
+            }
+            break;
+
+        case TELEMETRY_FRAME_TEXT:
+            printf("%u,text,,,,,,,,,,,,,,,,,,,,,,,", frame[2]);
+            print_text(p, len);
+            printf("\n");
+            return;
+
+        default:
+            break;
+    }
+    printf("%u,unknown_%u,,,,,,,,,,,,,,,,,,,,,,,\n", frame[2], frame[3]);
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t frame[TELEMETRY_HDR_LEN + 255u + TELEMETRY_CRC_LEN];
+    decode_stats_t stats = { 0 };
+    uint32_t fill = 0;
+    uint32_t need;
+    uint8_t expected_seq = 0;
+    bool have_seq = false;
+    FILE *in = stdin;
+    int c;
+
+    if (argc > 1)
+    {
+        in = fopen(argv[1], "rb");
+        if (in == NULL)
+        {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    printf("seq,frame,port,timestamp_ms,fault,volt_mv,comp_out,code,vbus_mv,flags,vbus_status,"
+           "ovp_volt_mv,uvp_volt_mv,ovp_state,uvp_state,ovp_events,uvp_events,"
+           "dropped_events,dropped_log_bytes,isr_meas,isr_samples,isr_min_cycles,isr_max_cycles,"
+           "isr_mean_cycles,text\n");
+
+    while ((c = fgetc(in)) != EOF)
+    {
+        if ((fill == 0u) && ((uint8_t)c != TELEMETRY_SOF))
+        {
+            stats.skipped++;
+            continue;
+        }
+
+        frame[fill++] = (uint8_t)c;
+        if (fill < TELEMETRY_HDR_LEN)
+        {
+            continue;
+        }
+
+        need = TELEMETRY_HDR_LEN + frame[1] + TELEMETRY_CRC_LEN;
+        if (frame[1] > TELEMETRY_MAX_PAYLOAD)
+        {
+            fill = resync(frame, fill, &stats);
+            continue;
+        }
+
+        if ((fill == need) &&
+            (telemetry_crc16(TELEMETRY_CRC_INIT, &frame[1], need - TELEMETRY_HDR_LEN + 1u) !=
+             get_u16(&frame[need - TELEMETRY_CRC_LEN])))
+        {
+            stats.crc_errors++;
+            fill = resync(frame, fill, &stats);
+            continue;
+        }
+
+        if (fill == need)
+        {
+            if (have_seq && (frame[2] != expected_seq))
+            {
+                stats.seq_gaps += (uint8_t)(frame[2] - expected_seq);
+            }
+            expected_seq = (uint8_t)(frame[2] + 1u);
+            have_seq = true;
+
+            print_frame(frame);
+            stats.frames++;
+            fill = 0;
+        }
+    }
+
+    fprintf(stderr, "frames=%lu crc_errors=%lu seq_gaps=%lu skipped_bytes=%lu\n",
+            stats.frames, stats.crc_errors, stats.seq_gaps, stats.skipped);
+
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    return 0;
+}
+
+/* [] END OF FILE */
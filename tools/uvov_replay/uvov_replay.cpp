@@ -0,0 +1,786 @@
+/******************************************************************************
+* File Name: tools/uvov_replay/uvov_replay.cpp
+*
+* Description: Host-side replay of recorded VBUS waveforms against the firmware of the
+*              PMG1 MCU Using UVOV Blocks Code Example on the host simulator.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*
+ * Host-side replay of recorded VBUS waveforms. Every threshold percentage
+ * and debounce setting of the sweep boots the PMG1-S2 firmware on the host
+ * simulator in a child process, as the tests do, and drives port 0 with
+ * the trace. The children run in parallel, and settings whose percentages
+ * arm the same ladder codes share one replay. The ladder quantization, the debounce filter, the hysteresis
+ * band armed after a trip and the re-arm of the fault state machines are
+ * the ones of uvov.c and main.c rather than a model of them. For every
+ * setting one CSV line is written to stdout with the detection latency,
+ * false trips and missed faults, measured against fixed OV/UV limits that
+ * define a real fault.
+ *
+ * A trip is a comparator trip at the trip threshold acknowledged by the
+ * firmware; trips at the hysteresis level while the fault is active are not
+ * counted. Built against the pmg1s2_dvdt configuration a provider FET
+ * turn-off by the dV/dt predictor counts as an OV trip as well.
+ *
+ * A trip detects the first real fault of the excursion of VBUS beyond the
+ * contract voltage it falls in, from the start of the excursion to the end
+ * of the fault, so a trip ahead of the fault limit counts from the fault
+ * start with a latency of 0. A trip in an excursion without a real fault
+ * is a false trip.
+ *
+ * Input is either CSV with "time_us,vbus_mv" per line (lines not starting
+ * with a digit are skipped) or, with -b, raw little-endian uint16 mV samples
+ * at a fixed rate. The trace is replayed from its first sample.
+ *
+ * Build:  make -C tools/host_sim replay
+ *         build/pmg1s2/uvov_replay, and build/pmg1s2_dvdt/uvov_replay with
+ *         the dV/dt predictor
+ * Usage:  uvov_replay [options] trace > sweep.csv
+ *   -b rate_hz       binary input sampled at rate_hz
+ *   -v mv            contract voltage (5000)
+ *   -O mv / -U mv    OV / UV limit defining a real fault (130% / 70% of -v)
+ *   -m us            minimum duration of a real fault (100)
+ *   -f hz            debounce filter clock (500000)
+ *   -o lo:hi[:step]  OV threshold percentages above -v (10:30:5)
+ *   -u lo:hi[:step]  UV threshold percentages of -v (60:80:5)
+ *   -d lo:hi[:step]  debounce settings in filter clock cycles (0:32:4), the
+ *                    configurator debounce is set to twice the value
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <vector>
+#include "host_sim.h"
+#include "uvov.h"
+
+extern cy_stc_usbpd_context_t USBPD_context[];
+
+void vbus_set_contract(uint8_t port, uint16_t volt);
+
+/* Time the firmware runs at the contract voltage before the trace starts */
+#define REPLAY_SETTLE_US            (20000u)
+
+/* Time the firmware runs after the last sample, for the last trip to be handled */
+#define REPLAY_TAIL_US              (20000u)
+
+/* Interval at which the replay turns the provider FET back on as the PD stack does */
+#define REPLAY_STACK_US             (100u)
+
+/* Sweep range */
+typedef struct
+{
+    unsigned lo;
+    unsigned hi;
+    unsigned step;
+} range_t;
+
+/* Real fault of the trace on one channel */
+typedef struct
+{
+    uint64_t start;                 /* VBUS beyond the fault limit */
+    uint64_t end;                   /* VBUS back within the limit */
+    uint64_t excursion_start;       /* VBUS beyond the contract voltage */
+    int32_t excursion;
+} replay_fault_t;
+
+/* Real faults and excursions of a channel */
+typedef struct
+{
+    std::vector<replay_fault_t> faults;
+    std::vector<int32_t> excursion;         /* Excursion of every sample, -1 if none */
+    std::vector<bool> excursion_fault;      /* The excursion contains a real fault */
+} replay_ref_t;
+
+/* Setting replayed by the child */
+typedef struct
+{
+    uint8_t comp;                   /* SIM_COMP_OV or SIM_COMP_UV */
+    unsigned pct;
+    unsigned deb;                   /* Debounce filter clock cycles */
+} replay_setting_t;
+
+/* Result of one replay */
+typedef struct
+{
+    unsigned long faults;           /* Real faults in the trace */
+    unsigned long detected;         /* Real faults with a trip */
+    unsigned long missed;           /* Real faults without a trip */
+    unsigned long false_trips;      /* Trips not matching a real fault */
+    unsigned long predicted;        /* Trips raised by the dV/dt predictor */
+    uint64_t lat_min;               /* Detection latency in us */
+    uint64_t lat_max;
+    uint64_t lat_sum;
+} replay_result_t;
+
+/* Setting of the sweep, shared with the children that run it */
+typedef struct
+{
+    replay_setting_t set;
+    uint32_t level[2];              /* Trip threshold codes armed, from the pre-pass */
+    uint16_t thr;                   /* Trip threshold of the swept channel in mV */
+    size_t lead;                    /* Job whose replay gives the result of this one */
+    bool done;                      /* The child of the last pass succeeded */
+    replay_result_t res;
+} replay_job_t;
+
+static std::vector<sim_sample_t> replay_trace;
+static replay_ref_t replay_ref[2];
+static uint16_t replay_contract = 5000u;
+static replay_setting_t replay_setting;
+
+/* Trips seen by the observer, in us from the trace start */
+static std::vector<uint64_t> replay_trips;
+static uint64_t replay_start_us;
+static bool replay_running;
+static uint32_t replay_trip_level[2];   /* Trip threshold codes of the channels */
+static bool replay_tripped;
+static uint64_t replay_trip_us;
+static unsigned long replay_predicted;
+
+/* Jobs of the sweep, in memory shared with the children */
+static replay_job_t *replay_jobs;
+static size_t replay_distinct;
+
+static void replay_observer(const sim_evt_t *evt)
+{
+    uint64_t t = evt->cycle / SIM_CYCLES_PER_US;
+
+    if ((evt->port != 0u) || !replay_running)
+    {
+        return;
+    }
+
+    if ((evt->kind == SIM_EVT_TRIP) && (evt->comp == replay_setting.comp) && (evt->value == replay_trip_level[evt->comp]))
+    {
+        replay_tripped = true;
+        replay_trip_us = t - replay_start_us;
+    }
+    else if ((evt->kind == SIM_EVT_ACK) && (evt->comp == replay_setting.comp) &&
+             (evt->value == replay_trip_level[evt->comp]) && replay_tripped)
+    {
+        replay_tripped = false;
+        replay_trips.push_back(replay_trip_us);
+    }
+#if VBUS_DVDT_ENABLE
+    else if ((evt->kind == SIM_EVT_FET) && (evt->value == 0u) && (replay_setting.comp == SIM_COMP_OV) &&
+             !sim_comp_out(0u, SIM_COMP_OV) && !sim_comp_out(0u, SIM_COMP_UV))
+    {
+        /* Turned off with neither comparator out: the predictor acted */
+        replay_predicted++;
+        replay_trips.push_back(t - replay_start_us);
+    }
+#endif /* VBUS_DVDT_ENABLE */
+}
+
+/* Loads a trace, rate_hz selects the binary format when not 0 */
+static bool trace_load(FILE *in, unsigned long rate_hz)
+{
+    sim_sample_t sample;
+
+    if (rate_hz != 0u)
+    {
+        uint8_t buf[8192];
+        size_t len;
+        size_t have = 0;
+        size_t idx;
+        uint64_t count = 0;
+
+        /* An odd byte at the end of a read is the low byte of the next sample */
+        while ((len = fread(buf + have, 1, sizeof(buf) - have, in)) != 0u)
+        {
+            len += have;
+            for (idx = 0; (idx + 1u) < len; idx += 2u)
+            {
+                sample.time_us = (count * 1000000u) / rate_hz;
+                sample.vbus_mv = (uint16_t)(buf[idx] | (buf[idx + 1u] << 8));
+                replay_trace.push_back(sample);
+                count++;
+            }
+            have = len & 1u;
+            if (have != 0u)
+            {
+                buf[0] = buf[len - 1u];
+            }
+        }
+        if (have != 0u)
+        {
+            fprintf(stderr, "trailing odd byte ignored\n");
+        }
+    }
+    else
+    {
+        char line[128];
+        char *end;
+
+        while (fgets(line, sizeof(line), in) != NULL)
+        {
+            if (!isdigit((unsigned char)line[0]))
+            {
+                continue;
+            }
+            sample.time_us = strtoull(line, &end, 10);
+            if (*end != ',')
+            {
+                continue;
+            }
+            sample.vbus_mv = (uint16_t)strtoul(end + 1, NULL, 10);
+            replay_trace.push_back(sample);
+        }
+    }
+
+    if (ferror(in))
+    {
+        return false;
+    }
+
+    /* Replay from the first sample */
+    if (!replay_trace.empty())
+    {
+        uint64_t first = replay_trace[0].time_us;
+
+        for (sim_sample_t &s : replay_trace)
+        {
+            s.time_us -= first;
+        }
+    }
+    return true;
+}
+
+/* Finds the real faults of a channel and the excursions of VBUS beyond the
+ * contract voltage they fall in
+ */
+static void replay_reference(uint8_t comp, uint32_t limit, uint64_t min_fault_us)
+{
+    replay_ref_t *ref = &replay_ref[comp];
+    bool over = (comp == SIM_COMP_OV);
+    int32_t excursion = -1;
+    bool away = false;              /* VBUS beyond the contract voltage */
+    uint64_t away_since = 0;
+    bool beyond = false;            /* VBUS beyond the fault limit */
+    uint64_t beyond_since = 0;
+    bool fault = false;             /* The excursion lasted long enough to be a real fault */
+
+    /* A sample holds until the next one, so the duration beyond the limit is
+     * checked at every sample, including the one ending the excursion
+     */
+    for (const sim_sample_t &s : replay_trace)
+    {
+        bool a = over ? (s.vbus_mv > replay_contract) : (s.vbus_mv < replay_contract);
+        bool out = over ? (s.vbus_mv > limit) : (s.vbus_mv < limit);
+
+        if (beyond && !fault && ((s.time_us - beyond_since) >= min_fault_us))
+        {
+            fault = true;
+            ref->faults.push_back({ beyond_since, UINT64_MAX, away ? away_since : beyond_since,
+                                    away ? excursion : -1 });
+            if (away)
+            {
+                ref->excursion_fault[excursion] = true;
+            }
+        }
+        if (!out && beyond)
+        {
+            if (fault)
+            {
+                ref->faults.back().end = s.time_us;
+            }
+            beyond = false;
+        }
+
+        if (a && !away)
+        {
+            excursion++;
+            away_since = s.time_us;
+            ref->excursion_fault.push_back(false);
+        }
+        away = a;
+        ref->excursion.push_back(away ? excursion : -1);
+
+        if (out && !beyond)
+        {
+            beyond = true;
+            beyond_since = s.time_us;
+            fault = false;
+        }
+    }
+}
+
+/* Excursion of VBUS at a time from the trace start, -1 if none */
+static int32_t replay_excursion_at(const replay_ref_t *ref, uint64_t t)
+{
+    size_t idx = 0;
+    size_t lo = 0;
+    size_t hi = replay_trace.size();
+
+    /* Last sample at or before t */
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2u;
+
+        if (replay_trace[mid].time_us <= t)
+        {
+            idx = mid;
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return ((replay_trace.empty()) || (replay_trace[0].time_us > t)) ? -1 : ref->excursion[idx];
+}
+
+/* Matches the trips of the run to the real faults of the channel */
+static void replay_match(const replay_ref_t *ref, replay_result_t *res)
+{
+    const replay_fault_t *prev = NULL;
+
+    memset(res, 0, sizeof(*res));
+    res->lat_min = UINT64_MAX;
+    res->predicted = replay_predicted;
+    std::sort(replay_trips.begin(), replay_trips.end());
+
+    for (const replay_fault_t &f : ref->faults)
+    {
+        uint64_t from = f.excursion_start;
+        std::vector<uint64_t>::const_iterator trip;
+
+        /* A trip during the previous fault of the excursion belongs to it */
+        if ((prev != NULL) && (prev->excursion == f.excursion) && (f.excursion >= 0))
+        {
+            from = std::max(from, prev->end + 1u);
+        }
+        prev = &f;
+        res->faults++;
+
+        trip = std::lower_bound(replay_trips.begin(), replay_trips.end(), from);
+        if ((trip == replay_trips.end()) || (*trip > f.end))
+        {
+            res->missed++;
+            continue;
+        }
+
+        uint64_t lat = (*trip > f.start) ? (*trip - f.start) : 0u;
+
+        res->detected++;
+        res->lat_sum += lat;
+        res->lat_min = std::min(res->lat_min, lat);
+        res->lat_max = std::max(res->lat_max, lat);
+    }
+
+    for (uint64_t t : replay_trips)
+    {
+        int32_t excursion = replay_excursion_at(ref, t);
+
+        if ((excursion < 0) || !ref->excursion_fault[excursion])
+        {
+            res->false_trips++;
+        }
+    }
+}
+
+/* Turns the provider FET back on once both channels are armed at their trip
+ * thresholds again. The firmware leaves this to the PD stack after a
+ * hardware turn-off, the stack is not part of the simulator.
+ */
+static void replay_stack(void)
+{
+    if (!sim_fet_on(0u) &&
+        sim_comp_armed(0u, SIM_COMP_OV) && (sim_comp_level(0u, SIM_COMP_OV) == replay_trip_level[SIM_COMP_OV]) &&
+        sim_comp_armed(0u, SIM_COMP_UV) && (sim_comp_level(0u, SIM_COMP_UV) == replay_trip_level[SIM_COMP_UV]))
+    {
+        Cy_USBPD_Vbus_GdrvPfetOn(&USBPD_context[0], false);
+    }
+}
+
+/* Boots the firmware with the setting in replay_setting at the contract
+ * voltage, returns with both channels armed at their trip thresholds
+ */
+static void replay_boot(void)
+{
+    const replay_setting_t *set = &replay_setting;
+
+    /* The filter setting is half the configured debounce, rounded up */
+    sim_ovp_config[0].debounce = (uint8_t)(set->deb * 2u);
+    sim_uvp_config[0].debounce = (uint8_t)(set->deb * 2u);
+    if (set->comp == SIM_COMP_OV)
+    {
+        sim_ovp_config[0].threshold = (uint8_t)set->pct;
+    }
+    else
+    {
+        sim_uvp_config[0].threshold = (uint8_t)set->pct;
+    }
+    sim_param.vbus_mv[0] = replay_contract;
+
+    sim_observe(replay_observer);
+    sim_boot(NULL);
+    sim_run_us(REPLAY_SETTLE_US);
+    vbus_set_contract(0u, replay_contract);
+    sim_run_us(REPLAY_SETTLE_US);
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_OV));
+    SIM_CHECK(sim_comp_armed(0u, SIM_COMP_UV));
+    SIM_CHECK(sim_fet_on(0u));
+
+    replay_trip_level[SIM_COMP_OV] = sim_comp_level(0u, SIM_COMP_OV);
+    replay_trip_level[SIM_COMP_UV] = sim_comp_level(0u, SIM_COMP_UV);
+}
+
+/* Pre-pass child: the trip thresholds armed for the setting of a job */
+static void replay_probe(replay_job_t *job)
+{
+    replay_setting = job->set;
+    replay_boot();
+    job->level[SIM_COMP_OV] = replay_trip_level[SIM_COMP_OV];
+    job->level[SIM_COMP_UV] = replay_trip_level[SIM_COMP_UV];
+    job->thr = sim_comp_threshold_mv(0u, job->set.comp);
+}
+
+/* Replay child: drives the trace and matches the trips of a job */
+static void replay_run(replay_job_t *job)
+{
+    uint64_t end;
+
+    replay_setting = job->set;
+    replay_boot();
+    replay_start_us = sim_time_us();
+    replay_running = true;
+    sim_vbus_trace(0u, replay_trace.data(), replay_trace.size());
+    end = replay_start_us + replay_trace.back().time_us + REPLAY_TAIL_US;
+    while (sim_time_us() < end)
+    {
+        sim_run_us(REPLAY_STACK_US);
+        replay_stack();
+    }
+    SIM_CHECK(sim_vbus_trace_done(0u));
+    replay_running = false;
+
+    replay_match(&replay_ref[job->set.comp], &job->res);
+}
+
+/* Runs fn for the listed jobs in child processes, at most jobs at a time.
+ * Returns the number of children that failed.
+ */
+static int replay_pool(const std::vector<size_t> &list, void (*fn)(replay_job_t *job), unsigned jobs)
+{
+    std::vector<pid_t> running(list.size(), 0);
+    size_t next = 0;
+    unsigned active = 0;
+    int failed = 0;
+    int status;
+    pid_t pid;
+    size_t idx;
+
+    while ((next < list.size()) || (active != 0u))
+    {
+        if ((next < list.size()) && (active < jobs))
+        {
+            fflush(stdout);
+            fflush(stderr);
+            pid = fork();
+            if (pid == 0)
+            {
+                fn(&replay_jobs[list[next]]);
+                _exit(0);
+            }
+            if (pid < 0)
+            {
+                perror("fork");
+                return failed + 1;
+            }
+            running[next++] = pid;
+            active++;
+            continue;
+        }
+
+        pid = wait(&status);
+        if (pid < 0)
+        {
+            perror("wait");
+            return failed + 1;
+        }
+        for (idx = 0; idx < next; idx++)
+        {
+            if (running[idx] == pid)
+            {
+                break;
+            }
+        }
+        if (idx == next)
+        {
+            continue;
+        }
+        running[idx] = 0;
+        active--;
+        if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            const replay_setting_t *set = &replay_jobs[list[idx]].set;
+
+            fprintf(stderr, "%s %u%% debounce %u: replay failed\n", (set->comp == SIM_COMP_OV) ? "ov" : "uv",
+                    set->pct, set->deb);
+            failed++;
+        }
+        else
+        {
+            replay_jobs[list[idx]].done = true;
+        }
+    }
+    return failed;
+}
+
+/* Adds the jobs of a channel sweep */
+static void sweep_add(std::vector<replay_job_t> &jobs, uint8_t comp, const range_t *pct, const range_t *deb)
+{
+    replay_job_t job;
+    unsigned p;
+    unsigned d;
+
+    memset(&job, 0, sizeof(job));
+    job.set.comp = comp;
+    for (p = pct->lo; p <= pct->hi; p += pct->step)
+    {
+        for (d = deb->lo; (d <= deb->hi) && (d <= MAX_UVP_DEBOUNCE_CYCLES); d += deb->step)
+        {
+            job.set.pct = p;
+            job.set.deb = d;
+            jobs.push_back(job);
+        }
+    }
+}
+
+/*
+ * Runs the sweep. A pre-pass boots the firmware once per threshold
+ * percentage and reads the trip thresholds it arms; percentages that
+ * quantize to the same ladder codes behave the same, so only the first
+ * setting of every group replays the trace and the others take its result.
+ * Returns the number of failed children.
+ */
+static int sweep(size_t count, unsigned jobs)
+{
+    std::vector<size_t> list;
+    size_t idx;
+    size_t lead;
+    int failed;
+
+    /* Pre-pass, the first debounce setting of every percentage */
+    for (idx = 0; idx < count; idx++)
+    {
+        if ((idx == 0u) || (replay_jobs[idx].set.comp != replay_jobs[idx - 1u].set.comp) ||
+            (replay_jobs[idx].set.pct != replay_jobs[idx - 1u].set.pct))
+        {
+            list.push_back(idx);
+        }
+    }
+    failed = replay_pool(list, replay_probe, jobs);
+    for (idx = 1; idx < count; idx++)
+    {
+        if ((replay_jobs[idx].set.comp == replay_jobs[idx - 1u].set.comp) &&
+            (replay_jobs[idx].set.pct == replay_jobs[idx - 1u].set.pct))
+        {
+            memcpy(replay_jobs[idx].level, replay_jobs[idx - 1u].level, sizeof(replay_jobs[idx].level));
+            replay_jobs[idx].thr = replay_jobs[idx - 1u].thr;
+            replay_jobs[idx].done = replay_jobs[idx - 1u].done;
+        }
+    }
+
+    /* Replays, one per group of settings with the same thresholds */
+    list.clear();
+    for (idx = 0; idx < count; idx++)
+    {
+        replay_job_t *job = &replay_jobs[idx];
+
+        job->lead = idx;
+        for (lead = 0; lead < idx; lead++)
+        {
+            const replay_job_t *other = &replay_jobs[lead];
+
+            if ((other->lead == lead) && (other->set.comp == job->set.comp) && (other->set.deb == job->set.deb) &&
+                (memcmp(other->level, job->level, sizeof(job->level)) == 0))
+            {
+                job->lead = lead;
+                break;
+            }
+        }
+        if (job->done && (job->lead == idx))
+        {
+            job->done = false;
+            list.push_back(idx);
+        }
+    }
+    failed += replay_pool(list, replay_run, jobs);
+    replay_distinct = list.size();
+
+    for (idx = 0; idx < count; idx++)
+    {
+        const replay_job_t *job = &replay_jobs[idx];
+        const replay_job_t *lead_job = &replay_jobs[job->lead];
+        const replay_result_t *res = &lead_job->res;
+
+        if (!lead_job->done)
+        {
+            continue;
+        }
+        printf("%s,%u,%u,%u,%lu,%lu,%lu,%lu,%lu,", (job->set.comp == SIM_COMP_OV) ? "ov" : "uv", job->set.pct,
+               job->set.deb, (unsigned)job->thr, res->faults, res->detected, res->missed, res->false_trips,
+               res->predicted);
+        if (res->detected != 0u)
+        {
+            printf("%llu,%llu,%llu\n", (unsigned long long)res->lat_min,
+                   (unsigned long long)(res->lat_sum / res->detected), (unsigned long long)res->lat_max);
+        }
+        else
+        {
+            printf(",,\n");
+        }
+    }
+    return failed;
+}
+
+static bool parse_range(const char *arg, range_t *range)
+{
+    int n = sscanf(arg, "%u:%u:%u", &range->lo, &range->hi, &range->step);
+
+    if (n < 2)
+    {
+        return false;
+    }
+    if (n == 2)
+    {
+        range->step = 1u;
+    }
+    return ((range->step != 0u) && (range->lo <= range->hi));
+}
+
+int main(int argc, char *argv[])
+{
+    range_t ov_pct = { 10u, 30u, 5u };
+    range_t uv_pct = { 60u, 80u, 5u };
+    range_t deb = { 0u, MAX_UVP_DEBOUNCE_CYCLES, 4u };
+    unsigned long rate_hz = 0;
+    unsigned long contract = 5000u;
+    uint32_t ov_limit = 0;
+    uint32_t uv_limit = 0;
+    uint64_t min_fault_us = 100u;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned jobs = (cpus > 0) ? (unsigned)cpus : 1u;
+    std::vector<replay_job_t> list;
+    FILE *in;
+    int idx;
+    int failed;
+    bool ok = true;
+
+    for (idx = 1; (idx + 1) < argc && (argv[idx][0] == '-'); idx += 2)
+    {
+        const char *val = argv[idx + 1];
+
+        switch (argv[idx][1])
+        {
+            case 'b': rate_hz = strtoul(val, NULL, 10); break;
+            case 'v': contract = strtoul(val, NULL, 10); break;
+            case 'O': ov_limit = (uint32_t)strtoul(val, NULL, 10); break;
+            case 'U': uv_limit = (uint32_t)strtoul(val, NULL, 10); break;
+            case 'm': min_fault_us = strtoull(val, NULL, 10); break;
+            case 'f': sim_param.filter_hz = (uint32_t)strtoul(val, NULL, 10); break;
+            case 'o': ok = ok && parse_range(val, &ov_pct); break;
+            case 'u': ok = ok && parse_range(val, &uv_pct); break;
+            case 'd': ok = ok && parse_range(val, &deb); break;
+            case 'j': jobs = (unsigned)strtoul(val, NULL, 10); break;
+            default: ok = false; break;
+        }
+    }
+
+    if (!ok || (idx != (argc - 1)) || (sim_param.filter_hz == 0u) || (contract == 0u) || (contract > UINT16_MAX) ||
+        (jobs == 0u))
+    {
+        fprintf(stderr, "usage: %s [-b rate_hz] [-v mv] [-O mv] [-U mv] [-m us] [-f hz] "
+                "[-o lo:hi[:step]] [-u lo:hi[:step]] [-d lo:hi[:step]] [-j jobs] trace\n", argv[0]);
+        return 1;
+    }
+    replay_contract = (uint16_t)contract;
+
+    in = fopen(argv[idx], (rate_hz != 0u) ? "rb" : "r");
+    if (in == NULL)
+    {
+        perror(argv[idx]);
+        return 1;
+    }
+    ok = trace_load(in, rate_hz);
+    fclose(in);
+    if (!ok || replay_trace.empty())
+    {
+        fprintf(stderr, "%s: no samples\n", argv[idx]);
+        return 1;
+    }
+
+    if (ov_limit == 0u)
+    {
+        ov_limit = (contract * 130u) / 100u;
+    }
+    if (uv_limit == 0u)
+    {
+        uv_limit = (contract * 70u) / 100u;
+    }
+    replay_reference(SIM_COMP_OV, ov_limit, min_fault_us);
+    replay_reference(SIM_COMP_UV, uv_limit, min_fault_us);
+
+    printf("channel,threshold_pct,debounce,threshold_mv,faults,detected,missed,false_trips,predicted,"
+           "latency_min_us,latency_mean_us,latency_max_us\n");
+    sweep_add(list, SIM_COMP_OV, &ov_pct, &deb);
+    sweep_add(list, SIM_COMP_UV, &uv_pct, &deb);
+    replay_jobs = (replay_job_t *)mmap(NULL, list.size() * sizeof(replay_job_t), PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (replay_jobs == MAP_FAILED)
+    {
+        perror("mmap");
+        return 1;
+    }
+    memcpy(replay_jobs, list.data(), list.size() * sizeof(replay_job_t));
+    failed = sweep(list.size(), jobs);
+    munmap(replay_jobs, list.size() * sizeof(replay_job_t));
+
+    fprintf(stderr, "samples=%lu settings=%lu replays=%lu\n", (unsigned long)replay_trace.size(),
+            (unsigned long)list.size(), (unsigned long)replay_distinct);
+    return (failed != 0) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,482 @@
+/******************************************************************************
+* File Name: uart_log.c
+*
+* Description: This file contains a non-blocking UART logger. Messages are queued in a
+*              transmit ring from the main loop and sent by the SCB TX FIFO level
+*              interrupt, so logging does not stall fault handling.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "uart_log.h"
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void uart_log_isr(void);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Transmit ring storage */
+static uint8_t uart_log_ring[UART_LOG_RING_SIZE];
+
+/* Free running write index, only written by the main loop */
+static volatile uint16_t uart_log_head = 0;
+
+/* Free running read index, only written by the UART interrupt */
+static volatile uint16_t uart_log_tail = 0;
+
+/* Number of bytes dropped because the ring was full */
+static uint32_t uart_log_overflow = 0;
+
+/* Receive ring storage */
+static uint8_t uart_log_rx_ring[UART_LOG_RX_RING_SIZE];
+
+/* Free running receive write index, only written by the UART interrupt */
+static volatile uint16_t uart_log_rx_head = 0;
+
+/* Free running receive read index, only written by the main loop */
+static volatile uint16_t uart_log_rx_tail = 0;
+
+/* Powers of ten used by the division-free decimal formatter */
+static const uint32_t uart_log_pow10[] =
+{
+    1000000000u, 100000000u, 10000000u, 1000000u, 100000u,
+    10000u, 1000u, 100u, 10u, 1u
+};
+
+/* UART interrupt configuration */
+static const cy_stc_sysint_t uart_log_intr_config =
+{
+    .intrSrc = (IRQn_Type)CYBSP_UART_IRQ,
+    .intrPriority = UART_LOG_INTR_PRIORITY,
+};
+
+/*******************************************************************************
+* Function Name: uart_log_service
+********************************************************************************
+* Summary:
+*  Moves queued bytes into the TX FIFO until the FIFO is full or the ring is
+*  empty. Disables the TX interrupt once the ring is empty.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_log_service(void)
+{
+    uint16_t tail = uart_log_tail;
+
+    while (tail != uart_log_head)
+    {
+        if (Cy_SCB_UART_Put(CYBSP_UART_HW, uart_log_ring[tail & (UART_LOG_RING_SIZE - 1u)]) == 0u)
+        {
+            break;
+        }
+        tail++;
+    }
+    uart_log_tail = tail;
+
+    if (tail == uart_log_head)
+    {
+        Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, 0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_log_rx_service
+********************************************************************************
+* Summary:
+*  Moves received bytes from the RX FIFO into the receive ring. Bytes that do
+*  not fit into the ring are dropped.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_log_rx_service(void)
+{
+    uint16_t head = uart_log_rx_head;
+    uint32_t data;
+
+    while ((data = Cy_SCB_UART_Get(CYBSP_UART_HW)) != CY_SCB_UART_RX_NO_DATA)
+    {
+        if ((uint16_t)(head - uart_log_rx_tail) < UART_LOG_RX_RING_SIZE)
+        {
+            uart_log_rx_ring[head & (UART_LOG_RX_RING_SIZE - 1u)] = (uint8_t)data;
+            head++;
+        }
+    }
+    uart_log_rx_head = head;
+}
+
+/*******************************************************************************
+* Function Name: uart_log_isr
+********************************************************************************
+* Summary:
+*  UART interrupt handler, refills the TX FIFO from the ring and empties the
+*  RX FIFO into the receive ring.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_log_isr(void)
+{
+    if ((Cy_SCB_GetTxInterruptStatusMasked(CYBSP_UART_HW) & CY_SCB_TX_INTR_LEVEL) != 0u)
+    {
+        uart_log_service();
+        Cy_SCB_ClearTxInterrupt(CYBSP_UART_HW, CY_SCB_TX_INTR_LEVEL);
+    }
+    if ((Cy_SCB_GetRxInterruptStatusMasked(CYBSP_UART_HW) & CY_SCB_RX_INTR_NOT_EMPTY) != 0u)
+    {
+        uart_log_rx_service();
+        Cy_SCB_ClearRxInterrupt(CYBSP_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_log_init
+********************************************************************************
+* Summary:
+*  Hooks the logger to the UART interrupt. The UART must already be
+*  initialized and enabled.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_log_init(void)
+{
+    /* Interrupt when the TX FIFO drops below half full */
+    Cy_SCB_SetTxFifoLevel(CYBSP_UART_HW, Cy_SCB_GetFifoSize(CYBSP_UART_HW) / 2u);
+    Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, 0u);
+
+    (void)Cy_SysInt_Init(&uart_log_intr_config, &uart_log_isr);
+    NVIC_EnableIRQ(uart_log_intr_config.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: uart_log_write
+********************************************************************************
+* Summary:
+*  Queues bytes for transmission without blocking. Bytes that do not fit into
+*  the ring are dropped and counted. Only called from the main loop.
+*
+* Parameters:
+*  data - bytes to send
+*  len - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_log_write(const uint8_t *data, uint32_t len)
+{
+    uint16_t head = uart_log_head;
+    uint16_t space = (uint16_t)(UART_LOG_RING_SIZE - (uint16_t)(head - uart_log_tail));
+
+    if (len > space)
+    {
+        uart_log_overflow += (len - space);
+        len = space;
+    }
+
+    while (len != 0u)
+    {
+        uart_log_ring[head & (UART_LOG_RING_SIZE - 1u)] = *data++;
+        head++;
+        len--;
+    }
+    uart_log_head = head;
+
+    /* Start or keep the FIFO refill going */
+    Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, CY_SCB_TX_INTR_LEVEL);
+}
+
+/*******************************************************************************
+* Function Name: uart_log_write_frame
+********************************************************************************
+* Summary:
+*  Queues a block of bytes only if it fits into the ring as a whole, so binary
+*  frames are never truncated. A block that does not fit is dropped and its
+*  size added to the overflow counter. Only called from the main loop.
+*
+* Parameters:
+*  data - bytes to send
+*  len - number of bytes
+*
+* Return:
+*  bool - true if the block was queued
+*
+*******************************************************************************/
+bool uart_log_write_frame(const uint8_t *data, uint32_t len)
+{
+    if (len > (uint32_t)(UART_LOG_RING_SIZE - (uint16_t)(uart_log_head - uart_log_tail)))
+    {
+        uart_log_overflow += len;
+        return false;
+    }
+
+    uart_log_write(data, len);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uart_log_puts
+********************************************************************************
+* Summary:
+*  Queues a null-terminated string.
+*
+* Parameters:
+*  str - string to send
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_log_puts(const char *str)
+{
+    uart_log_write((const uint8_t *)str, (uint32_t)strlen(str));
+}
+
+/*******************************************************************************
+* Function Name: uart_log_hex32
+********************************************************************************
+* Summary:
+*  Queues a value as 0x-prefixed, 8 digit upper case hexadecimal.
+*
+* Parameters:
+*  value - value to send
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_log_hex32(uint32_t value)
+{
+    uint8_t buf[10];
+    uint8_t idx;
+    uint8_t nibble;
+
+    buf[0] = '0';
+    buf[1] = 'x';
+    for (idx = 0; idx < 8u; idx++)
+    {
+        nibble = (uint8_t)((value >> (28u - (idx * 4u))) & 0x0Fu);
+        buf[2u + idx] = (nibble < 10u) ? (uint8_t)('0' + nibble) : (uint8_t)('A' + nibble - 10u);
+    }
+    uart_log_write(buf, sizeof(buf));
+}
+
+/*******************************************************************************
+* Function Name: uart_log_dec
+********************************************************************************
+* Summary:
+*  Queues a value in decimal without leading zeros.
+*
+* Parameters:
+*  value - value to send
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_log_dec(uint32_t value)
+{
+    uint8_t buf[10];
+
+    uart_log_write(buf, uart_log_format_dec(buf, value));
+}
+
+/*******************************************************************************
+* Function Name: uart_log_format_dec
+********************************************************************************
+* Summary:
+*  Formats a value in decimal without leading zeros. Digits are produced by
+*  repeated subtraction, no division is used.
+*
+* Parameters:
+*  buf - destination of at least 10 characters, not terminated
+*  value - value to format
+*
+* Return:
+*  uint8_t - number of characters stored
+*
+*******************************************************************************/
+uint8_t uart_log_format_dec(uint8_t *buf, uint32_t value)
+{
+    uint8_t len = 0;
+    uint8_t idx;
+    uint8_t digit;
+
+    for (idx = 0; idx < (sizeof(uart_log_pow10) / sizeof(uart_log_pow10[0])); idx++)
+    {
+        digit = 0;
+        while (value >= uart_log_pow10[idx])
+        {
+            value -= uart_log_pow10[idx];
+            digit++;
+        }
+        if ((digit != 0u) || (len != 0u) || (uart_log_pow10[idx] == 1u))
+        {
+            buf[len++] = (uint8_t)('0' + digit);
+        }
+    }
+    return len;
+}
+
+/*******************************************************************************
+* Function Name: uart_log_pending
+********************************************************************************
+* Summary:
+*  Returns whether queued bytes are still waiting for the TX FIFO.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool uart_log_pending(void)
+{
+    return (uart_log_head != uart_log_tail);
+}
+
+/*******************************************************************************
+* Function Name: uart_log_flush
+********************************************************************************
+* Summary:
+*  Blocks until all queued bytes have been written into the TX FIFO. Only
+*  intended for fatal error paths.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_log_flush(void)
+{
+    uint32_t intr_state;
+
+    while (uart_log_pending())
+    {
+        intr_state = Cy_SysLib_EnterCriticalSection();
+        uart_log_service();
+        Cy_SysLib_ExitCriticalSection(intr_state);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_log_get_overflow
+********************************************************************************
+* Summary:
+*  Returns the number of bytes dropped because the ring was full.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t uart_log_get_overflow(void)
+{
+    return uart_log_overflow;
+}
+
+/*******************************************************************************
+* Function Name: uart_log_rx_start
+********************************************************************************
+* Summary:
+*  Enables the reception into the receive ring. Called once after
+*  uart_log_init().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_log_rx_start(void)
+{
+    Cy_SCB_SetRxInterruptMask(CYBSP_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+}
+
+/*******************************************************************************
+* Function Name: uart_log_getc
+********************************************************************************
+* Summary:
+*  Takes one received byte from the receive ring without blocking. Only called
+*  from the main loop.
+*
+* Parameters:
+*  byte - received byte
+*
+* Return:
+*  bool - false if no byte was received
+*
+*******************************************************************************/
+bool uart_log_getc(uint8_t *byte)
+{
+    uint16_t tail = uart_log_rx_tail;
+
+    if (tail == uart_log_rx_head)
+    {
+        return false;
+    }
+    *byte = uart_log_rx_ring[tail & (UART_LOG_RX_RING_SIZE - 1u)];
+    uart_log_rx_tail = (uint16_t)(tail + 1u);
+    return true;
+}
+
+/* [] END OF FILE */
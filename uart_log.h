@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name: uart_log.h
+*
+* Description: This is the header file for the interrupt driven UART logger of the PMG1
+*              MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _UART_LOG_H_
+#define _UART_LOG_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the transmit ring in bytes, must be a power of two */
+#define UART_LOG_RING_SIZE          (256u)
+
+/* Size of the receive ring in bytes, must be a power of two */
+#define UART_LOG_RX_RING_SIZE       (64u)
+
+/* Priority of the UART interrupt, lower than the USBPD interrupt */
+#define UART_LOG_INTR_PRIORITY      (3u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uart_log_init(void);
+
+void uart_log_write(const uint8_t *data, uint32_t len);
+
+bool uart_log_write_frame(const uint8_t *data, uint32_t len);
+
+void uart_log_puts(const char *str);
+
+void uart_log_hex32(uint32_t value);
+
+void uart_log_dec(uint32_t value);
+
+uint8_t uart_log_format_dec(uint8_t *buf, uint32_t value);
+
+bool uart_log_pending(void);
+
+void uart_log_flush(void);
+
+uint32_t uart_log_get_overflow(void);
+
+void uart_log_rx_start(void);
+
+bool uart_log_getc(uint8_t *byte);
+
+#endif /* _UART_LOG_H_ */
+
+/* End of file [] */
@@ -0,0 +1,456 @@
+/******************************************************************************
+* File Name: uart_shell.c
+*
+* Description: This file contains a line oriented command shell on the UART. Received
+*              bytes are taken from the UART logger receive ring by a scheduler task, so
+*              command processing never runs in interrupt context.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "uart_shell.h"
+#include "uart_log.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Command table supplied by the application */
+static const uart_shell_cmd_t *uart_shell_cmds = NULL;
+
+/* Number of entries in the command table */
+static uint8_t uart_shell_cmd_count = 0;
+
+/* Line being received, terminated in place by the tokenizer */
+static char uart_shell_line[UART_SHELL_LINE_LEN + 1u];
+
+/* Number of characters in the line */
+static uint8_t uart_shell_len = 0;
+
+/* Set when the line did not fit, the rest of the line is discarded */
+static bool uart_shell_overrun = false;
+
+/* Reply output, NULL to write the replies to the UART as they are */
+static uart_shell_out_t uart_shell_out = NULL;
+
+/* Reply text not passed to the output yet */
+static uint8_t uart_shell_out_buf[UART_SHELL_OUT_LEN];
+
+/* Number of characters in uart_shell_out_buf */
+static uint8_t uart_shell_out_len = 0;
+
+/*******************************************************************************
+* Function Name: uart_shell_init
+********************************************************************************
+* Summary:
+*  Sets the command table and enables the UART reception.
+*
+* Parameters:
+*  cmds - command table
+*  count - number of entries in the command table
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_shell_init(const uart_shell_cmd_t *cmds, uint8_t count)
+{
+    uart_shell_cmds = cmds;
+    uart_shell_cmd_count = count;
+    uart_shell_len = 0;
+    uart_shell_overrun = false;
+
+    uart_log_rx_start();
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_set_output
+********************************************************************************
+* Summary:
+*  Sets the output of the command replies, e.g. to wrap them into telemetry
+*  frames when the UART also carries a binary stream.
+*
+* Parameters:
+*  out - reply output, NULL to write the replies to the UART as they are
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_shell_set_output(uart_shell_out_t out)
+{
+    uart_shell_out = out;
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_flush
+********************************************************************************
+* Summary:
+*  Passes the buffered reply text to the output.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_shell_flush(void)
+{
+    if (uart_shell_out_len == 0u)
+    {
+        return;
+    }
+    if (uart_shell_out != NULL)
+    {
+        uart_shell_out(uart_shell_out_buf, uart_shell_out_len);
+    }
+    else
+    {
+        uart_log_write(uart_shell_out_buf, uart_shell_out_len);
+    }
+    uart_shell_out_len = 0;
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_write
+********************************************************************************
+* Summary:
+*  Adds reply text to the output buffer. The buffer is passed to the output at
+*  every line end and whenever it is full.
+*
+* Parameters:
+*  text - reply text
+*  len - number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_shell_write(const uint8_t *text, uint8_t len)
+{
+    uint8_t idx;
+
+    for (idx = 0; idx < len; idx++)
+    {
+        uart_shell_out_buf[uart_shell_out_len++] = text[idx];
+        if ((text[idx] == '\n') || (uart_shell_out_len == UART_SHELL_OUT_LEN))
+        {
+            uart_shell_flush();
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_puts
+********************************************************************************
+* Summary:
+*  Adds a string to the reply of the command being executed.
+*
+* Parameters:
+*  str - NUL terminated string
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_shell_puts(const char *str)
+{
+    uart_shell_write((const uint8_t *)str, (uint8_t)strlen(str));
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_dec
+********************************************************************************
+* Summary:
+*  Adds a value in decimal to the reply of the command being executed.
+*
+* Parameters:
+*  value - value to add
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_shell_dec(uint32_t value)
+{
+    uint8_t buf[10];
+
+    uart_shell_write(buf, uart_log_format_dec(buf, value));
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_ok
+********************************************************************************
+* Summary:
+*  Sends the success reply of a command.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_shell_ok(void)
+{
+    uart_shell_puts("OK\r\n");
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_error
+********************************************************************************
+* Summary:
+*  Sends the failure reply of a command.
+*
+* Parameters:
+*  reason - short failure reason
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_shell_error(const char *reason)
+{
+    uart_shell_puts("ERR ");
+    uart_shell_puts(reason);
+    uart_shell_puts("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_parse_u16
+********************************************************************************
+* Summary:
+*  Parses an unsigned decimal argument.
+*
+* Parameters:
+*  str - argument
+*  value - parsed value
+*
+* Return:
+*  bool - false if the argument is not a number or does not fit in 16 bits
+*
+*******************************************************************************/
+bool uart_shell_parse_u16(const char *str, uint16_t *value)
+{
+    uint32_t result = 0;
+
+    if (*str == '\0')
+    {
+        return false;
+    }
+    while (*str != '\0')
+    {
+        if ((*str < '0') || (*str > '9'))
+        {
+            return false;
+        }
+        result = (result * 10u) + (uint32_t)(*str - '0');
+        if (result > 0xFFFFu)
+        {
+            return false;
+        }
+        str++;
+    }
+    *value = (uint16_t)result;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_tokenize
+********************************************************************************
+* Summary:
+*  Splits the line into space separated tokens. The separators are replaced
+*  by terminators, so the tokens point into the line itself.
+*
+* Parameters:
+*  line - line to split
+*  argv - token table of UART_SHELL_MAX_ARGS entries
+*
+* Return:
+*  uint8_t - number of tokens, 0xFF if the line has too many tokens
+*
+*******************************************************************************/
+static uint8_t uart_shell_tokenize(char *line, char *argv[])
+{
+    uint8_t argc = 0;
+
+    while (*line != '\0')
+    {
+        if ((*line == ' ') || (*line == '\t'))
+        {
+            *line++ = '\0';
+            continue;
+        }
+        if (argc == UART_SHELL_MAX_ARGS)
+        {
+            return 0xFFu;
+        }
+        argv[argc++] = line;
+        while ((*line != '\0') && (*line != ' ') && (*line != '\t'))
+        {
+            line++;
+        }
+    }
+    return argc;
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_help
+********************************************************************************
+* Summary:
+*  Lists the commands of the command table.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_shell_help(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < uart_shell_cmd_count; i++)
+    {
+        uart_shell_puts(uart_shell_cmds[i].name);
+        uart_shell_puts(" ");
+        uart_shell_puts(uart_shell_cmds[i].usage);
+        uart_shell_puts("\r\n");
+    }
+    uart_shell_ok();
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_execute
+********************************************************************************
+* Summary:
+*  Tokenizes a complete line and calls the matching command handler.
+*
+* Parameters:
+*  line - received line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_shell_execute(char *line)
+{
+    char *argv[UART_SHELL_MAX_ARGS];
+    uint8_t argc;
+    uint8_t i;
+
+    argc = uart_shell_tokenize(line, argv);
+    if (argc == 0u)
+    {
+        return;
+    }
+    if (argc == 0xFFu)
+    {
+        uart_shell_error("args");
+        return;
+    }
+    if (strcmp(argv[0], "help") == 0)
+    {
+        uart_shell_help();
+        return;
+    }
+    for (i = 0; i < uart_shell_cmd_count; i++)
+    {
+        if (strcmp(argv[0], uart_shell_cmds[i].name) == 0)
+        {
+            uart_shell_cmds[i].handler(argc, argv);
+            return;
+        }
+    }
+    uart_shell_error("cmd");
+}
+
+/*******************************************************************************
+* Function Name: uart_shell_task
+********************************************************************************
+* Summary:
+*  Scheduler task of the shell. Takes the received bytes from the receive
+*  ring and executes at most one complete line per run, so a burst of input
+*  never holds the main loop for long.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_shell_task(void)
+{
+    uint8_t byte;
+
+    while (uart_log_getc(&byte))
+    {
+        if ((byte == '\r') || (byte == '\n'))
+        {
+            if (uart_shell_overrun)
+            {
+                uart_shell_overrun = false;
+                uart_shell_error("line");
+            }
+            else if (uart_shell_len != 0u)
+            {
+                uart_shell_line[uart_shell_len] = '\0';
+                uart_shell_len = 0;
+                uart_shell_execute(uart_shell_line);
+                break;
+            }
+        }
+        else if (uart_shell_overrun)
+        {
+            /* Discard the rest of a line that did not fit */
+        }
+        else if (uart_shell_len < UART_SHELL_LINE_LEN)
+        {
+            uart_shell_line[uart_shell_len++] = (char)byte;
+        }
+        else
+        {
+            uart_shell_len = 0;
+            uart_shell_overrun = true;
+        }
+    }
+
+    /* Pass on a reply that does not end with a line end */
+    uart_shell_flush();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name: uart_shell.h
+*
+* Description: This is the header file for the UART command shell of the PMG1 MCU
+*              Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _UART_SHELL_H_
+#define _UART_SHELL_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* UART shell macro, can also be set through DEFINES in the Makefile */
+#ifndef UART_SHELL_ENABLE
+#define UART_SHELL_ENABLE           (0u)
+#endif
+
+/* Period in ms of the shell task */
+#define UART_SHELL_PERIOD_MS        (10u)
+
+/* Longest accepted command line in characters, without the terminator */
+#define UART_SHELL_LINE_LEN         (48u)
+
+/* Largest number of tokens in a command line, including the command name */
+#define UART_SHELL_MAX_ARGS         (6u)
+
+/* Largest block of reply text passed to the output at once. Replies are
+ * passed line by line; a longer line is split into blocks of this size.
+ */
+#define UART_SHELL_OUT_LEN          (32u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Command handler, argv[0] is the command name */
+typedef void (*uart_shell_handler_t)(uint8_t argc, char *argv[]);
+
+/* Reply output, receives one block of reply text of at most UART_SHELL_OUT_LEN bytes */
+typedef void (*uart_shell_out_t)(const uint8_t *text, uint8_t len);
+
+/* Command table entry */
+typedef struct
+{
+    const char *name;               /* Command name */
+    const char *usage;              /* Arguments shown by help */
+    uart_shell_handler_t handler;   /* Command handler */
+} uart_shell_cmd_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uart_shell_init(const uart_shell_cmd_t *cmds, uint8_t count);
+
+void uart_shell_task(void);
+
+void uart_shell_set_output(uart_shell_out_t out);
+
+void uart_shell_puts(const char *str);
+
+void uart_shell_dec(uint32_t value);
+
+bool uart_shell_parse_u16(const char *str, uint16_t *value);
+
+void uart_shell_ok(void);
+
+void uart_shell_error(const char *reason);
+
+#endif /* _UART_SHELL_H_ */
+
+/* End of file [] */
@@ -43,53 +43,168 @@
 
 #if defined(CY_DEVICE_SERIES_PMG1S2)
 
+/* Bit position of a single set bit, indexed by (bit * PMG1S2_DEBRUIJN32) >> 27 */
+static const uint8_t PMG1S2_Intr3BitPos[PMG1S2_INTR3_SOURCES] =
+{
+    0u, 1u, 28u, 2u, 29u, 14u, 24u, 3u, 30u, 22u, 20u, 15u, 25u, 17u, 4u, 8u,
+    31u, 27u, 13u, 23u, 21u, 19u, 16u, 7u, 26u, 12u, 18u, 6u, 11u, 5u, 10u, 9u
+};
+
+/* INTR3 source handlers indexed by bit position, NULL for unused sources */
+static PMG1S2_Intr3Handler_t PMG1S2_Intr3Handlers[PMG1S2_INTR3_SOURCES];
+
+/* INTR3 sources with a registered handler, the only ones the dispatcher touches */
+static uint32_t PMG1S2_Intr3Registered;
+
 /*******************************************************************************
-* Function Name: PMG1_S2_Vbus_UvpEnable
+* Function Name: PMG1S2_Vbus_UvLevelGet
 ****************************************************************************//**
 *
-* Enable Under Voltage Protection (UVP) control for the PMG1-S2 device using the internal UV-OV block.
-* UVP is only expected to be used while PD-port is the power source.
+* Convert a UVP threshold voltage into the UV comparator ladder code (uv_in).
+* The step divisions are replaced by the compile-time reciprocals from uvov.h,
+* which give the same code as the divide-based calculation for every
+* 16-bit threshold value.
 *
-* \param context
-* The pointer to the context structure \ref cy_stc_usbpd_context_t allocated
-* by the user. The structure is used during the USBPD operation for internal
-* configuration and data retention. The user must not modify anything
-* in this structure.
+* \param threshold
+* UVP threshold in mV units.
 *
-* \param volt
-* Contract Voltage in mV units.
+* \return
+* Ladder code to be programmed into the UV_IN field of uvov_ctrl.
 *
-* \param cb
-* Callback function to be called on fault detection.
+*******************************************************************************/
+uint8_t PMG1S2_Vbus_UvLevelGet(uint16_t threshold)
+{
+    uint8_t level;
+
+    if (threshold < UVOV_LADDER_BOT)
+    {
+        level = UVOV_CODE_BOT;
+    }
+    else if (threshold > UVOV_LADDER_TOP)
+    {
+        level = UVOV_CODE_TOP;
+    }
+    else if (threshold <= UVOV_LADDER_MID)
+    {
+        level = (uint8_t)(((uint32_t)(threshold - UVOV_LADDER_BOT) * UVOV_LO_STEP_RECIP) >> UVOV_RECIP_SHIFT);
+    }
+    else
+    {
+        level = (uint8_t)((((uint32_t)(threshold - UVOV_LADDER_MID) * UVOV_HI_STEP_RECIP) >> UVOV_RECIP_SHIFT) + UVOV_CODE_MID);
+    }
+
+    return level;
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_OvLevelGet
+****************************************************************************//**
 *
-* \param pctrl
-* Flag indicating the type of gate driver to be controlled, true for
-* P_CTRL and false for C_CTRL.
+* Convert an OVP threshold voltage into the OV comparator ladder code (ov_in).
+* Unlike the UV code, the OV code is rounded up to the first ladder voltage at
+* or above the threshold, as done by the PDL, and is not limited to
+* UVOV_CODE_TOP.
+*
+* \param threshold
+* OVP threshold in mV units.
+*
+* \return
+* Ladder code to be programmed into the OV_IN field of uvov_ctrl.
 *
 *******************************************************************************/
-void PMG1S2_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb_vbus_fault_t cb, bool pctrl)
+uint8_t PMG1S2_Vbus_OvLevelGet(uint16_t threshold)
+{
+    uint32_t level;
+
+    if (threshold <= UVOV_LADDER_BOT)
+    {
+        level = UVOV_CODE_BOT;
+    }
+    else if (threshold <= UVOV_LADDER_MID)
+    {
+        level = ((uint32_t)(threshold - UVOV_LADDER_BOT + UVOV_LO_STEP_SZ - 1u) * UVOV_LO_STEP_RECIP) >> UVOV_RECIP_SHIFT;
+    }
+    else
+    {
+        level = (((uint32_t)(threshold - UVOV_LADDER_MID + UVOV_HI_STEP_SZ - 1u) * UVOV_HI_STEP_RECIP) >> UVOV_RECIP_SHIFT) + UVOV_CODE_MID;
+    }
+
+    return (uint8_t)CY_USBPD_GET_MIN(level, UVOV_CODE_MAX);
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_LadderVolt
+****************************************************************************//**
+*
+* Return the lowest threshold voltage that selects a given ladder code, i.e.
+* the inverse of \ref PMG1S2_Vbus_UvLevelGet for codes up to UVOV_CODE_TOP.
+*
+* \param level
+* Ladder code.
+*
+* \return
+* Threshold voltage in mV units.
+*
+*******************************************************************************/
+uint16_t PMG1S2_Vbus_LadderVolt(uint8_t level)
+{
+    if (level <= UVOV_CODE_MID)
+    {
+        return (uint16_t)(UVOV_LADDER_BOT + ((uint32_t)level * UVOV_LO_STEP_SZ));
+    }
+    return (uint16_t)(UVOV_LADDER_MID + ((uint32_t)(level - UVOV_CODE_MID) * UVOV_HI_STEP_SZ));
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvpFilterSelGet
+****************************************************************************//**
+*
+* Return the UV comparator debounce filter setting derived from the VBUS OVP
+* debounce configuration, limited to MAX_UVP_DEBOUNCE_CYCLES.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t.
+*
+* \return
+* Debounce filter setting (filterSel).
+*
+*******************************************************************************/
+uint8_t PMG1S2_Vbus_UvpFilterSelGet(cy_stc_usbpd_context_t *context)
 {
-    PPDSS_REGS_T pd = context->base;
-    uint16_t threshold;
-    uint16_t uvpLimit = UVP_MIN_VOLT;
-    uint32_t regVal = 0;
     uint8_t filterSel;
-    uint8_t level;
 
     filterSel = (GET_VBUS_OVP_TABLE(context)->debounce + 1) / 2;
     filterSel = CY_USBPD_GET_MIN (filterSel, MAX_UVP_DEBOUNCE_CYCLES);
 
-    /* Clear AUTO MODE OVP detect to avoid false auto off during reference change */
-    if (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL)
-    {
-        Cy_USBPD_Fault_FetAutoModeDisable (context, pctrl, CY_USBPD_VBUS_FILTER_ID_OV);
-    }
+    return filterSel;
+}
 
-    /* Set up UVP callback. */
-    context->vbusUvpCbk = cb;
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvpLevelCalc
+****************************************************************************//**
+*
+* Calculate the UV comparator ladder code for a contract voltage using the UVP
+* threshold percentage of the port configuration. Does not access any
+* register, so it can be called outside of a critical section ahead of
+* \ref PMG1S2_Vbus_UvpLevelSet.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t.
+*
+* \param volt
+* Contract Voltage in mV units.
+*
+* \return
+* Ladder code to be programmed into the UV_IN field of uvov_ctrl.
+*
+*******************************************************************************/
+uint8_t PMG1S2_Vbus_UvpLevelCalc(cy_stc_usbpd_context_t *context, uint16_t volt)
+{
+    uint16_t threshold;
+    uint16_t uvpLimit = UVP_MIN_VOLT;
 
     /* Calculate required VBUS for UVP. */
-    threshold = ((volt * GET_VBUS_UVP_TABLE(context)->threshold) / 100);
+    threshold = UVOV_PERCENT_OF(volt, GET_VBUS_UVP_TABLE(context)->threshold);
 
     /* Ensure that we are within the limits. */
     if (threshold < uvpLimit)
@@ -100,37 +215,89 @@ void PMG1S2_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb
     /*
      * Calculate UVP comparator threshold setting.
      */
-    if (threshold < UVOV_LADDER_BOT)
-    {
-        level = UVOV_CODE_BOT;
-    }
-    else if (threshold > UVOV_LADDER_TOP)
-    {
-        level = UVOV_CODE_TOP;
-    }
-    else if (threshold <= UVOV_LADDER_MID)
-    {
-        level = (uint8_t)((threshold - UVOV_LADDER_BOT) / UVOV_LO_STEP_SZ);
-    }
-    else
+    return PMG1S2_Vbus_UvLevelGet(threshold);
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvpLevelSet
+****************************************************************************//**
+*
+* Program a precalculated UV comparator ladder code and enable UVP on the
+* PMG1-S2 device. Must be called from a critical section.
+*
+* In UVOV_AUTOCTRL mode the comparator needs to settle after the auto FET
+* control has been enabled. Instead of busy-waiting with interrupts disabled,
+* the UV status check and interrupt enable are left to
+* \ref PMG1S2_Vbus_UvpEnableComplete, which the caller must run at least
+* UVP_SETTLE_TIME_US later.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t.
+*
+* \param level
+* Ladder code returned by \ref PMG1S2_Vbus_UvpLevelCalc.
+*
+* \param cb
+* Callback function to be called on fault detection.
+*
+* \param pctrl
+* Flag indicating the type of gate driver to be controlled, true for
+* P_CTRL and false for C_CTRL.
+*
+* \return
+* true if \ref PMG1S2_Vbus_UvpEnableComplete still has to be called.
+*
+*******************************************************************************/
+bool PMG1S2_Vbus_UvpLevelSet(cy_stc_usbpd_context_t *context, uint8_t level, cy_cb_vbus_fault_t cb, bool pctrl)
+{
+    PPDSS_REGS_T pd = context->base;
+    uint32_t regVal = 0;
+
+    /* Clear AUTO MODE OVP detect to avoid false auto off during reference change */
+    if (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL)
     {
-        level = (uint8_t)(((threshold - UVOV_LADDER_MID) / UVOV_HI_STEP_SZ) + UVOV_CODE_MID);
+        Cy_USBPD_Fault_FetAutoModeDisable (context, pctrl, CY_USBPD_VBUS_FILTER_ID_OV);
     }
 
+    /* Set up UVP callback. */
+    context->vbusUvpCbk = cb;
+
     /* Clear UVP positive edge notification. */
     pd->intr3 = PDSS_INTR3_POS_UV_CHANGED;
 
     /* Configure the UVOV block. */
     regVal = pd->uvov_ctrl & ~(PDSS_UVOV_CTRL_UV_IN_MASK | PDSS_UVOV_CTRL_PD_UVOV);
     regVal |= PDSS_UVOV_CTRL_UVOV_ISO_N;
-    pd->uvov_ctrl = (level << PDSS_UVOV_CTRL_UV_IN_POS) | regVal;
+    pd->uvov_ctrl = ((uint32_t)level << PDSS_UVOV_CTRL_UV_IN_POS) | regVal;
 
     if (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL)
     {
         Cy_USBPD_Fault_FetAutoModeEnable (context, pctrl, CY_USBPD_VBUS_FILTER_ID_UV);
-        Cy_SysLib_DelayUs (10);
+
+        /* Let the comparator settle before the status is checked. */
+        return true;
     }
 
+    PMG1S2_Vbus_UvpEnableComplete(context);
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvpEnableComplete
+****************************************************************************//**
+*
+* Second phase of the UVP enable sequence. Flags an undervoltage that is
+* already present and enables the UVP positive edge interrupt. Must be called
+* from a critical section.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t.
+*
+*******************************************************************************/
+void PMG1S2_Vbus_UvpEnableComplete(cy_stc_usbpd_context_t *context)
+{
+    PPDSS_REGS_T pd = context->base;
+
     /* If the UV_DET output is already high, flag it. */
     if (pd->ncell_status & PDSS_NCELL_STATUS_UV_STATUS)
     {
@@ -142,10 +309,42 @@ void PMG1S2_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb
 }
 
 /*******************************************************************************
-* Function Name: PMG1S2_Vbus_UvpIntrHandler
+* Function Name: PMG1S2_Vbus_OvpLevelCalc
+****************************************************************************//**
+*
+* Calculate the OV comparator ladder code that the PDL OVP enable programs for
+* a contract voltage, using the OVP threshold percentage of the port
+* configuration. The OV ladder is not used below 6 V. Does not access any
+* register.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t.
+*
+* \param volt
+* Contract Voltage in mV units.
+*
+* \return
+* Ladder code the PDL programs into the OV_IN field of uvov_ctrl.
+*
+*******************************************************************************/
+uint8_t PMG1S2_Vbus_OvpLevelCalc(cy_stc_usbpd_context_t *context, uint16_t volt)
+{
+    uint32_t threshold;
+    uint8_t level;
+
+    /* Calculate required VBUS for OVP. */
+    threshold = (uint32_t)volt + UVOV_PERCENT_OF(volt, GET_VBUS_OVP_TABLE(context)->threshold);
+    level = PMG1S2_Vbus_OvLevelGet((uint16_t)CY_USBPD_GET_MIN(threshold, UINT16_MAX));
+
+    return (level < UVOV_CODE_6V0) ? UVOV_CODE_6V0 : level;
+}
+
+/*******************************************************************************
+* Function Name: PMG1_S2_Vbus_UvpEnable
 ****************************************************************************//**
 *
-* VBUS UVP fault interrupt handler function for PMG1-S2
+* Enable Under Voltage Protection (UVP) control for the PMG1-S2 device using the internal UV-OV block.
+* UVP is only expected to be used while PD-port is the power source.
 *
 * \param context
 * The pointer to the context structure \ref cy_stc_usbpd_context_t allocated
@@ -153,15 +352,187 @@ void PMG1S2_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb
 * configuration and data retention. The user must not modify anything
 * in this structure.
 *
+* \param volt
+* Contract Voltage in mV units.
+*
+* \param cb
+* Callback function to be called on fault detection.
+*
+* \param pctrl
+* Flag indicating the type of gate driver to be controlled, true for
+* P_CTRL and false for C_CTRL.
+*
+* \return
+* true if \ref PMG1S2_Vbus_UvpEnableComplete still has to be called.
+*
 *******************************************************************************/
-void PMG1S2_Vbus_UvpIntrHandler(cy_stc_usbpd_context_t *context)
+bool PMG1S2_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb_vbus_fault_t cb, bool pctrl)
+{
+    return PMG1S2_Vbus_UvpLevelSet(context, PMG1S2_Vbus_UvpLevelCalc(context, volt), cb, pctrl);
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvRefSet
+****************************************************************************//**
+*
+* Program the UV ladder code, leaving the OV code as it is. As in
+* \ref PMG1S2_Vbus_UvpLevelSet, the OV auto FET control is cleared around the
+* reference change; it is enabled again right after the write. Must be called
+* from a critical section.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t.
+*
+* \param level
+* UV ladder code to program.
+*
+* \param pctrl
+* Flag indicating the type of gate driver to be controlled, true for
+* P_CTRL and false for C_CTRL.
+*
+*******************************************************************************/
+static void PMG1S2_Vbus_UvRefSet(cy_stc_usbpd_context_t *context, uint8_t level, bool pctrl)
 {
     PPDSS_REGS_T pd = context->base;
+    bool ovAuto = (GET_VBUS_OVP_TABLE(context)->enable &&
+            (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL));
+
+    /* Clear AUTO MODE OVP detect to avoid false auto off during reference change */
+    if (ovAuto)
+    {
+        Cy_USBPD_Fault_FetAutoModeDisable (context, pctrl, CY_USBPD_VBUS_FILTER_ID_OV);
+    }
 
-    /* Disable and clear UVOV interrupts. */
+    pd->uvov_ctrl = (pd->uvov_ctrl & ~PDSS_UVOV_CTRL_UV_IN_MASK) | ((uint32_t)level << PDSS_UVOV_CTRL_UV_IN_POS);
+
+    if (ovAuto)
+    {
+        Cy_USBPD_Fault_FetAutoModeEnable (context, pctrl, CY_USBPD_VBUS_FILTER_ID_OV);
+    }
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvSearchStart
+****************************************************************************//**
+*
+* Prepare an estimate of VBUS with the UV comparator by successive
+* approximation of the ladder code, one code bit per call of
+* \ref PMG1S2_Vbus_UvSearchStep. Does not access any register.
+*
+* \param search
+* Search state.
+*
+*******************************************************************************/
+void PMG1S2_Vbus_UvSearchStart(PMG1S2_UvSearch_t *search)
+{
+    search->level = UVOV_CODE_BOT;
+    search->bit = (uint8_t)(1u << (PMG1S2_UV_SEARCH_BITS - 1u));
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvSearchStep
+****************************************************************************//**
+*
+* Resolve the next code bit of a UV ladder search. The probed code is
+* programmed, read back from the comparator after UVP_SETTLE_TIME_US and
+* replaced by the UV threshold in force, which is left to settle for the same
+* time. Codes above UVOV_CODE_TOP are never programmed. The UV auto FET
+* control and the UVP interrupt are suspended for the probe only; afterwards
+* the edges seen are dropped, the FET control of the configured mode is
+* restored, and an undervoltage present at that point is flagged as by
+* \ref PMG1S2_Vbus_UvpEnableComplete. OVP stays armed.
+*
+* Must not be called from a critical section: only the register accesses run
+* with interrupts disabled, the settle time does not. Must not be interleaved
+* with a UVP enable of the same port.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t.
+*
+* \param search
+* Search state set up by \ref PMG1S2_Vbus_UvSearchStart.
+*
+* \param pctrl
+* Flag indicating the type of gate driver to be controlled, true for
+* P_CTRL and false for C_CTRL.
+*
+* \return
+* true when the search is done. search->level then holds the highest ladder
+* code whose threshold is below VBUS, UVOV_CODE_BOT when VBUS is below the
+* threshold of code 1.
+*
+*******************************************************************************/
+bool PMG1S2_Vbus_UvSearchStep(cy_stc_usbpd_context_t *context, PMG1S2_UvSearch_t *search, bool pctrl)
+{
+    PPDSS_REGS_T pd = context->base;
+    uint8_t probe = search->level | search->bit;
+    uint32_t intr_state;
+    uint8_t uvLevel;
+    bool uvpArmed;
+
+    /* Keep the probe from switching the FETs off or raising UVP events. The
+     * UV FET control is disabled whatever the configured mode, as the
+     * application may have enabled it on its own.
+     */
+    intr_state = Cy_SysLib_EnterCriticalSection();
+    uvLevel = (uint8_t)((pd->uvov_ctrl & PDSS_UVOV_CTRL_UV_IN_MASK) >> PDSS_UVOV_CTRL_UV_IN_POS);
+    uvpArmed = ((pd->intr3_mask & PDSS_INTR3_POS_UV_CHANGED) != 0u);
     pd->intr3_mask &= ~PDSS_INTR3_POS_UV_CHANGED;
+    Cy_USBPD_Fault_FetAutoModeDisable (context, pctrl, CY_USBPD_VBUS_FILTER_ID_UV);
+    PMG1S2_Vbus_UvRefSet(context, probe, pctrl);
+    Cy_SysLib_ExitCriticalSection(intr_state);
+
+    Cy_SysLib_DelayUs(UVP_SETTLE_TIME_US);
+
+    /* UV_DET low: VBUS is above the threshold of the probed code. */
+    intr_state = Cy_SysLib_EnterCriticalSection();
+    if ((pd->ncell_status & PDSS_NCELL_STATUS_UV_STATUS) == 0u)
+    {
+        search->level = probe;
+    }
+    PMG1S2_Vbus_UvRefSet(context, uvLevel, pctrl);
+    Cy_SysLib_ExitCriticalSection(intr_state);
+
+    Cy_SysLib_DelayUs(UVP_SETTLE_TIME_US);
+
+    /* Drop the edges of the probe and restore UVP. */
+    intr_state = Cy_SysLib_EnterCriticalSection();
     pd->intr3 = PDSS_INTR3_POS_UV_CHANGED;
+    if (GET_VBUS_OVP_TABLE(context)->mode == CY_USBPD_VBUS_OVP_MODE_UVOV_AUTOCTRL)
+    {
+        Cy_USBPD_Fault_FetAutoModeEnable (context, pctrl, CY_USBPD_VBUS_FILTER_ID_UV);
+    }
+    if (uvpArmed)
+    {
+        PMG1S2_Vbus_UvpEnableComplete(context);
+    }
+    Cy_SysLib_ExitCriticalSection(intr_state);
 
+    do
+    {
+        search->bit >>= 1;
+    } while ((search->bit != 0u) && ((search->level | search->bit) > UVOV_CODE_TOP));
+
+    return (search->bit == 0u);
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_Vbus_UvpIntrHandler
+****************************************************************************//**
+*
+* VBUS UVP fault interrupt handler function for PMG1-S2. Registered for the
+* UV_CHANGED source of INTR3; the dispatcher has already disabled and cleared
+* the interrupt.
+*
+* \param context
+* The pointer to the context structure \ref cy_stc_usbpd_context_t allocated
+* by the user. The structure is used during the USBPD operation for internal
+* configuration and data retention. The user must not modify anything
+* in this structure.
+*
+*******************************************************************************/
+void PMG1S2_Vbus_UvpIntrHandler(cy_stc_usbpd_context_t *context)
+{
     /* Invoke UVP callback. */
     if (context->vbusUvpCbk != NULL)
     {
@@ -169,12 +540,60 @@ void PMG1S2_Vbus_UvpIntrHandler(cy_stc_usbpd_context_t *context)
     }
 }
 
+/*******************************************************************************
+* Function Name: PMG1S2_USBPD_Intr3Register
+****************************************************************************//**
+*
+* Register the handler of an INTR3 interrupt source. Called at init, before
+* the USBPD interrupt is enabled. Sources without a handler are left to
+* their owner by PMG1S2_USBPD_Intr1Handler.
+*
+* \param source
+* Single PDSS_INTR3_* bit of the source.
+*
+* \param handler
+* Handler of the source, NULL to unregister the source.
+*
+*******************************************************************************/
+void PMG1S2_USBPD_Intr3Register(uint32_t source, PMG1S2_Intr3Handler_t handler)
+{
+    PMG1S2_Intr3Handlers[PMG1S2_Intr3BitPos[(source * PMG1S2_DEBRUIJN32) >> 27]] = handler;
+    if (handler != NULL)
+    {
+        PMG1S2_Intr3Registered |= source;
+    }
+    else
+    {
+        PMG1S2_Intr3Registered &= ~source;
+    }
+}
+
+/*******************************************************************************
+* Function Name: PMG1S2_USBPD_Intr1Init
+****************************************************************************//**
+*
+* Register the handlers of the UVP/OVP INTR3 sources.
+*
+*******************************************************************************/
+void PMG1S2_USBPD_Intr1Init(void)
+{
+#if PDL_VBUS_OVP_ENABLE
+    PMG1S2_USBPD_Intr3Register(PDSS_INTR3_POS_OV_CHANGED, Cy_USBPD_Fault_Vbus_OvpIntrHandler);
+#endif /* PDL_VBUS_OVP_ENABLE */
+#if PDL_VBUS_UVP_ENABLE
+    PMG1S2_USBPD_Intr3Register(PDSS_INTR3_POS_UV_CHANGED, PMG1S2_Vbus_UvpIntrHandler);
+#endif /* PDL_VBUS_UVP_ENABLE */
+}
+
 /*******************************************************************************
 * Function Name: PMG1S2_USBPD_Intr1Handler
 ****************************************************************************//**
 *
-* Handle PMG1-S2 UVP/OVP related wake-up interrupt sources.
-* INTR3 is mapped to the wake-up interrupt vector.
+* Handle PMG1-S2 wake-up interrupt sources. INTR3 is mapped to the wake-up
+* interrupt vector. The pending registered sources are read once, disabled
+* and cleared together, and their handlers are looked up by bit position, so
+* the time spent depends on the number of pending sources only. Sources
+* without a registered handler are neither masked nor cleared.
 *
 * \param context
 * Pointer to the context structure \ref cy_stc_usbpd_context_t.
@@ -185,31 +604,24 @@ void PMG1S2_Vbus_UvpIntrHandler(cy_stc_usbpd_context_t *context)
 *******************************************************************************/
 void PMG1S2_USBPD_Intr1Handler (cy_stc_usbpd_context_t *context)
 {
-#if defined(CY_DEVICE_SERIES_PMG1S2)
     PPDSS_REGS_T pd = context->base;
+    uint32_t pending = pd->intr3_masked & PMG1S2_Intr3Registered;
+    uint32_t bit;
+    PMG1S2_Intr3Handler_t handler;
 
-    if ((pd->intr3_masked & PDSS_INTR3_POS_OV_CHANGED) != 0U)
-    {
-        /* Disable and clear the OV interrupt. */
-        pd->intr3_mask &= ~PDSS_INTR3_POS_OV_CHANGED;
-        pd->intr3 = PDSS_INTR3_POS_OV_CHANGED;
+    /* Disable and clear the pending registered sources. */
+    pd->intr3_mask &= ~pending;
+    pd->intr3 = pending;
 
-#if PDL_VBUS_OVP_ENABLE
-        Cy_USBPD_Fault_Vbus_OvpIntrHandler(context);
-#endif /* PDL_VBUS_OVP_ENABLE */
-    }
-
-    if ((pd->intr3_masked & PDSS_INTR3_POS_UV_CHANGED) != 0U)
+    while (pending != 0u)
     {
-        /* Disable and clear the UV interrupt. */
-        pd->intr3_mask &= ~PDSS_INTR3_POS_UV_CHANGED;
-        pd->intr3 = PDSS_INTR3_POS_UV_CHANGED;
+        /* Isolate the lowest pending source. */
+        bit = pending & (0u - pending);
+        pending ^= bit;
 
-#if PDL_VBUS_UVP_ENABLE
-        PMG1S2_Vbus_UvpIntrHandler(context);
-#endif /* PDL_VBUS_UVP_ENABLE */
+        handler = PMG1S2_Intr3Handlers[PMG1S2_Intr3BitPos[(bit * PMG1S2_DEBRUIJN32) >> 27]];
+        handler(context);
     }
-#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
 }
 
 #endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
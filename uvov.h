@@ -60,6 +60,9 @@
 
 #define MAX_UVP_DEBOUNCE_CYCLES     (0x20u)
 
+/* Settling time of the UV comparator after the auto FET control is enabled */
+#define UVP_SETTLE_TIME_US          (10u)
+
 /*
  *  Input ladder voltages, code limits and step sizes from Table 26 of the
  *  HardIP BROS (001-98391).
@@ -74,6 +77,44 @@
 #define UVOV_CODE_6V0       (13u)
 #define UVOV_LO_STEP_SZ     (250u)
 #define UVOV_HI_STEP_SZ     (500u)
+
+/*
+ * Fixed-point reciprocals used to convert a threshold into a ladder code
+ * without a run-time division (the CM0+ has no hardware divider). The shift
+ * is chosen so that (x * RECIP) >> SHIFT equals x / STEP for every threshold
+ * in the ladder range while the product still fits in 32 bits.
+ */
+#define UVOV_RECIP_SHIFT    (24u)
+#define UVOV_LO_STEP_RECIP  (((1UL << UVOV_RECIP_SHIFT) / UVOV_LO_STEP_SZ) + 1u)
+#define UVOV_HI_STEP_RECIP  (((1UL << UVOV_RECIP_SHIFT) / UVOV_HI_STEP_SZ) + 1u)
+
+/* Q32 reciprocal of 100, used to scale the contract voltage by a percentage. */
+#define UVOV_PERCENT_RECIP  (42949673ULL)
+
+/* Returns (volt * percent / 100) without a run-time division. */
+#define UVOV_PERCENT_OF(volt, percent) \
+    ((uint16_t)((((uint64_t)((uint32_t)(volt) * (uint32_t)(percent))) * UVOV_PERCENT_RECIP) >> 32u))
+
+/* Number of ladder code bits resolved by a UV ladder search */
+#define PMG1S2_UV_SEARCH_BITS       (6u)
+
+/* Number of INTR3 interrupt sources, one per register bit */
+#define PMG1S2_INTR3_SOURCES        (32u)
+
+/* Multiplier of the de Bruijn sequence used to find the position of a single set bit */
+#define PMG1S2_DEBRUIJN32           (0x077CB531u)
+
+/* INTR3 source handler. Called after the source has been masked and cleared;
+ * the handler re-enables the source when it wants further interrupts.
+ */
+typedef void (*PMG1S2_Intr3Handler_t)(cy_stc_usbpd_context_t *context);
+
+/* State of a UV ladder search run one probe at a time, see PMG1S2_Vbus_UvSearchStep */
+typedef struct
+{
+    uint8_t level;                  /* Highest code found below VBUS so far */
+    uint8_t bit;                    /* Code bit probed next, 0 when the search is done */
+} PMG1S2_UvSearch_t;
 #endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
 
 /*******************************************************************************
@@ -81,10 +122,34 @@
 *******************************************************************************/
 #if defined(CY_DEVICE_SERIES_PMG1S2)
 
-void PMG1S2_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb_vbus_fault_t cb, bool pctrl);
+uint8_t PMG1S2_Vbus_UvLevelGet(uint16_t threshold);
+
+uint8_t PMG1S2_Vbus_OvLevelGet(uint16_t threshold);
+
+uint16_t PMG1S2_Vbus_LadderVolt(uint8_t level);
+
+uint8_t PMG1S2_Vbus_UvpFilterSelGet(cy_stc_usbpd_context_t *context);
+
+uint8_t PMG1S2_Vbus_UvpLevelCalc(cy_stc_usbpd_context_t *context, uint16_t volt);
+
+bool PMG1S2_Vbus_UvpLevelSet(cy_stc_usbpd_context_t *context, uint8_t level, cy_cb_vbus_fault_t cb, bool pctrl);
+
+void PMG1S2_Vbus_UvpEnableComplete(cy_stc_usbpd_context_t *context);
+
+uint8_t PMG1S2_Vbus_OvpLevelCalc(cy_stc_usbpd_context_t *context, uint16_t volt);
+
+bool PMG1S2_Vbus_UvpEnable(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb_vbus_fault_t cb, bool pctrl);
 
 void PMG1S2_Vbus_UvpIntrHandler(cy_stc_usbpd_context_t *context);
 
+void PMG1S2_Vbus_UvSearchStart(PMG1S2_UvSearch_t *search);
+
+bool PMG1S2_Vbus_UvSearchStep(cy_stc_usbpd_context_t *context, PMG1S2_UvSearch_t *search, bool pctrl);
+
+void PMG1S2_USBPD_Intr3Register(uint32_t source, PMG1S2_Intr3Handler_t handler);
+
+void PMG1S2_USBPD_Intr1Init(void);
+
 void PMG1S2_USBPD_Intr1Handler (cy_stc_usbpd_context_t *context);
 
 #endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
@@ -0,0 +1,464 @@
+/******************************************************************************
+* File Name: uvov_hal.h
+*
+* Description: This is the header file for the device series abstraction of the UV/OV
+*              comparators of the PMG1 MCU Using UVOV Blocks Code Example. The series is
+*              selected at compile time and every function is inlined into the caller.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef _UVOV_HAL_H_
+#define _UVOV_HAL_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "uvov.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+/* The UVP enable is completed by uvov_hal_uvp_arm_complete() once the comparator
+ * has settled, see PMG1S2_Vbus_UvpLevelSet()
+ */
+#define UVOV_HAL_UVP_DEFERRED       (1u)
+
+/* VBUS can be estimated with the UV comparator, see uvov_hal_uv_search_start() */
+#define UVOV_HAL_UV_SEARCH          (1u)
+
+/* The USBPD block of PMG1-S2 has no trim data */
+#define UVOV_HAL_PORT0_TRIM         (NULL)
+
+/* Comparator status register image */
+typedef uint32_t uvov_hal_status_t;
+
+/* UV threshold in the form programmed by uvov_hal_uvp_arm(), a ladder code */
+typedef uint8_t uvov_hal_uv_level_t;
+
+/* State of a VBUS estimate with the UV comparator */
+typedef PMG1S2_UvSearch_t uvov_hal_uv_search_t;
+#else
+#define UVOV_HAL_UVP_DEFERRED       (0u)
+
+#define UVOV_HAL_UV_SEARCH          (0u)
+
+#define UVOV_HAL_PORT0_TRIM         (mtb_usbpd_port0_HW_TRIM)
+
+typedef uint32_t uvov_hal_status_t;
+
+/* UV threshold in the form programmed by uvov_hal_uvp_arm(), a voltage in mV */
+typedef uint16_t uvov_hal_uv_level_t;
+
+typedef uint8_t uvov_hal_uv_search_t;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+/* Threshold code returned when the reference generator is owned by the PDL,
+ * equal to FAULT_EVENT_CODE_NONE
+ */
+#define UVOV_HAL_CODE_NONE          (0xFFu)
+
+/*******************************************************************************
+* Function Name: uvov_hal_comp_read
+********************************************************************************
+* Summary:
+*  Reads the OV and UV comparator outputs in one register access. The result
+*  is decoded with uvov_hal_ov_active() and uvov_hal_uv_active().
+*
+* Parameters:
+*  context - the USBPD context
+*
+* Return:
+*  uvov_hal_status_t
+*
+*******************************************************************************/
+static inline uvov_hal_status_t uvov_hal_comp_read(cy_stc_usbpd_context_t *context)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return context->base->ncell_status;
+#else
+    return context->base->intr5_status_0;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_ov_active
+********************************************************************************
+* Summary:
+*  Returns whether VBUS is above the OV threshold.
+*
+* Parameters:
+*  status - value returned by uvov_hal_comp_read()
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+static inline bool uvov_hal_ov_active(uvov_hal_status_t status)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return ((status & PDSS_NCELL_STATUS_OV_STATUS) != 0u);
+#else
+    return ((status & (1U << CY_USBPD_VBUS_FILTER_ID_OV)) != 0u);
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uv_active
+********************************************************************************
+* Summary:
+*  Returns whether VBUS is below the UV threshold. The UV comparator output is
+*  inverted on the devices other than PMG1-S2.
+*
+* Parameters:
+*  status - value returned by uvov_hal_comp_read()
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+static inline bool uvov_hal_uv_active(uvov_hal_status_t status)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return ((status & PDSS_NCELL_STATUS_UV_STATUS) != 0u);
+#else
+    return ((status & (1U << CY_USBPD_VBUS_FILTER_ID_UV)) == 0u);
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_ov_code
+********************************************************************************
+* Summary:
+*  Returns the OV comparator threshold code currently programmed.
+*
+* Parameters:
+*  context - the USBPD context
+*
+* Return:
+*  uint8_t - UVOV_HAL_CODE_NONE if the code is owned by the PDL
+*
+*******************************************************************************/
+static inline uint8_t uvov_hal_ov_code(cy_stc_usbpd_context_t *context)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return (uint8_t)((context->base->uvov_ctrl & PDSS_UVOV_CTRL_OV_IN_MASK) >> PDSS_UVOV_CTRL_OV_IN_POS);
+#else
+    (void)context;
+    return UVOV_HAL_CODE_NONE;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uv_code
+********************************************************************************
+* Summary:
+*  Returns the UV comparator threshold code currently programmed.
+*
+* Parameters:
+*  context - the USBPD context
+*
+* Return:
+*  uint8_t - UVOV_HAL_CODE_NONE if the code is owned by the PDL
+*
+*******************************************************************************/
+static inline uint8_t uvov_hal_uv_code(cy_stc_usbpd_context_t *context)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return (uint8_t)((context->base->uvov_ctrl & PDSS_UVOV_CTRL_UV_IN_MASK) >> PDSS_UVOV_CTRL_UV_IN_POS);
+#else
+    (void)context;
+    return UVOV_HAL_CODE_NONE;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uvp_debounce
+********************************************************************************
+* Summary:
+*  Returns the debounce setting of the UV comparator.
+*
+* Parameters:
+*  context - the USBPD context
+*
+* Return:
+*  uint8_t
+*
+*******************************************************************************/
+static inline uint8_t uvov_hal_uvp_debounce(cy_stc_usbpd_context_t *context)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return PMG1S2_Vbus_UvpFilterSelGet(context);
+#else
+    return GET_VBUS_UVP_TABLE(context)->debounce;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_ov_volt
+********************************************************************************
+* Summary:
+*  Returns the VBUS level at which the OV comparator trips when armed by
+*  uvov_hal_ovp_arm() with a voltage. Not intended for interrupt context.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - the voltage used to calculate the OVP threshold
+*
+* Return:
+*  uint16_t - trip level in mV
+*
+*******************************************************************************/
+static inline uint16_t uvov_hal_ov_volt(cy_stc_usbpd_context_t *context, uint16_t volt)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return PMG1S2_Vbus_LadderVolt(PMG1S2_Vbus_OvpLevelCalc(context, volt));
+#else
+    uint32_t trip = (uint32_t)volt + (((uint32_t)volt * GET_VBUS_OVP_TABLE(context)->threshold) / 100u);
+
+    return (uint16_t)CY_USBPD_GET_MIN(trip, UINT16_MAX);
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_ovp_arm
+********************************************************************************
+* Summary:
+*  Programs the OV threshold and enables the OVP interrupt.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - the voltage used to calculate the OVP threshold
+*  cb - fault callback
+*  pctrl - true for P_CTRL and false for C_CTRL gate driver
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void uvov_hal_ovp_arm(cy_stc_usbpd_context_t *context, uint16_t volt, cy_cb_vbus_fault_t cb,
+        bool pctrl)
+{
+    Cy_USBPD_Fault_Vbus_OvpEnable(context, volt, cb, pctrl);
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uvp_level
+********************************************************************************
+* Summary:
+*  Converts a voltage into the UV threshold form programmed by
+*  uvov_hal_uvp_arm(). Does not access any register, so it can be called ahead
+*  of the critical section that arms the comparator.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - the voltage used to calculate the UVP threshold
+*
+* Return:
+*  uvov_hal_uv_level_t
+*
+*******************************************************************************/
+static inline uvov_hal_uv_level_t uvov_hal_uvp_level(cy_stc_usbpd_context_t *context, uint16_t volt)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return PMG1S2_Vbus_UvpLevelCalc(context, volt);
+#else
+    (void)context;
+    return volt;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uvp_arm
+********************************************************************************
+* Summary:
+*  Programs the UV threshold and enables the UVP interrupt. Must be called from
+*  a critical section.
+*
+* Parameters:
+*  context - the USBPD context
+*  level - value returned by uvov_hal_uvp_level()
+*  cb - fault callback
+*  pctrl - true for P_CTRL and false for C_CTRL gate driver
+*
+* Return:
+*  bool - true if uvov_hal_uvp_arm_complete() still has to be called at least
+*         UVP_SETTLE_TIME_US later; always false when UVOV_HAL_UVP_DEFERRED is 0
+*
+*******************************************************************************/
+static inline bool uvov_hal_uvp_arm(cy_stc_usbpd_context_t *context, uvov_hal_uv_level_t level,
+        cy_cb_vbus_fault_t cb, bool pctrl)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return PMG1S2_Vbus_UvpLevelSet(context, level, cb, pctrl);
+#else
+    Cy_USBPD_Fault_Vbus_UvpEnable(context, level, cb, pctrl);
+    return false;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uvp_arm_complete
+********************************************************************************
+* Summary:
+*  Completes a deferred UVP enable. Must be called from a critical section.
+*
+* Parameters:
+*  context - the USBPD context
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void uvov_hal_uvp_arm_complete(cy_stc_usbpd_context_t *context)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    PMG1S2_Vbus_UvpEnableComplete(context);
+#else
+    (void)context;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uv_search_start
+********************************************************************************
+* Summary:
+*  Prepares a VBUS estimate by searching the UV comparator reference for the
+*  trip point, one probe per uvov_hal_uv_search_step() call.
+*
+* Parameters:
+*  search - search state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void uvov_hal_uv_search_start(uvov_hal_uv_search_t *search)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    PMG1S2_Vbus_UvSearchStart(search);
+#else
+    (void)search;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_uv_search_step
+********************************************************************************
+* Summary:
+*  Runs one probe of a VBUS estimate and restores the UV threshold in force.
+*  UV protection is suspended for the probe, about 2 * UVP_SETTLE_TIME_US, with
+*  interrupts enabled; OV protection stays armed. Must not be called from a
+*  critical section.
+*
+* Parameters:
+*  context - the USBPD context
+*  search - search state
+*  pctrl - true for P_CTRL and false for C_CTRL gate driver
+*  mv - lower bound of VBUS in mV when the search is done, 0 if VBUS is below
+*       the second ladder step
+*
+* Return:
+*  bool - true when the search is done; always true when UVOV_HAL_UV_SEARCH
+*         is 0
+*
+*******************************************************************************/
+static inline bool uvov_hal_uv_search_step(cy_stc_usbpd_context_t *context, uvov_hal_uv_search_t *search,
+        bool pctrl, uint16_t *mv)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    if (!PMG1S2_Vbus_UvSearchStep(context, search, pctrl))
+    {
+        return false;
+    }
+    *mv = (search->level == UVOV_CODE_BOT) ? 0u : PMG1S2_Vbus_LadderVolt(search->level);
+    return true;
+#else
+    (void)context;
+    (void)search;
+    (void)pctrl;
+    *mv = 0u;
+    return true;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_irq_init
+********************************************************************************
+* Summary:
+*  Prepares the UV/OV interrupt dispatch. Called once before the USBPD
+*  interrupts are enabled.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void uvov_hal_irq_init(void)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    /* Register the UVP/OVP handlers of the INTR3 dispatcher */
+    PMG1S2_USBPD_Intr1Init();
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hal_isr
+********************************************************************************
+* Summary:
+*  Handles the UV/OV interrupt of a USBPD port. PMG1-S2 reports UVP and OVP on
+*  INTR3 instead of the registers handled by the PDL, and clears the pending
+*  sources in its own dispatcher.
+*
+* Parameters:
+*  context - the USBPD context
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void uvov_hal_isr(cy_stc_usbpd_context_t *context)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    PMG1S2_USBPD_Intr1Handler(context);
+#else
+    Cy_USBPD_Intr1Handler(context);
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+#endif /* _UVOV_HAL_H_ */
+
+/* End of file [] */
@@ -0,0 +1,244 @@
+/******************************************************************************
+* File Name: uvov_hyst.c
+*
+* Description: This file contains the hysteresis engine. The re-arm threshold used while
+*              a fault is active is placed a number of comparator steps away from the trip
+*              threshold, for any contract voltage.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "uvov_hyst.h"
+#include "uvov.h"
+
+/*******************************************************************************
+* Function Name: uvov_hyst_div_ceil
+********************************************************************************
+* Summary:
+*  Returns the smallest contract voltage whose percentage-scaled threshold
+*  reaches a target, i.e. ceil(target * 100 / percent).
+*
+* Parameters:
+*  target - target threshold in mV
+*  percent - scaling of the contract voltage in percent
+*
+* Return:
+*  uint16_t
+*
+*******************************************************************************/
+static uint16_t uvov_hyst_div_ceil(uint32_t target, uint32_t percent)
+{
+    uint32_t volt = ((target * 100u) + percent - 1u) / percent;
+
+    return (uint16_t)CY_USBPD_GET_MIN(volt, UINT16_MAX);
+}
+
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+/*******************************************************************************
+* Function Name: uvov_hyst_ov_trip
+********************************************************************************
+* Summary:
+*  Returns the OV ladder code of the trip state of a contract voltage. The OV
+*  ladder is not used below 6 V, so a trip code less than the given number of
+*  steps above UVOV_CODE_6V0 leaves no room for the hysteresis band below it;
+*  the trip code is then raised to make the band as wide as configured.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - contract voltage in mV
+*  steps - comparator steps between the trip and the hysteresis threshold
+*
+* Return:
+*  uint8_t
+*
+*******************************************************************************/
+static uint8_t uvov_hyst_ov_trip(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps)
+{
+    uint32_t code = PMG1S2_Vbus_OvpLevelCalc(context, volt);
+    uint32_t lowest = CY_USBPD_GET_MIN((uint32_t)UVOV_CODE_6V0 + steps, UVOV_CODE_MAX);
+
+    return (uint8_t)CY_USBPD_GET_MAX(code, lowest);
+}
+
+/*******************************************************************************
+* Function Name: uvov_hyst_ov_hyst
+********************************************************************************
+* Summary:
+*  Returns the OV ladder code of the hysteresis state of a contract voltage,
+*  the given number of steps below uvov_hyst_ov_trip().
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - contract voltage in mV
+*  steps - comparator steps between the trip and the hysteresis threshold
+*
+* Return:
+*  uint8_t
+*
+*******************************************************************************/
+static uint8_t uvov_hyst_ov_hyst(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps)
+{
+    uint32_t code = uvov_hyst_ov_trip(context, volt, steps);
+
+    return (uint8_t)((code > ((uint32_t)UVOV_CODE_6V0 + steps)) ? (code - steps) : UVOV_CODE_6V0);
+}
+
+/*******************************************************************************
+* Function Name: uvov_hyst_ov_code_volt
+********************************************************************************
+* Summary:
+*  Returns the voltage to pass to enable_ovp() so that the PDL arms the OV
+*  comparator with a ladder code. The PDL rounds the threshold
+*  volt * (100 + threshold) / 100 up to the next code, so the voltage is
+*  rounded down: its threshold is then less than one ladder step below the
+*  voltage of the code.
+*
+* Parameters:
+*  context - the USBPD context
+*  code - OV ladder code
+*
+* Return:
+*  uint16_t
+*
+*******************************************************************************/
+static uint16_t uvov_hyst_ov_code_volt(cy_stc_usbpd_context_t *context, uint8_t code)
+{
+    uint32_t percent = 100u + GET_VBUS_OVP_TABLE(context)->threshold;
+    uint32_t volt = ((uint32_t)PMG1S2_Vbus_LadderVolt(code) * 100u) / percent;
+
+    return (uint16_t)CY_USBPD_GET_MIN(volt, UINT16_MAX);
+}
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+/*******************************************************************************
+* Function Name: uvov_hyst_ovp_trip_volt
+********************************************************************************
+* Summary:
+*  Returns the voltage to pass to enable_ovp() to arm the OV comparator at the
+*  trip threshold of a contract voltage. This is the contract voltage, except
+*  on PMG1-S2 when the trip code is raised above the 6 V ladder floor to make
+*  room for the hysteresis band. Not intended for interrupt context.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - contract voltage in mV
+*  steps - comparator steps between the trip and the hysteresis threshold
+*
+* Return:
+*  uint16_t
+*
+*******************************************************************************/
+uint16_t uvov_hyst_ovp_trip_volt(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    uint8_t code = uvov_hyst_ov_trip(context, volt, steps);
+
+    return (code == PMG1S2_Vbus_OvpLevelCalc(context, volt)) ? volt : uvov_hyst_ov_code_volt(context, code);
+#else
+    (void)context;
+    (void)steps;
+    return volt;
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hyst_ovp_volt
+********************************************************************************
+* Summary:
+*  Returns the voltage to pass to enable_ovp() so that the OV comparator is
+*  armed the given number of steps below the trip threshold of a contract
+*  voltage. The OVP threshold is volt * (100 + threshold) / 100.
+*  Not intended for interrupt context.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - contract voltage in mV
+*  steps - comparator steps between the trip and the hysteresis threshold
+*
+* Return:
+*  uint16_t
+*
+*******************************************************************************/
+uint16_t uvov_hyst_ovp_volt(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps)
+{
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    return uvov_hyst_ov_code_volt(context, uvov_hyst_ov_hyst(context, volt, steps));
+#else
+    uint32_t percent = 100u + GET_VBUS_OVP_TABLE(context)->threshold;
+    uint32_t trip = ((uint32_t)volt * percent) / 100u;
+    uint32_t band = (uint32_t)steps * UVOV_HYST_STEP_MV;
+
+    return uvov_hyst_div_ceil((trip > band) ? (trip - band) : 0u, percent);
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+}
+
+/*******************************************************************************
+* Function Name: uvov_hyst_uvp_volt
+********************************************************************************
+* Summary:
+*  Returns the voltage to pass to enable_uvp() so that the UV comparator is
+*  armed the given number of steps above the trip threshold of a contract
+*  voltage. The UVP threshold is volt * threshold / 100.
+*  Not intended for interrupt context.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - contract voltage in mV
+*  steps - comparator steps between the trip and the hysteresis threshold
+*
+* Return:
+*  uint16_t
+*
+*******************************************************************************/
+uint16_t uvov_hyst_uvp_volt(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps)
+{
+    uint32_t percent = GET_VBUS_UVP_TABLE(context)->threshold;
+    uint32_t target;
+#if defined(CY_DEVICE_SERIES_PMG1S2)
+    uint32_t code = (uint32_t)PMG1S2_Vbus_UvpLevelCalc(context, volt) + steps;
+
+    target = PMG1S2_Vbus_LadderVolt((uint8_t)CY_USBPD_GET_MIN(code, UVOV_CODE_TOP));
+#else
+    target = (((uint32_t)volt * percent) / 100u) + ((uint32_t)steps * UVOV_HYST_STEP_MV);
+#endif /* defined(CY_DEVICE_SERIES_PMG1S2) */
+
+    if (percent == 0u)
+    {
+        return volt;
+    }
+    return uvov_hyst_div_ceil(target, percent);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,72 @@
+/******************************************************************************
+* File Name: uvov_hyst.h
+*
+* Description: This is the header file for the ladder-aware hysteresis engine of the
+*              PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _UVOV_HYST_H_
+#define _UVOV_HYST_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "uvov_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#if !defined(CY_DEVICE_SERIES_PMG1S2)
+/*
+ * Comparator step used for the hysteresis on devices without the UVOV ladder.
+ * Their reference generator is much finer than the PMG1-S2 ladder, so a step
+ * here stands for the minimum noise margin rather than a reference code.
+ */
+#define UVOV_HYST_STEP_MV           (100u)
+#endif /* !defined(CY_DEVICE_SERIES_PMG1S2) */
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint16_t uvov_hyst_ovp_trip_volt(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps);
+
+uint16_t uvov_hyst_ovp_volt(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps);
+
+uint16_t uvov_hyst_uvp_volt(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t steps);
+
+#endif /* _UVOV_HYST_H_ */
+
+/* End of file [] */
@@ -0,0 +1,150 @@
+/******************************************************************************
+* File Name: uvov_profile.c
+*
+* Description: This file contains the per-contract protection profile cache. The
+*              thresholds of every cached contract voltage are computed once at init, so a
+*              contract or hysteresis change only writes precomputed values.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include "uvov_profile.h"
+#include "uvov_hyst.h"
+#include "fault_event.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Cached profiles of each port, indexed by contract voltage step */
+static uvov_profile_t uvov_profile_cache[UVOV_PORT_COUNT][UVOV_PROFILE_COUNT];
+
+/* Set once the cache of the port is filled */
+static bool uvov_profile_ready[UVOV_PORT_COUNT];
+
+/*******************************************************************************
+* Function Name: uvov_profile_calc
+********************************************************************************
+* Summary:
+*  Computes the trip and hysteresis thresholds of a contract voltage with the
+*  OVP/UVP configuration of a port.
+*
+* Parameters:
+*  context - the USBPD context
+*  volt - contract voltage in mV
+*  ovp_steps - comparator steps of the OVP hysteresis
+*  uvp_steps - comparator steps of the UVP hysteresis
+*  profile - computed profile
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uvov_profile_calc(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t ovp_steps, uint8_t uvp_steps,
+        uvov_profile_t *profile)
+{
+    profile->volt = volt;
+    profile->ovp_volt = uvov_hyst_ovp_trip_volt(context, volt, ovp_steps);
+    profile->ovp_hyst_volt = uvov_hyst_ovp_volt(context, volt, ovp_steps);
+    profile->uvp_hyst_volt = uvov_hyst_uvp_volt(context, volt, uvp_steps);
+    profile->ov_trip_volt = uvov_hal_ov_volt(context, profile->ovp_volt);
+    profile->uv_trip = uvov_hal_uvp_level(context, volt);
+    profile->uv_hyst = uvov_hal_uvp_level(context, profile->uvp_hyst_volt);
+}
+
+/*******************************************************************************
+* Function Name: uvov_profile_build
+********************************************************************************
+* Summary:
+*  Fills the profile cache of a port. Called at init, and again when the
+*  OVP/UVP configuration of the port changes.
+*
+* Parameters:
+*  context - the USBPD context
+*  ovp_steps - comparator steps of the OVP hysteresis
+*  uvp_steps - comparator steps of the UVP hysteresis
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uvov_profile_build(cy_stc_usbpd_context_t *context, uint8_t ovp_steps, uint8_t uvp_steps)
+{
+    uvov_profile_t *profile = uvov_profile_cache[context->port];
+    uint16_t volt = UVOV_PROFILE_MIN_MV;
+    uint8_t idx;
+
+    for (idx = 0; idx < UVOV_PROFILE_COUNT; idx++)
+    {
+        uvov_profile_calc(context, volt, ovp_steps, uvp_steps, &profile[idx]);
+        volt += UVOV_PROFILE_STEP_MV;
+    }
+    uvov_profile_ready[context->port] = true;
+}
+
+/*******************************************************************************
+* Function Name: uvov_profile_get
+********************************************************************************
+* Summary:
+*  Returns the cached profile of a contract voltage. The grid index is found
+*  with a reciprocal multiply, as the CM0+ has no hardware divider.
+*
+* Parameters:
+*  port - USBPD port
+*  volt - contract voltage in mV
+*
+* Return:
+*  const uvov_profile_t * - NULL if the voltage is not on the cached grid or
+*  the cache of the port is not built yet
+*
+*******************************************************************************/
+const uvov_profile_t *uvov_profile_get(uint8_t port, uint16_t volt)
+{
+    uint32_t offset;
+    uint32_t idx;
+
+    if ((!uvov_profile_ready[port]) || (volt < UVOV_PROFILE_MIN_MV) || (volt > UVOV_PROFILE_MAX_MV))
+    {
+        return NULL;
+    }
+
+    offset = (uint32_t)volt - UVOV_PROFILE_MIN_MV;
+    idx = (offset * UVOV_PROFILE_STEP_RECIP) >> UVOV_PROFILE_RECIP_SHIFT;
+    if ((idx * UVOV_PROFILE_STEP_MV) != offset)
+    {
+        return NULL;
+    }
+    return &uvov_profile_cache[port][idx];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: uvov_profile.h
+*
+* Description: This is the header file for the per-contract protection profile cache of
+*              the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef _UVOV_PROFILE_H_
+#define _UVOV_PROFILE_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "uvov_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/*
+ * Contract voltages with a cached profile: every step from MIN to MAX. The
+ * grid holds the 5 V, 9 V, 15 V and 20 V fixed PDOs and the PPS voltages in
+ * steps of one PMG1-S2 ladder code above 9 V.
+ *
+ * PPS requests are made in 20 mV steps, so most PPS voltages fall between two
+ * grid points. uvov_profile_get() returns NULL for them and the caller
+ * computes the profile once per contract with uvov_profile_calc().
+ */
+#define UVOV_PROFILE_MIN_MV         (3500u)
+#define UVOV_PROFILE_MAX_MV         (21000u)
+#define UVOV_PROFILE_STEP_MV        (500u)
+#define UVOV_PROFILE_COUNT          (((UVOV_PROFILE_MAX_MV - UVOV_PROFILE_MIN_MV) / UVOV_PROFILE_STEP_MV) + 1u)
+
+/*
+ * Fixed-point reciprocal of the grid step, so that a contract voltage is
+ * mapped to its cache index without a run-time division. (x * RECIP) >> SHIFT
+ * equals x / STEP for every offset in the grid range.
+ */
+#define UVOV_PROFILE_RECIP_SHIFT    (24u)
+#define UVOV_PROFILE_STEP_RECIP     (((1UL << UVOV_PROFILE_RECIP_SHIFT) / UVOV_PROFILE_STEP_MV) + 1u)
+
+/* Thresholds of a contract voltage in the form written by the enable paths */
+typedef struct
+{
+    uint16_t volt;                  /* Contract voltage in mV, arms the UVP trip threshold */
+    uint16_t ovp_volt;              /* Voltage used to arm the OVP trip threshold, see uvov_hyst_ovp_trip_volt() */
+    uint16_t ovp_hyst_volt;         /* Voltage used to arm the OVP comparator while an overvoltage is active */
+    uint16_t uvp_hyst_volt;         /* Voltage used to arm the UVP comparator while an undervoltage is active */
+    uint16_t ov_trip_volt;          /* VBUS level in mV at which the OV comparator trips */
+    uvov_hal_uv_level_t uv_trip;    /* UV threshold image of the trip state */
+    uvov_hal_uv_level_t uv_hyst;    /* UV threshold image of the hysteresis state */
+} uvov_profile_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uvov_profile_calc(cy_stc_usbpd_context_t *context, uint16_t volt, uint8_t ovp_steps, uint8_t uvp_steps,
+        uvov_profile_t *profile);
+
+void uvov_profile_build(cy_stc_usbpd_context_t *context, uint8_t ovp_steps, uint8_t uvp_steps);
+
+const uvov_profile_t *uvov_profile_get(uint8_t port, uint16_t volt);
+
+#endif /* _UVOV_PROFILE_H_ */
+
+/* End of file [] */
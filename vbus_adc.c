@@ -0,0 +1,248 @@
+/******************************************************************************
+* File Name: vbus_adc.c
+*
+* Description: This file contains the ADC based VBUS measurement. VBUS is sampled in
+*              batches from a scheduler task and filtered with a fixed-point IIR filter;
+*              the sampling path uses neither division nor floating point.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "vbus_adc.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* USBPD context of the filtered measurement, port 0 */
+static cy_stc_usbpd_context_t *vbus_adc_context = NULL;
+
+/* mV per ADC level in Q16, computed once at init */
+static uint32_t vbus_adc_scale = 0;
+
+/* Filtered ADC level with VBUS_ADC_FRAC_BITS fractional bits */
+static uint32_t vbus_adc_filter = 0;
+
+/* Filtered VBUS in mV, 0 while sampling is stopped */
+static volatile uint16_t vbus_adc_mv = 0;
+
+/*******************************************************************************
+* Function Name: vbus_adc_batch
+********************************************************************************
+* Summary:
+*  Takes VBUS_ADC_BATCH samples and returns their mean ADC level with
+*  VBUS_ADC_FRAC_BITS fractional bits.
+*
+* Parameters:
+*  context - USBPD context of the port to sample
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t vbus_adc_batch(cy_stc_usbpd_context_t *context)
+{
+    uint32_t sum = 0;
+    uint8_t idx;
+
+    for (idx = 0; idx < VBUS_ADC_BATCH; idx++)
+    {
+        sum += Cy_USBPD_Adc_Sample(context, VBUS_ADC_ID, VBUS_ADC_INPUT);
+    }
+    return (sum << (VBUS_ADC_FRAC_BITS - VBUS_ADC_BATCH_SHIFT));
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_update
+********************************************************************************
+* Summary:
+*  Converts the filtered ADC level to mV.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void vbus_adc_update(void)
+{
+    vbus_adc_mv = (uint16_t)(((uint64_t)vbus_adc_filter * vbus_adc_scale) >> (16u + VBUS_ADC_FRAC_BITS));
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_init
+********************************************************************************
+* Summary:
+*  Initializes the ADC of a port. For port 0, which the filtered measurement
+*  is taken on, also precomputes the level to mV scale from the PDL
+*  conversion of the full-scale level; the scale is shared by all ports.
+*  Called for port 0 first.
+*
+* Parameters:
+*  context - USBPD context
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_adc_init(cy_stc_usbpd_context_t *context)
+{
+    (void)Cy_USBPD_Adc_Init(context, VBUS_ADC_ID);
+
+    if (context->port == 0u)
+    {
+        vbus_adc_context = context;
+
+        /* 65536 / 255 is 257 within 0.002% */
+        vbus_adc_scale = (uint32_t)Cy_USBPD_Adc_GetVbusVolt(context, VBUS_ADC_ID, 0xFFu) * 257u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_start
+********************************************************************************
+* Summary:
+*  Seeds the filter with an immediate batch so that a value is available
+*  before the first task run.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_adc_start(void)
+{
+    vbus_adc_filter = vbus_adc_batch(vbus_adc_context);
+    vbus_adc_update();
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_stop
+********************************************************************************
+* Summary:
+*  Marks the measurement as stale once sampling is stopped.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_adc_stop(void)
+{
+    vbus_adc_mv = 0u;
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_task
+********************************************************************************
+* Summary:
+*  Scheduler task, samples a batch and feeds it into the IIR filter.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_adc_task(void)
+{
+    int32_t delta = (int32_t)vbus_adc_batch(vbus_adc_context) - (int32_t)vbus_adc_filter;
+
+    vbus_adc_filter = (uint32_t)((int32_t)vbus_adc_filter + (delta >> VBUS_ADC_IIR_SHIFT));
+    vbus_adc_update();
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_get_mv
+********************************************************************************
+* Summary:
+*  Returns the filtered VBUS voltage. Safe to call from interrupt context.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint16_t - VBUS in mV, 0 while sampling is stopped
+*
+*******************************************************************************/
+uint16_t vbus_adc_get_mv(void)
+{
+    return vbus_adc_mv;
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_measure
+********************************************************************************
+* Summary:
+*  Samples a batch on a port and returns its mean without updating the
+*  filter. Used where the filter lag is not acceptable.
+*
+* Parameters:
+*  context - USBPD context of the port to sample
+*
+* Return:
+*  uint16_t - VBUS in mV
+*
+*******************************************************************************/
+uint16_t vbus_adc_measure(cy_stc_usbpd_context_t *context)
+{
+    return (uint16_t)(((uint64_t)vbus_adc_batch(context) * vbus_adc_scale) >> (16u + VBUS_ADC_FRAC_BITS));
+}
+
+/*******************************************************************************
+* Function Name: vbus_adc_step_mv
+********************************************************************************
+* Summary:
+*  Returns the VBUS voltage of one ADC level. A conversion truncates, so
+*  VBUS can be up to one step above the value returned by vbus_adc_measure().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint16_t - ADC step in mV
+*
+*******************************************************************************/
+uint16_t vbus_adc_step_mv(void)
+{
+    return (uint16_t)(vbus_adc_scale >> 16u);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name: vbus_adc.h
+*
+* Description: This is the header file for the ADC based VBUS measurement of the PMG1 MCU
+*              Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _VBUS_ADC_H_
+#define _VBUS_ADC_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1u to measure VBUS with the USBPD ADC while a fault is handled */
+#ifndef VBUS_ADC_ENABLE
+#define VBUS_ADC_ENABLE             (0u)
+#endif
+
+/* USBPD ADC and input connected to the VBUS divider */
+#define VBUS_ADC_ID                 (CY_USBPD_ADC_ID_0)
+#define VBUS_ADC_INPUT              (CY_USBPD_ADC_INPUT_AMUX_B)
+
+/* Period of the sampling task in ms */
+#define VBUS_ADC_PERIOD_MS          (1u)
+
+/* Samples averaged per task run, 1 << VBUS_ADC_BATCH_SHIFT */
+#define VBUS_ADC_BATCH_SHIFT        (2u)
+#define VBUS_ADC_BATCH              (1u << VBUS_ADC_BATCH_SHIFT)
+
+/* IIR filter coefficient, each batch moves the output by 1 / (1 << shift) */
+#define VBUS_ADC_IIR_SHIFT          (2u)
+
+/* Fractional bits of the filtered ADC level */
+#define VBUS_ADC_FRAC_BITS          (8u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void vbus_adc_init(cy_stc_usbpd_context_t *context);
+
+void vbus_adc_start(void);
+
+void vbus_adc_stop(void);
+
+void vbus_adc_task(void);
+
+uint16_t vbus_adc_get_mv(void);
+
+uint16_t vbus_adc_measure(cy_stc_usbpd_context_t *context);
+
+uint16_t vbus_adc_step_mv(void);
+
+#endif /* _VBUS_ADC_H_ */
+
+/* End of file [] */
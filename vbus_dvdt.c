@@ -0,0 +1,126 @@
+/******************************************************************************
+* File Name: vbus_dvdt.c
+*
+* Description: This file contains the predictive dV/dt overvoltage trigger. The VBUS slope
+*              is tracked from periodic ADC samples and a trigger is raised when the
+*              projected time to the OVP threshold drops below VBUS_DVDT_LEAD_MS.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "vbus_dvdt.h"
+
+/*******************************************************************************
+* Function Name: vbus_dvdt_init
+********************************************************************************
+* Summary:
+*  Sets the OVP trip level the slope is projected to. Called whenever the
+*  OVP trip threshold of the port changes.
+*
+* Parameters:
+*  dvdt - predictor state
+*  trip_volt - OVP trip level in mV
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_dvdt_init(vbus_dvdt_t *dvdt, uint16_t trip_volt)
+{
+    dvdt->trip = trip_volt;
+    vbus_dvdt_reset(dvdt);
+}
+
+/*******************************************************************************
+* Function Name: vbus_dvdt_reset
+********************************************************************************
+* Summary:
+*  Discards the slope history, e.g. while the OVP channel is not NORMAL.
+*
+* Parameters:
+*  dvdt - predictor state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_dvdt_reset(vbus_dvdt_t *dvdt)
+{
+    dvdt->slope = 0;
+    dvdt->primed = false;
+}
+
+/*******************************************************************************
+* Function Name: vbus_dvdt_update
+********************************************************************************
+* Summary:
+*  Adds a sample and checks the projected time to the trip level. The check
+*  headroom / slope < lead is evaluated as headroom < slope * lead so that no
+*  division is needed.
+*
+* Parameters:
+*  dvdt - predictor state
+*  volt - VBUS sample in mV
+*
+* Return:
+*  bool - true when the OVP action must be taken now
+*
+*******************************************************************************/
+bool vbus_dvdt_update(vbus_dvdt_t *dvdt, uint16_t volt)
+{
+    int32_t delta;
+    int32_t headroom;
+
+    if (!dvdt->primed)
+    {
+        dvdt->last = volt;
+        dvdt->primed = true;
+        return false;
+    }
+
+    delta = ((int32_t)volt - (int32_t)dvdt->last) * 256;
+    dvdt->last = volt;
+    dvdt->slope += (delta - dvdt->slope) >> VBUS_DVDT_SLOPE_SHIFT;
+
+    if (dvdt->slope < (int32_t)(VBUS_DVDT_MIN_SLOPE_MV * 256u))
+    {
+        return false;
+    }
+
+    headroom = ((int32_t)dvdt->trip - (int32_t)volt) * 256 * (int32_t)VBUS_DVDT_PERIOD_MS;
+    return (headroom < (dvdt->slope * (int32_t)VBUS_DVDT_LEAD_MS));
+}
+
+/* [] END OF FILE */
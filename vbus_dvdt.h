@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name: vbus_dvdt.h
+*
+* Description: This is the header file for the predictive dV/dt overvoltage trigger of the
+*              PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef _VBUS_DVDT_H_
+#define _VBUS_DVDT_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1u to trigger the OVP action ahead of the comparator on a fast VBUS rise */
+#ifndef VBUS_DVDT_ENABLE
+#define VBUS_DVDT_ENABLE            (0u)
+#endif
+
+/* VBUS sampling period of the predictor in ms */
+#define VBUS_DVDT_PERIOD_MS         (1u)
+
+/* Trigger when the projected time to the OVP threshold drops below this many ms */
+#define VBUS_DVDT_LEAD_MS           (2u)
+
+/* Minimum rise in mV per sampling period treated as a transient */
+#define VBUS_DVDT_MIN_SLOPE_MV      (100u)
+
+/* Slope filter coefficient, each sample moves the slope by 1 / (1 << shift) */
+#define VBUS_DVDT_SLOPE_SHIFT       (1u)
+
+/* Predictor state of a port */
+typedef struct
+{
+    uint16_t trip;                  /* VBUS level in mV at which the OVP comparator trips */
+    uint16_t last;                  /* Previous sample in mV */
+    int32_t slope;                  /* Filtered slope in mV per sampling period, Q8 */
+    bool primed;                    /* Set once last holds a sample */
+} vbus_dvdt_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void vbus_dvdt_init(vbus_dvdt_t *dvdt, uint16_t trip_volt);
+
+void vbus_dvdt_reset(vbus_dvdt_t *dvdt);
+
+bool vbus_dvdt_update(vbus_dvdt_t *dvdt, uint16_t volt);
+
+#endif /* _VBUS_DVDT_H_ */
+
+/* End of file [] */
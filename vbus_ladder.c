@@ -0,0 +1,147 @@
+/******************************************************************************
+* File Name: vbus_ladder.c
+*
+* Description: This file contains the VBUS estimate through the UV comparator ladder. The
+*              ladder code is searched against the comparator output without the ADC.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#include "vbus_ladder.h"
+#include "uvov_hal.h"
+#include "app_timer.h"
+
+/*******************************************************************************
+* Function Name: vbus_ladder_start
+********************************************************************************
+* Summary:
+*  Starts a VBUS estimate by a successive approximation of the UV comparator
+*  ladder code, run one probe per vbus_ladder_step() call.
+*
+* Parameters:
+*  ladder - estimate state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_ladder_start(vbus_ladder_t *ladder)
+{
+    uvov_hal_uv_search_start(&ladder->search);
+    ladder->suspended_us = 0u;
+    ladder->active = true;
+}
+
+/*******************************************************************************
+* Function Name: vbus_ladder_step
+********************************************************************************
+* Summary:
+*  Runs the next probe of an estimate. The UV threshold in force is restored
+*  before the function returns; the time the UV protection was suspended is
+*  measured with the SysTick counter. Called once per scheduler tick, with
+*  interrupts enabled.
+*
+* Parameters:
+*  ladder - estimate state
+*  context - the USBPD context
+*  pctrl - true for P_CTRL and false for C_CTRL gate driver
+*  result - estimate and longest suspension of a probe, set when true is
+*           returned
+*
+* Return:
+*  bool - true when the estimate is done
+*
+*******************************************************************************/
+bool vbus_ladder_step(vbus_ladder_t *ladder, cy_stc_usbpd_context_t *context, bool pctrl,
+        vbus_ladder_result_t *result)
+{
+    uint32_t stamp;
+    uint32_t suspended_us;
+    bool done;
+
+    stamp = app_timer_stamp();
+    done = uvov_hal_uv_search_step(context, &ladder->search, pctrl, &result->mv);
+    suspended_us = app_timer_cycles_to_us(app_timer_elapsed(stamp));
+
+    if (suspended_us > ladder->suspended_us)
+    {
+        ladder->suspended_us = (uint16_t)((suspended_us < VBUS_LADDER_SUSPENDED_MAX) ?
+                suspended_us : VBUS_LADDER_SUSPENDED_MAX);
+    }
+    if (done)
+    {
+        ladder->active = false;
+        result->suspended_us = ladder->suspended_us;
+    }
+    return done;
+}
+
+/*******************************************************************************
+* Function Name: vbus_ladder_stop
+********************************************************************************
+* Summary:
+*  Drops an estimate. The UV threshold in force is restored after every probe,
+*  so the comparator needs no clean-up.
+*
+* Parameters:
+*  ladder - estimate state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vbus_ladder_stop(vbus_ladder_t *ladder)
+{
+    ladder->active = false;
+}
+
+/*******************************************************************************
+* Function Name: vbus_ladder_active
+********************************************************************************
+* Summary:
+*  Returns whether an estimate is in progress.
+*
+* Parameters:
+*  ladder - estimate state
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool vbus_ladder_active(const vbus_ladder_t *ladder)
+{
+    return ladder->active;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name: vbus_ladder.h
+*
+* Description: This is the header file for the VBUS estimate through the UV comparator
+*              ladder of the PMG1 MCU Using UVOV Blocks Code Example.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef _VBUS_LADDER_H_
+#define _VBUS_LADDER_H_
+
+#include "cybsp.h"
+#include "cy_pdl.h"
+#include "uvov_hal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1u to estimate VBUS periodically with the UV comparator, PMG1-S2 only */
+#ifndef VBUS_LADDER_ENABLE
+#define VBUS_LADDER_ENABLE          (0u)
+#endif
+
+/* Estimation period in ms */
+#define VBUS_LADDER_PERIOD_MS       (1000u)
+
+/* Suspension time recorded when it does not fit into 16 bits */
+#define VBUS_LADDER_SUSPENDED_MAX   (0xFFFFu)
+
+/* Estimate of a port, one probe per call of vbus_ladder_step() */
+typedef struct
+{
+    uvov_hal_uv_search_t search;    /* UV comparator search state */
+    bool active;                    /* An estimate is in progress */
+    uint16_t suspended_us;          /* Longest UV protection suspension of the probes so far */
+} vbus_ladder_t;
+
+/* Result of one estimate */
+typedef struct
+{
+    uint16_t mv;                    /* Lower bound of VBUS in mV, 0 below the ladder */
+    uint16_t suspended_us;          /* Longest time in us the UV protection was suspended by a probe */
+} vbus_ladder_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void vbus_ladder_start(vbus_ladder_t *ladder);
+
+bool vbus_ladder_step(vbus_ladder_t *ladder, cy_stc_usbpd_context_t *context, bool pctrl,
+        vbus_ladder_result_t *result);
+
+void vbus_ladder_stop(vbus_ladder_t *ladder);
+
+bool vbus_ladder_active(const vbus_ladder_t *ladder);
+
+#endif /* _VBUS_LADDER_H_ */
+
+/* End of file [] */